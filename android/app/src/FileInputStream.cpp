@@ -148,3 +148,101 @@ void Application::FileInputStream::Close()
 	std::memcpy(&m_buffer[0], &implData, sizeof(implData));
 }
 
+namespace DEngine::Application::impl
+{
+	struct Backend_MappedFileData
+	{
+		AAsset* file = nullptr;
+		void const* data = nullptr;
+		u64 size = 0;
+	};
+}
+
+Application::MappedFile::MappedFile()
+{
+	static_assert(sizeof(impl::Backend_MappedFileData) <= sizeof(MappedFile::m_buffer));
+
+	impl::Backend_MappedFileData implData{};
+	std::memcpy(&m_buffer[0], &implData, sizeof(implData));
+}
+
+Application::MappedFile::MappedFile(char const* path) : MappedFile()
+{
+	Open(path);
+}
+
+Application::MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+	std::memcpy(&m_buffer[0], &other.m_buffer[0], sizeof(impl::Backend_MappedFileData));
+	impl::Backend_MappedFileData implData{};
+	std::memcpy(&other.m_buffer[0], &implData, sizeof(implData));
+}
+
+Application::MappedFile::~MappedFile()
+{
+	Close();
+}
+
+Application::MappedFile& DEngine::Application::MappedFile::operator=(MappedFile&& other) noexcept
+{
+	if (this == &other)
+		return *this;
+	Close();
+
+	std::memcpy(&m_buffer[0], &other.m_buffer[0], sizeof(impl::Backend_MappedFileData));
+	impl::Backend_MappedFileData implData{};
+	std::memcpy(&other.m_buffer[0], &implData, sizeof(implData));
+
+	return *this;
+}
+
+bool Application::MappedFile::Open(char const* path)
+{
+	Close();
+
+	auto const& backendData = *impl::pBackendDataInit;
+	// Uncompressed assets are mapped directly from the APK,
+	// compressed ones get decompressed into a buffer once.
+	AAsset* file = AAssetManager_open(backendData.assetManager, path, AASSET_MODE_BUFFER);
+	if (file == nullptr)
+		return false;
+
+	impl::Backend_MappedFileData implData{};
+	implData.size = (u64)AAsset_getLength64(file);
+	if (implData.size != 0) {
+		implData.data = AAsset_getBuffer(file);
+		if (implData.data == nullptr) {
+			AAsset_close(file);
+			return false;
+		}
+	}
+	implData.file = file;
+	std::memcpy(&m_buffer[0], &implData, sizeof(implData));
+	return true;
+}
+
+void Application::MappedFile::Close()
+{
+	impl::Backend_MappedFileData implData{};
+	std::memcpy(&implData, &m_buffer[0], sizeof(implData));
+	if (implData.file != nullptr)
+		AAsset_close(implData.file);
+
+	implData = impl::Backend_MappedFileData{};
+	std::memcpy(&m_buffer[0], &implData, sizeof(implData));
+}
+
+bool Application::MappedFile::IsOpen() const
+{
+	impl::Backend_MappedFileData implData{};
+	std::memcpy(&implData, &m_buffer[0], sizeof(implData));
+	return implData.file != nullptr;
+}
+
+Std::Span<std::byte const> Application::MappedFile::Data() const
+{
+	impl::Backend_MappedFileData implData{};
+	std::memcpy(&implData, &m_buffer[0], sizeof(implData));
+	return { static_cast<std::byte const*>(implData.data), (uSize)implData.size };
+}
+
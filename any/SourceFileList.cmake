@@ -39,8 +39,13 @@ set(DENGINE_GFX_SOURCE_FILES
 	src/DEngine/Gfx/Vk/GuiResourceManager.cpp
 	src/DEngine/Gfx/Vk/NativeWindowManager.cpp
 	src/DEngine/Gfx/Vk/ObjectDataManager.cpp
+	src/DEngine/Gfx/Vk/PipelineCache.cpp
 	src/DEngine/Gfx/Vk/QueueData.cpp
+	src/DEngine/Gfx/Vk/SecondaryCmdRecorder.cpp
+	src/DEngine/Gfx/Vk/ShaderBundle.cpp
+	src/DEngine/Gfx/Vk/ShelfPacker.cpp
 	src/DEngine/Gfx/Vk/StagingBufferAlloc.cpp
+	src/DEngine/Gfx/Vk/TextureArchive.cpp
 	src/DEngine/Gfx/Vk/TextureManager.cpp
 	src/DEngine/Gfx/Vk/ViewportManager.cpp
 	src/DEngine/Gfx/Vk/Vk.cpp
@@ -102,7 +107,9 @@ set(DENGINE_ANY_SOURCE_FILES
 
 	src/main.cpp
 
+	src/DEngine/Jobs.cpp
 	src/DEngine/Scene.cpp
+	src/DEngine/SystemSchedule.cpp
 	src/DEngine/Time.cpp
 	src/DEngine/Physics2D.cpp
 
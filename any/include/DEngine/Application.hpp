@@ -4,6 +4,7 @@
 #include <DEngine/Std/Containers/Array.hpp>
 #include <DEngine/Std/Containers/RangeFnRef.hpp>
 #include <DEngine/Std/Containers/Opt.hpp>
+#include <DEngine/Std/Containers/Span.hpp>
 #include <DEngine/Std/Containers/StackVec.hpp>
 #include <DEngine/Std/Containers/Str.hpp>
 
@@ -11,6 +12,8 @@
 
 #include <DEngine/Std/Defines.hpp>
 
+#include <cstddef>
+
 namespace DEngine::Application
 {
 	enum class WindowID : u64 {
@@ -129,6 +132,7 @@ namespace DEngine::Application
 	class EventForwarder;
 	enum class SoftInputFilter : u8;
 	class FileInputStream;
+	class MappedFile;
 
 	struct AccessibilityUpdateElement {
 		int posX;
@@ -350,6 +354,31 @@ private:
 	alignas(8) char m_buffer[16] = {};
 };
 
+// Maps an entire read-only file into memory. The contents can be used
+// directly without copying them through FileInputStream::Read.
+// The span stays valid until the file is closed.
+class DEngine::Application::MappedFile
+{
+public:
+	MappedFile();
+	explicit MappedFile(char const* path);
+	MappedFile(MappedFile const&) = delete;
+	MappedFile(MappedFile&&) noexcept;
+	~MappedFile();
+
+	MappedFile& operator=(MappedFile const&) = delete;
+	MappedFile& operator=(MappedFile&&) noexcept;
+
+	bool Open(char const* path);
+	void Close();
+	[[nodiscard]] bool IsOpen() const;
+	// Returns an empty span if the file is not open.
+	[[nodiscard]] Std::Span<std::byte const> Data() const;
+
+private:
+	alignas(8) char m_buffer[24] = {};
+};
+
 // Modifications to the App::Context should generally not happen during the event-callbacks
 class DEngine::Application::EventForwarder
 {
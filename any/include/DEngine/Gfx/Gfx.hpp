@@ -10,6 +10,7 @@
 
 #include <vector>
 #include <cstddef>
+#include <string>
 
 namespace DEngine::Gfx
 {
@@ -18,6 +19,8 @@ namespace DEngine::Gfx
 #else
 	constexpr bool enableDedicatedThread = false;
 #endif
+	// The most frames the producer can queue up ahead of the rendering thread.
+	constexpr u8 maxFrameQueueDepth = 3;
 
 	class WsiInterface;
 	class LogInterface;
@@ -25,11 +28,15 @@ namespace DEngine::Gfx
 	struct InitInfo;
 	class ViewportRef;
 	struct DrawParams;
+	struct FrameQueueStats;
 	enum class TextureID : u64 { Invalid = u64(-1) };
 	enum class ViewportID : u64 { Invalid = u64(-1) };
 	enum class NativeWindowID : u64 { Invalid = u64(-1) };
 	enum class NativeWindowEvent : u32;
 	enum class FontFaceId : u64 { Invalid = u64(-1) };
+	// Bitmap faces hold glyphs rasterized for a single size.
+	// All signed distance field faces share one set of glyphs, which is scaled to the size of the text.
+	enum class FontFaceType : u8 { Bitmap, Sdf };
 
 	struct FontBitmapUploadJob {
 		FontFaceId fontFaceId;
@@ -38,6 +45,10 @@ namespace DEngine::Gfx
 		u32 height;
 		u32 pitch;
 		Std::Span<std::byte const> data;
+		// Only used by signed distance field glyphs. The amount of texels around
+		// the glyph outline on each side, the glyph quad is grown to cover them.
+		f32 sdfPaddingX;
+		f32 sdfPaddingY;
 	};
 
 	class Context
@@ -52,7 +63,7 @@ namespace DEngine::Gfx
 		void DeleteNativeWindow(NativeWindowID);
 
 		// Thread safe
-		void NewFontFace(FontFaceId fontFaceId);
+		void NewFontFace(FontFaceId fontFaceId, FontFaceType type = FontFaceType::Bitmap);
 
 		// Thread safe
 		// Guaranteed to copy the byte-data.
@@ -63,8 +74,20 @@ namespace DEngine::Gfx
 		// Thread safe
 		void DeleteViewport(ViewportID viewportID);
 
+		// Returns the next free frame packet to write this frame's draw data into.
+		// The packet is cleared, but its vectors keep their memory from earlier frames.
+		// Blocks if the renderer still owns every packet.
+		// Calling it again before SubmitDraw returns the same packet.
+		[[nodiscard]] DrawParams& BeginDraw();
+		// Hands the packet returned by BeginDraw over to the renderer.
+		void SubmitDraw();
+
+		// Copies the params into a frame packet and submits it.
 		void Draw(DrawParams const& params);
 
+		// Thread safe
+		[[nodiscard]] FrameQueueStats GetFrameQueueStats() const;
+
 	private:
 		Context() = default;
 		Context(Context const&) = delete;
@@ -84,7 +107,14 @@ namespace DEngine::Gfx
 	public:
 		virtual ~TextureAssetInterface() {};
 
+		// Called from the rendering thread the first time a texture is drawn,
+		// for textures that are not in the texture archive. Only the path is
+		// looked up here, the file is read on the texture loader threads.
 		virtual char const* get(TextureID id) const = 0;
+
+		// Called from the rendering thread once the texture has been uploaded.
+		// Until then, a placeholder texture is drawn in its place.
+		virtual void TextureResident(TextureID id) const {}
 	};
 
 	struct ViewportUpdate {
@@ -194,6 +224,26 @@ namespace DEngine::Gfx
 		std::vector<GlyphRect> guiTextGlyphRects;
 		std::vector<GuiDrawCmd> guiDrawCmds;
 		std::vector<NativeWindowUpdate> nativeWindowUpdates;
+
+		// Empties every vector without releasing its memory.
+		void Clear() noexcept;
+	};
+
+	// Counters for the frame queue between the producer and the rendering thread.
+	// All times are in milliseconds and averaged over every frame so far.
+	struct FrameQueueStats {
+		u32 queueDepth = 0;
+		u64 submittedFrameCount = 0;
+		u64 renderedFrameCount = 0;
+		// Time a frame waited in the queue before the rendering thread started on it.
+		f64 avgQueueLatency = 0;
+		f64 maxQueueLatency = 0;
+		// Time SubmitDraw spent blocked, waiting for room in the queue.
+		f64 avgSubmitBlockTime = 0;
+		// Time the rendering thread spent on one frame.
+		f64 avgRenderTime = 0;
+		// Rendered frames per second, from the first frame started to the last one finished.
+		f64 renderedFramesPerSecond = 0;
 	};
 
 	struct InitInfo {
@@ -208,6 +258,21 @@ namespace DEngine::Gfx
 		std::vector<Math::Vec3> gizmoArrowMesh;
 		std::vector<Math::Vec3> gizmoCircleLineMesh;
 		std::vector<Math::Vec3> gizmoArrowScaleMesh2d;
+
+		// File that the pipeline cache is loaded from on startup and saved to on shutdown.
+		// Leave empty to not persist the pipeline cache.
+		std::string pipelineCachePath;
+
+		// Packed texture archive produced by refresh_assets. Textures found in it
+		// are not requested from the TextureAssetInterface.
+		// Leave empty to load every texture from its own file.
+		std::string textureArchivePath;
+
+		// How many submitted frames can wait for the rendering thread before SubmitDraw blocks.
+		// 1 keeps input latency lowest, higher values let the producer absorb spikes
+		// in either thread at the cost of up to that many frames of extra latency.
+		// Clamped to [1, maxFrameQueueDepth]. Has no effect without the dedicated rendering thread.
+		u8 frameQueueDepth = 1;
 	};
 
 	class LogInterface {
@@ -23,7 +23,7 @@
 
 namespace DEngine::Gui
 {
-	namespace impl { struct ImplData; }
+	namespace impl { struct ImplData; struct DrawCacheEntry; }
 
 	class RectCollection;
 
@@ -117,6 +117,24 @@ namespace DEngine::Gui
 			WindowID windowId,
 			Std::Box<Layer>&& layer);
 
+		// Marks the cached layout as outdated so that it gets rebuilt
+		// before the next pointer event is dispatched.
+		// Widgets should call this when an event changes something that affects
+		// their size hint or the rects of their children. App code should call this
+		// when it modifies the widget hierarchy outside of an event.
+		void InvalidateLayout() const;
+
+		// Throws out all the draw data retained by ScopedDrawCache, so that
+		// the next render starts from scratch. This is done whenever the layout
+		// is invalidated, but pointer move events don't invalidate anything by themselves.
+		// App code should call this when it changes how widgets are rendered
+		// outside of an event.
+		void InvalidateRendering() const;
+		// Only throws out the retained draw data of this widget's subtree,
+		// and of the containers it is nested within. Widgets call this when
+		// a move event changes how they look, i.e hover highlights.
+		void InvalidateRendering(Widget const& widget) const;
+
 		f32 fontScale = 1.f;
 		static constexpr float absoluteMinimumSize = 0.2f;
 		f32 minimumHeightCm = 0.7f;
@@ -146,6 +164,39 @@ namespace DEngine::Gui
 
 		Impl* pImplData = nullptr;
 	};
+
+	/*
+		Lets a container reuse the draw data emitted by its subtree in the previous render.
+
+		If the subtree is rendered into the same rects and under the same scissor as last time,
+		and nothing in it has been invalidated since, the constructor appends the retained
+		draw data and Replayed() returns true. The container should then return without
+		rendering anything. Otherwise everything emitted while this object is alive is
+		retained for the next render.
+
+		The container must call SetSubtreeBegin on its rect collection entry
+		when gathering size hints, or invalidated children will not be noticed.
+	*/
+	class ScopedDrawCache
+	{
+	public:
+		ScopedDrawCache(
+			Widget::Render_Params const& params,
+			Widget const& widget,
+			Rect const& widgetRect,
+			Rect const& visibleRect);
+		ScopedDrawCache(ScopedDrawCache const&) = delete;
+		ScopedDrawCache& operator=(ScopedDrawCache const&) = delete;
+		~ScopedDrawCache();
+
+		[[nodiscard]] bool Replayed() const noexcept { return replayed; }
+
+	private:
+		DrawInfo* drawInfo = nullptr;
+		// Only set while recording.
+		impl::DrawCacheEntry* entry = nullptr;
+		bool replayed = false;
+	};
 }
 
 template<class Callable>
@@ -3,6 +3,7 @@
 #include <DEngine/Gui/Utility.hpp>
 #include <DEngine/Gui/TextManager.hpp>
 #include <DEngine/Std/Containers/FnRef.hpp>
+#include <DEngine/Std/Containers/Opt.hpp>
 
 #include <DEngine/Math/Vector.hpp>
 
@@ -28,6 +29,12 @@ namespace DEngine::Gui
 		std::vector<Rect> scissors;
 	public:
 		[[nodiscard]] Extent GetFramebufferExtent() const { return framebufferExtent; }
+		[[nodiscard]] Std::Opt<Rect> GetCurrentScissor() const {
+			if (scissors.empty())
+				return Std::nullOpt;
+			else
+				return scissors.back();
+		}
 
 		DrawInfo(
 			Extent framebufferExtent,
@@ -15,6 +15,7 @@
 #include <DEngine/Math/Common.hpp>
 
 #include <vector>
+#include <cstdint>
 #include <cstring>
 
 namespace DEngine::Gui
@@ -62,6 +63,14 @@ namespace DEngine::Gui
 				return Collection().SetSizeHint(it, sizeHint);
 			}
 
+			// For widgets that add their own entry after gathering the size hints
+			// of their children. Grab this before visiting the children, and pass it
+			// to SetSubtreeBegin once the widget's own entry has been added.
+			[[nodiscard]] It SubtreeBegin() const noexcept { return It{ Collection().widgets.size() }; }
+			void SetSubtreeBegin(It const& it, It const& begin) {
+				return Collection().SetSubtreeBegin(it, begin);
+			}
+
 			template<class T>
 			T* AttachCustomData(It const& it) requires Std::Trait::isDefaultConstructible<T> {
 				return Collection().AttachCustomData<T>(it);
@@ -175,6 +184,18 @@ namespace DEngine::Gui
 		[[nodiscard]] SizeHint const* GetSizeHint(Widget const& widget) const { return GetSizeHint(&widget); }
 		[[nodiscard]] SizeHint const* GetSizeHint(Layer const& layer) const { return GetSizeHint(&layer); }
 
+		// The entries of a subtree are contiguous, and end with the entry of the
+		// subtree's root. Unless set, a subtree only holds the entry itself.
+		void SetSubtreeBegin(It const& it, It const& begin) {
+			DENGINE_IMPL_GUI_ASSERT(it.index < subtreeBegins.size());
+			DENGINE_IMPL_GUI_ASSERT(begin.index <= it.index);
+			subtreeBegins[it.index] = begin.index;
+		}
+		[[nodiscard]] bool SubtreeContains(It const& root, It const& it) const {
+			DENGINE_IMPL_GUI_ASSERT(root.index < subtreeBegins.size());
+			return it.index >= subtreeBegins[root.index] && it.index <= root.index;
+		}
+
 		void SetRect(It const& it, RectPair const& rect) {
 			DENGINE_IMPL_GUI_ASSERT(it.index < rects.size());
 			rects[it.index] = rect;
@@ -225,6 +246,26 @@ namespace DEngine::Gui
 
 		[[nodiscard]] bool BuiltForRendering() const { return containsRendering; }
 
+		// Returns true if both collections hold the same widgets
+		// with the same size hints and rects. Custom data is not compared.
+		[[nodiscard]] bool HasSameLayout(RectCollection const& other) const noexcept {
+			auto const count = widgets.size();
+			if (count != other.widgets.size())
+				return false;
+			for (uSize i = 0; i < count; i += 1) {
+				if (widgets[i].voidPtr != other.widgets[i].voidPtr)
+					return false;
+				auto const& a = sizeHints[i];
+				auto const& b = other.sizeHints[i];
+				if (a.minimum != b.minimum || a.expandX != b.expandX || a.expandY != b.expandY)
+					return false;
+				if (rects[i].widgetRect != other.rects[i].widgetRect ||
+					rects[i].visibleRect != other.rects[i].visibleRect)
+					return false;
+			}
+			return true;
+		}
+
 		// Makes it easier when debugging
 		union PointerUnion {
 			Widget const* widget;
@@ -237,6 +278,8 @@ namespace DEngine::Gui
 		std::vector<SizeHint> sizeHints;
 		// Corresponds with the widgets vector.
 		std::vector<RectPair> rects;
+		// Corresponds with the widgets vector.
+		std::vector<uSize> subtreeBegins;
 
 		struct CustomData2
 		{
@@ -251,6 +294,8 @@ namespace DEngine::Gui
 			widgets.clear();
 			sizeHints.clear();
 			rects.clear();
+			subtreeBegins.clear();
+			ReleaseIndexTable();
 
 			for (auto& item : customData2) {
 				if (item.ptr) {
@@ -269,6 +314,8 @@ namespace DEngine::Gui
 			widgets.clear();
 			sizeHints.clear();
 			rects.clear();
+			subtreeBegins.clear();
+			ReleaseIndexTable();
 
 			for (auto& item : customData2) {
 				item.destructorFn(item.ptr);
@@ -286,33 +333,68 @@ namespace DEngine::Gui
 
 		bool containsRendering = false;
 
-		[[nodiscard]] Std::Opt<uSize> FindIndex(void const* ptr) const noexcept {
-			constexpr auto invalidIndex = static_cast<uSize>(-1);
-			auto index = invalidIndex;
+		// Open-addressing hash table that maps a pointer to its index in the widgets vector.
+		// Each slot holds index + 1, zero marks an empty slot. Lives in the frame allocator.
+		u32* indexTable = nullptr;
+		// Always zero or a power of two.
+		uSize indexTableCapacity = 0;
+		static constexpr uSize minIndexTableCapacity = 64;
+
+		[[nodiscard]] static uSize HashPtr(void const* ptr) noexcept {
+			auto value = (u64)reinterpret_cast<uintptr_t>(ptr);
+			value ^= value >> 33;
+			value *= 0xff51afd7ed558ccdULL;
+			value ^= value >> 33;
+			return (uSize)value;
+		}
+
+		void InsertIntoIndexTable(void const* ptr, uSize index) noexcept {
+			auto const mask = indexTableCapacity - 1;
+			auto slot = HashPtr(ptr) & mask;
+			while (indexTable[slot] != 0)
+				slot = (slot + 1) & mask;
+			indexTable[slot] = (u32)(index + 1);
+		}
+
+		void ReleaseIndexTable() noexcept {
+			if (indexTable)
+				alloc.Free(indexTable, sizeof(u32) * indexTableCapacity);
+			indexTable = nullptr;
+			indexTableCapacity = 0;
+		}
+
+		void GrowIndexTable() {
+			auto const newCapacity = Math::Max(minIndexTableCapacity, indexTableCapacity * 2);
+			auto* newTable = static_cast<u32*>(alloc.Alloc(sizeof(u32) * newCapacity, alignof(u32)));
+			DENGINE_IMPL_GUI_ASSERT(newTable);
+			std::memset(newTable, 0, sizeof(u32) * newCapacity);
+
+			ReleaseIndexTable();
+			indexTable = newTable;
+			indexTableCapacity = newCapacity;
 			auto const widgetCount = widgets.size();
 			for (uSize i = 0; i < widgetCount; i += 1)
+				InsertIntoIndexTable(widgets[i].voidPtr, i);
+		}
+
+		[[nodiscard]] Std::Opt<uSize> FindIndex(void const* ptr) const noexcept {
+			if (indexTableCapacity == 0)
+				return Std::nullOpt;
+			auto const mask = indexTableCapacity - 1;
+			auto slot = HashPtr(ptr) & mask;
+			while (indexTable[slot] != 0)
 			{
-				if (widgets[i].voidPtr == ptr)
-				{
-					index = i;
-					break;
-				}
+				auto const index = (uSize)indexTable[slot] - 1;
+				if (widgets[index].voidPtr == ptr)
+					return index;
+				slot = (slot + 1) & mask;
 			}
-			if (index == invalidIndex)
-				return Std::nullOpt;
-			else
-				return index;
+			return Std::nullOpt;
 		}
 
 		[[nodiscard]] bool PtrExists(void const* ptr) const noexcept
 		{
-			auto const widgetCount = widgets.size();
-			for (uSize i = 0; i < widgetCount; i += 1)
-			{
-				if (widgets[i].voidPtr == ptr)
-					return true;
-			}
-			return false;
+			return FindIndex(ptr).HasValue();
 		}
 
 		[[nodiscard]] It AddEntry(void const* ptr)
@@ -320,12 +402,19 @@ namespace DEngine::Gui
 			// Check that the widget has not already been inserted
 			DENGINE_IMPL_GUI_ASSERT(!PtrExists(ptr));
 
+			// Keep the load factor at or below one half.
+			if ((widgets.size() + 1) * 2 > indexTableCapacity)
+				GrowIndexTable();
+
 			widgets.emplace_back(PointerUnion{ .voidPtr = ptr });
 			sizeHints.push_back({});
 			rects.push_back({});
 			customData2.push_back({});
 
-			return It{ widgets.size() - 1 };
+			auto const newIndex = widgets.size() - 1;
+			subtreeBegins.push_back(newIndex);
+			InsertIntoIndexTable(ptr, newIndex);
+			return It{ newIndex };
 		}
 
 		[[nodiscard]] Std::Opt<It> GetEntry(void const* ptr) const
@@ -33,6 +33,14 @@ namespace DEngine::Gui
 		COUNT
 	};
 
+	enum class GlyphRenderMode {
+		// Glyphs are rasterized separately for every font size. Sharpest at small sizes.
+		Bitmap,
+		// Every glyph is rendered once as a signed distance field, which is scaled to every font size.
+		// Changing the DPI or content scale then doesn't rasterize and upload the glyphs again.
+		Sdf,
+	};
+
 	// Here there be no null-terminated strings allowed
 	class TextManager {
 	public:
@@ -214,6 +222,31 @@ namespace DEngine::Gui
 
 
 		void FlushQueuedJobs(Gfx::Context& gfxCtx);
+
+		// GetOuterExtent remembers the most recent measurements in an LRU cache.
+		// In steady state, almost every measurement should be a hit.
+		struct MeasureCacheStats {
+			u64 hitCount = 0;
+			u64 missCount = 0;
+			uSize entryCount = 0;
+		};
+		[[nodiscard]] MeasureCacheStats GetMeasureCacheStats() const;
+
+		// Adds a font to the end of the fallback chain. Characters are drawn with the
+		// first font in the chain that has them, starting with the primary font.
+		// Only affects glyphs that have not been loaded yet, so add fonts before drawing text.
+		// Returns false if the file can't be opened or is not a font.
+		bool AddFallbackFont(Std::Span<char const> path);
+
+		// Every new font size rasterizes these characters on a background thread
+		// instead of one at a time on the main thread when they are first drawn.
+		// Defaults to printable ASCII and Latin-1. Only affects sizes created after this call.
+		// In signed distance field mode they are rendered once, when the mode is set.
+		void SetPrewarmCharacters(Std::Span<u32 const> utfValues);
+
+		// Must be set before any font size is requested.
+		void SetGlyphRenderMode(GlyphRenderMode mode);
+		[[nodiscard]] GlyphRenderMode GetGlyphRenderMode() const;
 	};
 
 	namespace impl
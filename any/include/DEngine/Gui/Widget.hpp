@@ -104,6 +104,9 @@ namespace DEngine::Gui {
 			you can end event dispatching early. That is to say
 			this event should ordinarily always be passed to every widget
 			in the hierarchy regardless if a widget occluded it.
+
+			Move events do not invalidate rendering. A widget that changes
+			how it looks must call Context::InvalidateRendering(*this).
 		*/
 		virtual bool CursorMove(
 			CursorMoveParams const& params,
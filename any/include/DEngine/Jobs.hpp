@@ -0,0 +1,86 @@
+#pragma once
+
+#include <DEngine/FixedWidthTypes.hpp>
+
+#include <atomic>
+
+namespace DEngine::Jobs
+{
+	// A job runs on the index range [begin, end).
+	using JobFn = void(*)(void* userData, uSize begin, uSize end);
+
+	// Tracks how many submitted jobs have not finished yet.
+	class Counter
+	{
+	public:
+		[[nodiscard]] bool IsDone() const noexcept { return pending.load(std::memory_order_acquire) == 0; }
+
+	private:
+		std::atomic<uSize> pending = 0;
+		friend class Scheduler;
+		friend class SchedulerImpl;
+	};
+
+	class SchedulerImpl;
+
+	// Pool of worker threads with one job deque per worker.
+	// Workers pop from the back of their own deque and steal from
+	// the front of the other deques when they run dry.
+	class Scheduler
+	{
+	public:
+		Scheduler(Scheduler const&) = delete;
+		Scheduler(Scheduler&&) noexcept;
+		Scheduler& operator=(Scheduler const&) = delete;
+		Scheduler& operator=(Scheduler&&) noexcept;
+		~Scheduler();
+
+		// A workerCount of 0 creates one worker per hardware thread, minus the calling thread.
+		[[nodiscard]] static Scheduler Create(uSize workerCount = 0);
+
+		// Amount of threads that can execute jobs, including the thread that waits.
+		[[nodiscard]] uSize GetThreadCount() const noexcept;
+
+		// Thread safe.
+		void Submit(JobFn fn, void* userData, uSize begin, uSize end, Counter& counter);
+
+		// Blocks until every job tracked by the counter is done.
+		// The calling thread executes queued jobs while waiting.
+		void Wait(Counter& counter);
+
+		// Splits [0, count) into chunks of at most chunkSize elements and runs
+		// them across the workers. Blocks until every chunk is done.
+		//
+		// Callable signature: void(uSize begin, uSize end)
+		template<class Callable>
+		void ParallelFor(uSize count, uSize chunkSize, Callable const& callable)
+		{
+			if (count == 0)
+				return;
+			if (chunkSize == 0)
+				chunkSize = 1;
+			// Not worth going wide.
+			if (count <= chunkSize || GetThreadCount() <= 1)
+			{
+				callable((uSize)0, count);
+				return;
+			}
+
+			JobFn const wrapperFn = [](void* userData, uSize begin, uSize end) {
+				(*static_cast<Callable const*>(userData))(begin, end);
+			};
+			Counter counter;
+			for (uSize begin = 0; begin < count; begin += chunkSize)
+			{
+				uSize const end = begin + chunkSize < count ? begin + chunkSize : count;
+				Submit(wrapperFn, const_cast<Callable*>(&callable), begin, end, counter);
+			}
+			Wait(counter);
+		}
+
+	private:
+		Scheduler() = default;
+
+		SchedulerImpl* implData = nullptr;
+	};
+}
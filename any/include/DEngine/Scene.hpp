@@ -8,6 +8,8 @@
 #include <DEngine/Std/Containers/StackVec.hpp>
 #include <DEngine/Std/Utility.hpp>
 
+#include <vector>
+
 // Temp
 #include <DEngine/Application.hpp>
 #include <DEngine/Math/Vector.hpp>
@@ -18,6 +20,10 @@
 
 namespace DEngine
 {
+	// Handle to an entity in a Scene.
+	// The lower 32 bits is the slot index, the upper 32 bits is the generation
+	// of that slot. Slots are recycled when entities are deleted, the generation
+	// makes sure handles to the deleted entity are no longer valid.
 	enum class Entity : u64 { Invalid = u64(-1) };
 
 	class Scene;
@@ -39,6 +45,224 @@ namespace DEngine
 		Math::Vec2 scale = { 1.f, 1.f };
 	};
 
+	namespace impl
+	{
+		[[nodiscard]] constexpr u32 GetEntityIndex(Entity entity) noexcept { return (u32)((u64)entity & 0xFFFFFFFF); }
+		[[nodiscard]] constexpr u32 GetEntityGeneration(Entity entity) noexcept { return (u32)((u64)entity >> 32); }
+		[[nodiscard]] constexpr Entity MakeEntity(u32 index, u32 generation) noexcept { return (Entity)(((u64)generation << 32) | (u64)index); }
+
+		// Marks an unused entry in a sparse array.
+		constexpr u32 invalidSlot = u32(-1);
+
+		// Sparse-set storage for a single component type.
+		//
+		// The dense array is kept packed so it can be iterated directly,
+		// the sparse array maps an entity index to its slot in the dense array.
+		// Lookup, insertion and deletion are all O(1). Deleting a component
+		// moves the last element into the freed slot, so the order of the
+		// dense array is not stable.
+		template<typename T>
+		class ComponentSet
+		{
+		public:
+			using ElementT = Std::Pair<Entity, T>;
+
+			[[nodiscard]] Std::Span<ElementT> GetSpan() noexcept { return { dense.data(), dense.size() }; }
+			[[nodiscard]] Std::Span<ElementT const> GetSpan() const noexcept { return { dense.data(), dense.size() }; }
+			[[nodiscard]] uSize Size() const noexcept { return dense.size(); }
+
+			[[nodiscard]] T* Get(Entity entity) noexcept
+			{
+				auto const slot = GetSlot(entity);
+				return slot != invalidSlot ? &dense[slot].b : nullptr;
+			}
+			[[nodiscard]] T const* Get(Entity entity) const noexcept
+			{
+				auto const slot = GetSlot(entity);
+				return slot != invalidSlot ? &dense[slot].b : nullptr;
+			}
+
+			void Add(Entity entity, T const& component)
+			{
+				auto const index = GetEntityIndex(entity);
+				if (index >= sparse.size())
+					sparse.resize(index + 1, invalidSlot);
+				DENGINE_IMPL_ASSERT(sparse[index] == invalidSlot);
+				sparse[index] = (u32)dense.size();
+				dense.push_back({ entity, component });
+			}
+
+			// Returns true if the entity had this component.
+			bool Remove(Entity entity) noexcept
+			{
+				auto const slot = GetSlot(entity);
+				if (slot == invalidSlot)
+					return false;
+				auto const lastSlot = (u32)dense.size() - 1;
+				if (slot != lastSlot)
+				{
+					dense[slot] = Std::Move(dense[lastSlot]);
+					sparse[GetEntityIndex(dense[slot].a)] = slot;
+				}
+				dense.pop_back();
+				sparse[GetEntityIndex(entity)] = invalidSlot;
+				return true;
+			}
+
+			// Swaps two elements in the dense array.
+			void SwapSlots(u32 a, u32 b) noexcept
+			{
+				DENGINE_IMPL_ASSERT(a < dense.size() && b < dense.size());
+				if (a == b)
+					return;
+				Std::Swap(dense[a], dense[b]);
+				sparse[GetEntityIndex(dense[a].a)] = a;
+				sparse[GetEntityIndex(dense[b].a)] = b;
+			}
+
+			// Returns invalidSlot if the entity does not have this component.
+			[[nodiscard]] u32 GetSlot(Entity entity) const noexcept
+			{
+				auto const index = GetEntityIndex(entity);
+				if (index >= sparse.size())
+					return invalidSlot;
+				auto const slot = sparse[index];
+				if (slot == invalidSlot || dense[slot].a != entity)
+					return invalidSlot;
+				return slot;
+			}
+
+		private:
+			std::vector<ElementT> dense;
+			std::vector<u32> sparse;
+		};
+
+		template<class T>
+		using ComponentSetFor = Std::Trait::Cond<
+			Std::Trait::isConst<T>,
+			ComponentSet<Std::Trait::RemoveConst<T>> const,
+			ComponentSet<T>>;
+
+		template<class T>
+		struct SceneViewSet { ComponentSetFor<T>* set = nullptr; };
+
+		// Unique index for every component type stored in a Scene.
+		// Must be kept in sync with the component sets in Scene.
+		template<class T>
+		constexpr unsigned int componentTypeIndex = Std::Trait::indexOf<
+			Std::Trait::RemoveConst<T>,
+			Transform,
+			Gfx::TextureID,
+			Move,
+			Physics::Rigidbody2D>;
+	}
+
+	// Iterates every entity that has all the components in Ts.
+	//
+	// The smallest component set drives the iteration and the other
+	// components are looked up through their sparse arrays. If the view
+	// matches a group kept by the Scene, all sets are in the same entity order
+	// and the view is a linear zip instead.
+	//
+	// Components can be modified while iterating, but components
+	// must not be added to or removed from the scene.
+	template<class... Ts>
+	class SceneView : private impl::SceneViewSet<Ts>...
+	{
+	public:
+		SceneView(impl::ComponentSetFor<Ts>&... sets, uSize zipSize, bool isZipped) noexcept :
+			impl::SceneViewSet<Ts>{ &sets }...,
+			zipSize{ zipSize },
+			isZipped{ isZipped }
+		{
+			if (!isZipped)
+			{
+				uSize smallest = (uSize)-1;
+				((GetSet<Ts>().Size() < smallest ?
+					(smallest = GetSet<Ts>().Size(), driverIndex = Std::Trait::indexOf<Ts, Ts...>) :
+					0), ...);
+			}
+		}
+
+		// Amount of elements in the driving set. This is an upper bound
+		// on the amount of entities visited, and the valid range for ForEachInRange.
+		[[nodiscard]] uSize DriverSize() const noexcept
+		{
+			if (isZipped)
+				return zipSize;
+			uSize returnVal = 0;
+			((driverIndex == Std::Trait::indexOf<Ts, Ts...> ? (returnVal = GetSet<Ts>().Size(), 0) : 0), ...);
+			return returnVal;
+		}
+
+		// Callable signature: void(Entity, Ts&...)
+		template<class Callable>
+		void ForEach(Callable&& callable) const
+		{
+			ForEachInRange(0, DriverSize(), callable);
+		}
+
+		// Only visits the elements [begin, end) of the driving set.
+		// Disjoint ranges can be iterated concurrently.
+		template<class Callable>
+		void ForEachInRange(uSize begin, uSize end, Callable&& callable) const
+		{
+			DENGINE_IMPL_ASSERT(begin <= end && end <= DriverSize());
+			if (isZipped)
+			{
+				for (uSize i = begin; i < end; i += 1)
+				{
+					auto const entity = GetFirstSet().GetSpan()[i].a;
+					callable(entity, GetSet<Ts>().GetSpan()[i].b...);
+				}
+			}
+			else
+			{
+				((driverIndex == Std::Trait::indexOf<Ts, Ts...> ? (Impl_ForEach<Ts>(begin, end, callable), 0) : 0), ...);
+			}
+		}
+
+	private:
+		uSize zipSize = 0;
+		bool isZipped = false;
+		unsigned int driverIndex = 0;
+
+		template<class T>
+		[[nodiscard]] impl::ComponentSetFor<T>& GetSet() const noexcept
+		{
+			return *static_cast<impl::SceneViewSet<T> const&>(*this).set;
+		}
+		[[nodiscard]] auto& GetFirstSet() const noexcept
+		{
+			return GetSet<Std::Trait::At<0, Ts...>>();
+		}
+
+		template<class T, class DriverT>
+		[[nodiscard]] T* Impl_Fetch(Entity entity, uSize driverSlot) const noexcept
+		{
+			if constexpr (Std::Trait::isSame<T, DriverT>)
+				return &GetSet<T>().GetSpan()[driverSlot].b;
+			else
+				return GetSet<T>().Get(entity);
+		}
+
+		template<class DriverT, class Callable>
+		void Impl_ForEach(uSize begin, uSize end, Callable& callable) const
+		{
+			auto const driverSpan = GetSet<DriverT>().GetSpan();
+			for (uSize i = begin; i < end; i += 1)
+			{
+				auto const entity = driverSpan[i].a;
+				auto const invoke = [&](auto*... ptrs)
+				{
+					if ((ptrs && ...))
+						callable(entity, *ptrs...);
+				};
+				invoke(Impl_Fetch<Ts, DriverT>(entity, i)...);
+			}
+		}
+	};
+
 	class Scene
 	{
 	public:
@@ -49,13 +273,10 @@ namespace DEngine
 		void Copy(Scene& output) const;
 
 	private:
-
-		std::vector<Entity>& Impl_GetEntities() { return entities; }
-
 		template<typename T>
-		std::vector<Std::Pair<Entity, T>>& Impl_GetAllComponents() = delete;
+		impl::ComponentSet<T>& Impl_GetComponentSet() = delete;
 		template<typename T>
-		std::vector<Std::Pair<Entity, T>> const& Impl_GetAllComponents() const = delete;
+		impl::ComponentSet<T> const& Impl_GetComponentSet() const = delete;
 
 	public:
 		// We need this to be a pointer to heap because the struct is so huge.
@@ -64,10 +285,12 @@ namespace DEngine
 
 		Std::Span<Entity const> GetEntities() const { return { entities.data(), entities.size() }; }
 
+		// The returned span is packed, but the order of the
+		// components is not stable across insertions and deletions.
 		template<typename T>
-		Std::Span<Std::Pair<Entity, T>> GetAllComponents() = delete;
+		Std::Span<Std::Pair<Entity, T>> GetAllComponents() { return Impl_GetComponentSet<T>().GetSpan(); }
 		template<typename T>
-		Std::Span<Std::Pair<Entity, T> const> GetAllComponents() const = delete;
+		Std::Span<Std::Pair<Entity, T> const> GetAllComponents() const { return Impl_GetComponentSet<T>().GetSpan(); }
 
 		void Begin();
 
@@ -82,106 +305,112 @@ namespace DEngine
 		void AddComponent(Entity entity, T const& component)
 		{
 			DENGINE_IMPL_ASSERT(ValidateEntity(entity));
-
-			auto& componentVector = Impl_GetAllComponents<T>();
 			// Crash if we already got this component
 			DENGINE_IMPL_ASSERT(GetComponent<T>(entity) == nullptr);
 
-			componentVector.push_back({ entity, component });
+			Impl_GetComponentSet<T>().Add(entity, component);
+			if constexpr (Impl_IsSpriteGroupComponent<T>())
+				Impl_SpriteGroup_Added(entity);
 		}
 		template<typename T>
 		void DeleteComponent(Entity entity)
 		{
 			DENGINE_IMPL_ASSERT(ValidateEntity(entity));
-			auto& componentVector = Impl_GetAllComponents<T>();
-			auto const componentIt = Std::FindIf(
-				componentVector.begin(),
-				componentVector.end(),
-				[entity](auto const& val) -> bool { return entity == val.a; });
-			DENGINE_IMPL_ASSERT(componentIt != componentVector.end());
-			componentVector.erase(componentIt);
+			if constexpr (Impl_IsSpriteGroupComponent<T>())
+				Impl_SpriteGroup_Removing(entity);
+			[[maybe_unused]] bool const removed = Impl_GetComponentSet<T>().Remove(entity);
+			DENGINE_IMPL_ASSERT(removed);
 		}
 		template<typename T>
 		void DeleteComponent_CanFail(Entity entity)
 		{
-			auto& componentVector = Impl_GetAllComponents<T>();
-			auto const componentIt = Std::FindIf(
-				componentVector.begin(),
-				componentVector.end(),
-				[entity](auto const& val) -> bool { return entity == val.a; });
-			if (componentIt != componentVector.end())
-				componentVector.erase(componentIt);
+			if constexpr (Impl_IsSpriteGroupComponent<T>())
+				Impl_SpriteGroup_Removing(entity);
+			Impl_GetComponentSet<T>().Remove(entity);
 		}
 		template<typename T>
 		[[nodiscard]] T* GetComponent(Entity entity)
 		{
 			DENGINE_IMPL_ASSERT(ValidateEntity(entity));
-			auto& componentVector = Impl_GetAllComponents<T>();
-			auto const componentIt = Std::FindIf(
-				componentVector.begin(),
-				componentVector.end(),
-				[entity](auto const& val) -> bool { return entity == val.a; });
-			if (componentIt != componentVector.end())
-				return &componentIt->b;
-			else
-				return nullptr;
+			return Impl_GetComponentSet<T>().Get(entity);
 		}
 		template<typename T>
 		[[nodiscard]] T const* GetComponent(Entity entity) const
 		{
 			DENGINE_IMPL_ASSERT(ValidateEntity(entity));
-			auto& componentVector = Impl_GetAllComponents<T>();
-			auto const componentIt = Std::FindIf(
-				componentVector.begin(),
-				componentVector.end(),
-				[entity](auto const& val) -> bool { return entity == val.a; });
-			if (componentIt != componentVector.end())
-				return &componentIt->b;
-			else
-				return nullptr;
+			return Impl_GetComponentSet<T>().Get(entity);
+		}
+
+		// Returns a view over every entity that has all of the components Ts.
+		// Components can be const-qualified to get read-only access.
+		template<class... Ts>
+		[[nodiscard]] SceneView<Ts...> View()
+		{
+			return SceneView<Ts...>{
+				Impl_GetComponentSet<Std::Trait::RemoveConst<Ts>>()...,
+				spriteGroupSize,
+				Impl_IsSpriteGroup<Std::Trait::RemoveConst<Ts>...>() };
+		}
+		template<class... Ts>
+		[[nodiscard]] SceneView<Ts const...> View() const
+		{
+			return SceneView<Ts const...>{
+				Impl_GetComponentSet<Std::Trait::RemoveConst<Ts>>()...,
+				spriteGroupSize,
+				Impl_IsSpriteGroup<Std::Trait::RemoveConst<Ts>...>() };
 		}
 
 	private:
-		u64 entityIdIncrementor = 0;
-		std::vector<Std::Pair<Entity, Transform>> transforms;
-		std::vector<Std::Pair<Entity, Gfx::TextureID>> textureIDs;
-		std::vector<Std::Pair<Entity, Move>> moves;
-		std::vector<Std::Pair<Entity, Physics::Rigidbody2D>> rigidBodies;
+		// Transform and TextureID are almost always queried together.
+		// The first spriteGroupSize elements of both sets belong to the
+		// same entities in the same order, so a view over exactly these two is a linear zip.
+		uSize spriteGroupSize = 0;
+		template<class T>
+		[[nodiscard]] static constexpr bool Impl_IsSpriteGroupComponent() noexcept
+		{
+			return Std::Trait::isSame<T, Transform> || Std::Trait::isSame<T, Gfx::TextureID>;
+		}
+		template<class... Ts>
+		[[nodiscard]] static constexpr bool Impl_IsSpriteGroup() noexcept
+		{
+			return sizeof...(Ts) == 2 &&
+				Std::Trait::existsInPack<Transform, Ts...> &&
+				Std::Trait::existsInPack<Gfx::TextureID, Ts...>;
+		}
+		void Impl_SpriteGroup_Added(Entity entity) noexcept;
+		void Impl_SpriteGroup_Removing(Entity entity) noexcept;
+
+		impl::ComponentSet<Transform> transforms;
+		impl::ComponentSet<Gfx::TextureID> textureIDs;
+		impl::ComponentSet<Move> moves;
+		impl::ComponentSet<Physics::Rigidbody2D> rigidBodies;
 		std::vector<Entity> entities;
+		struct EntitySlot
+		{
+			u32 generation = 0;
+			// Position in 'entities', invalidSlot if this slot is free.
+			u32 listIndex = impl::invalidSlot;
+		};
+		// Indexed by entity index.
+		std::vector<EntitySlot> entitySlots;
+		// Slot indices available for reuse.
+		std::vector<u32> freeEntityIndices;
 	};
 
 	template<>
-	inline Std::Span<Std::Pair<Entity, Transform>> Scene::GetAllComponents<Transform>() { return { transforms.data(), transforms.size() }; }
-	template<>
-	inline Std::Span<Std::Pair<Entity, Transform> const> Scene::GetAllComponents<Transform>() const { return { transforms.data(), transforms.size() }; }
-	template<>
-	inline Std::Span<Std::Pair<Entity, Gfx::TextureID>> Scene::GetAllComponents<Gfx::TextureID>() { return { textureIDs.data(), textureIDs.size() }; }
-	template<>
-	inline Std::Span<Std::Pair<Entity, Gfx::TextureID> const> Scene::GetAllComponents<Gfx::TextureID>() const { return { textureIDs.data(), textureIDs.size() }; }
-	template<>
-	inline Std::Span<Std::Pair<Entity, Move>> Scene::GetAllComponents<Move>() { return { moves.data(), moves.size() }; }
-	template<>
-	inline Std::Span<Std::Pair<Entity, Move> const> Scene::GetAllComponents<Move>() const { return { moves.data(), moves.size() }; }
-	template<>
-	inline Std::Span<Std::Pair<Entity, Physics::Rigidbody2D>> Scene::GetAllComponents<Physics::Rigidbody2D>() { return { rigidBodies.data(), rigidBodies.size() }; }
-	template<>
-	inline Std::Span<Std::Pair<Entity, Physics::Rigidbody2D> const> Scene::GetAllComponents<Physics::Rigidbody2D>() const { return { rigidBodies.data(), rigidBodies.size() }; }
-
-	template<>
-	inline std::vector<Std::Pair<Entity, Transform>>& Scene::Impl_GetAllComponents<Transform>() { return transforms; }
+	inline impl::ComponentSet<Transform>& Scene::Impl_GetComponentSet<Transform>() { return transforms; }
 	template<>
-	inline std::vector<Std::Pair<Entity, Transform>> const& Scene::Impl_GetAllComponents<Transform>() const { return transforms; }
+	inline impl::ComponentSet<Transform> const& Scene::Impl_GetComponentSet<Transform>() const { return transforms; }
 	template<>
-	inline std::vector<Std::Pair<Entity, Gfx::TextureID>>& Scene::Impl_GetAllComponents<Gfx::TextureID>() { return textureIDs; }
+	inline impl::ComponentSet<Gfx::TextureID>& Scene::Impl_GetComponentSet<Gfx::TextureID>() { return textureIDs; }
 	template<>
-	inline std::vector<Std::Pair<Entity, Gfx::TextureID>> const& Scene::Impl_GetAllComponents<Gfx::TextureID>() const { return textureIDs; }
+	inline impl::ComponentSet<Gfx::TextureID> const& Scene::Impl_GetComponentSet<Gfx::TextureID>() const { return textureIDs; }
 	template<>
-	inline std::vector<Std::Pair<Entity, Move>>& Scene::Impl_GetAllComponents<Move>() { return moves; }
+	inline impl::ComponentSet<Move>& Scene::Impl_GetComponentSet<Move>() { return moves; }
 	template<>
-	inline std::vector<Std::Pair<Entity, Move>> const& Scene::Impl_GetAllComponents<Move>() const { return moves; }
+	inline impl::ComponentSet<Move> const& Scene::Impl_GetComponentSet<Move>() const { return moves; }
 	template<>
-	inline std::vector<Std::Pair<Entity, Physics::Rigidbody2D>>& Scene::Impl_GetAllComponents<Physics::Rigidbody2D>() { return rigidBodies; }
+	inline impl::ComponentSet<Physics::Rigidbody2D>& Scene::Impl_GetComponentSet<Physics::Rigidbody2D>() { return rigidBodies; }
 	template<>
-	inline std::vector<Std::Pair<Entity, Physics::Rigidbody2D>> const& Scene::Impl_GetAllComponents<Physics::Rigidbody2D>() const { return rigidBodies; }
+	inline impl::ComponentSet<Physics::Rigidbody2D> const& Scene::Impl_GetComponentSet<Physics::Rigidbody2D>() const { return rigidBodies; }
 }
-
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <DEngine/FixedWidthTypes.hpp>
+#include <DEngine/Jobs.hpp>
+#include <DEngine/Scene.hpp>
+#include <DEngine/Std/Containers/Span.hpp>
+
+#include <functional>
+#include <vector>
+
+namespace DEngine
+{
+	// Declares that a system touches state outside of the component sets,
+	// such as the physics world. It will not run concurrently with any other system.
+	struct ExclusiveAccess {};
+
+	// A list of systems that run once per tick.
+	//
+	// Every system declares the components it accesses. Const-qualified
+	// components are read, the rest are written. Two systems conflict if
+	// either one writes a component the other accesses, and conflicting systems
+	// run in the order they were added. Systems that don't conflict run concurrently.
+	class SystemSchedule
+	{
+	public:
+		using SystemFnT = void(Scene&, Jobs::Scheduler&);
+
+		template<class... Components, class Callable>
+		void AddSystem(Std::Span<char const> name, Callable&& callable)
+		{
+			System newSystem = {};
+			newSystem.name = name;
+			(Impl_AddAccess<Components>(newSystem), ...);
+			newSystem.fn = static_cast<Callable&&>(callable);
+			Impl_AddSystem(Std::Move(newSystem));
+		}
+
+		[[nodiscard]] uSize GetSystemCount() const noexcept { return systems.size(); }
+
+		// Runs every system once. Blocks until all of them are done.
+		void Run(Scene& scene, Jobs::Scheduler& scheduler);
+
+	private:
+		struct System
+		{
+			Std::Span<char const> name;
+			u64 readMask = 0;
+			u64 writeMask = 0;
+			bool exclusive = false;
+			std::function<SystemFnT> fn;
+			// Indices of later systems that have to wait for this one.
+			std::vector<u32> dependents;
+			u32 dependencyCount = 0;
+		};
+		std::vector<System> systems;
+
+		template<class T>
+		static void Impl_AddAccess(System& system) noexcept
+		{
+			if constexpr (Std::Trait::isSame<T, ExclusiveAccess>)
+				system.exclusive = true;
+			else if constexpr (Std::Trait::isConst<T>)
+				system.readMask |= (u64)1 << impl::componentTypeIndex<T>;
+			else
+				system.writeMask |= (u64)1 << impl::componentTypeIndex<T>;
+		}
+
+		void Impl_AddSystem(System&& newSystem);
+
+		struct RunState;
+		static void Impl_RunSystem(void* userData, uSize begin, uSize end);
+	};
+
+	// Runs the callable for every entity in the view, split into
+	// chunks of at most chunkSize entities that run across the job workers.
+	// The callable must only touch the components it is handed.
+	template<class... Ts, class Callable>
+	void ParallelForEach(
+		Jobs::Scheduler& scheduler,
+		SceneView<Ts...> const& view,
+		uSize chunkSize,
+		Callable const& callable)
+	{
+		scheduler.ParallelFor(
+			view.DriverSize(),
+			chunkSize,
+			[&view, &callable](uSize begin, uSize end) { view.ForEachInRange(begin, end, callable); });
+	}
+}
@@ -112,7 +112,7 @@ namespace DEngine::Editor {
 				[&editorImpl](Gui::LineList& widget, Gui::Context* ctx) {
 					if (widget.selectedLine.HasValue()) {
 						auto const& lineText = widget.lines[widget.selectedLine.Value()];
-						editorImpl.SelectEntity_MidDispatch((Entity)std::atoi(lineText.c_str()), *ctx);
+						editorImpl.SelectEntity_MidDispatch((Entity)std::stoull(lineText), *ctx);
 					} else {
 						editorImpl.UnselectEntity();
 					}
@@ -153,7 +153,7 @@ namespace DEngine::Editor {
 			// Find new entity and select it.
 			Std::Opt<uSize> newLine;
 			for (uSize i = 0; i < entitiesList->lines.size(); i += 1) {
-				auto const id = std::stol(entitiesList->lines[i]);
+				auto const id = std::stoull(entitiesList->lines[i]);
 				if ((Entity)id == newId)
 				{
 					newLine = i;
@@ -446,9 +446,11 @@ namespace DEngine::Editor
 			auto& appData = customDataIn.Get<Editor::Context>()->GetImplData();
 			fmt::format_to(
 				textPusher.BackInserter(),
-				"{:.3f}ms / {} FPS",
+				"{:.3f}ms / {} FPS / queue {} ({:.2f}ms)",
 				appData.deltaTime * 1000,
-				(int)Math::Round(1.f / appData.deltaTime));
+				(int)Math::Round(1.f / appData.deltaTime),
+				appData.frameQueueStats.queueDepth,
+				appData.frameQueueStats.avgQueueLatency);
 		};
 
 		auto playButton = new Gui::Button;
@@ -504,6 +506,9 @@ Editor::Context Editor::Context::Create(
 			implData.gfxCtx));
 	//ctx->fontScale = 3.f;u
 	implData.guiCtx = Std::Box{ ctx };
+	// Has to happen before any text is laid out.
+	if (createInfo.sdfText)
+		ctx->GetTextManager().SetGlyphRenderMode(Gui::GlyphRenderMode::Sdf);
 
 	auto outmostLayout = new Gui::StackLayout(Gui::StackLayout::Dir::Vertical);
 
@@ -549,19 +554,38 @@ void Editor::Context::ProcessEvents(float deltaTime) {
 
 
 
-	if (implData.appCtx->TickCount() == 1)
+	if (implData.appCtx->TickCount() == 1) {
+		implData.guiCtx->InvalidateRendering();
 		implData.InvalidateRendering();
+	}
+
+	// The selected entity might have been deleted from the active scene,
+	// or we might have swapped scenes. Entity handles are generational so this is cheap.
+	if (implData.GetSelectedEntity().HasValue() &&
+		!implData.GetActiveScene().ValidateEntity(implData.GetSelectedEntity().Value()))
+	{
+		implData.UnselectEntity();
+		// Unselecting clears the component list, which changes the widget hierarchy.
+		implData.guiCtx->InvalidateLayout();
+		implData.InvalidateRendering();
+	}
 
 	for (auto viewportPtr : implData.viewportWidgetPtrs) {
 		viewportPtr->Tick(Time::Delta());
 	}
+	// These only touch a small part of the GUI, so we only
+	// invalidate the GUI draw data that includes those widgets.
 	if (implData.appCtx->TickCount() % 60 == 0) {
 		implData.deltaTime = deltaTime;
+		implData.frameQueueStats = implData.gfxCtx->GetFrameQueueStats();
+		if (implData.test_fpsText)
+			implData.guiCtx->InvalidateRendering(*implData.test_fpsText);
 		implData.InvalidateRendering();
 	}
 	if (implData.appCtx->TickCount() % 10 == 0) {
 		if (implData.componentList && implData.GetSelectedEntity().HasValue()) {
 			implData.componentList->Tick(implData.GetActiveScene(), implData.GetSelectedEntity().Value());
+			implData.guiCtx->InvalidateRendering(*implData.componentList);
 			implData.InvalidateRendering();
 		}
 	}
@@ -679,33 +703,31 @@ Editor::Context::~Context()
 	}
 }
 
-Editor::DrawInfo Editor::Context::GetDrawInfo() const
+void Editor::Context::WriteDrawParams(Gfx::DrawParams& params) const
 {
 	auto& implData = this->GetImplData();
 
-	DrawInfo returnVal;
-	
-	returnVal.vertices = implData.vertices;
-	returnVal.indices = implData.indices;
-	returnVal.drawCmds = implData.drawCmds;
-	returnVal.textGlyphRects = implData.textGlyphRects;
-	returnVal.utfValues = implData.utfValues;
+	// The GUI is only re-rendered when it's invalidated, so we keep our own
+	// copy around. The packet already has the memory for it in steady state.
+	params.guiVertices.assign(implData.vertices.begin(), implData.vertices.end());
+	params.guiIndices.assign(implData.indices.begin(), implData.indices.end());
+	params.guiDrawCmds.assign(implData.drawCmds.begin(), implData.drawCmds.end());
+	params.guiTextGlyphRects.assign(implData.textGlyphRects.begin(), implData.textGlyphRects.end());
+	params.guiUtfValues.assign(implData.utfValues.begin(), implData.utfValues.end());
 
-	returnVal.windowUpdates = implData.windowUpdates;
+	params.nativeWindowUpdates.assign(implData.windowUpdates.begin(), implData.windowUpdates.end());
 
 	for (auto viewportWidgetPtr : implData.viewportWidgetPtrs) {
 		DENGINE_IMPL_ASSERT(viewportWidgetPtr);
 		auto const& viewport = viewportWidgetPtr->GetInternalViewport();
 		if (viewport.wasRendered && !viewport.currentExtent.IsNothing()) {
 			Gfx::ViewportUpdate update = viewport.BuildViewportUpdate(
-				returnVal.lineVertices,
-				returnVal.lineDrawCmds);
+				params.lineVertices,
+				params.lineDrawCmds);
 			
-			returnVal.viewportUpdates.push_back(update);
+			params.viewportUpdates.push_back(update);
 		}
 	}
-
-	return returnVal;
 }
 
 bool Editor::Context::IsSimulating() const
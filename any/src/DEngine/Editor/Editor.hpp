@@ -91,19 +91,6 @@ namespace DEngine::Editor
 		constexpr auto defaultTextMargin = 10;
 	}
 
-	struct DrawInfo
-	{
-		std::vector<u32> indices;
-		std::vector<Gfx::GuiVertex> vertices;
-		std::vector<Gfx::GuiDrawCmd> drawCmds;
-		std::vector<Gfx::NativeWindowUpdate> windowUpdates;
-		std::vector<Gfx::ViewportUpdate> viewportUpdates;
-		std::vector<Math::Vec3> lineVertices;
-		std::vector<Gfx::LineDrawCmd> lineDrawCmds;
-		std::vector<u32> utfValues;
-		std::vector<Gfx::GlyphRect> textGlyphRects;
-	};
-
 	class EditorImpl;
 
 	class Context : public Platform::EventForwarder
@@ -122,7 +109,8 @@ namespace DEngine::Editor
 
 		Gui::TextManager& GetTextManager();
 
-		[[nodiscard]] DrawInfo GetDrawInfo() const;
+		// Appends the editor's GUI, viewport and window data to the frame packet.
+		void WriteDrawParams(Gfx::DrawParams& params) const;
 
 		[[nodiscard]] bool IsSimulating() const;
 		[[nodiscard]] Scene& GetActiveScene();
@@ -147,6 +135,8 @@ namespace DEngine::Editor
 			f32 windowContentScale;
 			f32 windowDpiX;
 			f32 windowDpiY;
+			// Draws all text from signed distance field glyphs.
+			bool sdfText = false;
 		};
 		[[nodiscard]] static Context Create(
 			CreateInfo const& createInfo);
@@ -36,6 +36,7 @@ namespace DEngine::Editor
         Editor::Context* parent = nullptr;
 		App::Context* appCtx = nullptr;
 		float deltaTime = 0.f;
+		Gfx::FrameQueueStats frameQueueStats = {};
 		Std::Box<Gui::Context> guiCtx;
 		Std::FrameAlloc guiTransientAlloc = Std::FrameAlloc::PreAllocate(1024 * 1024).Value();
 		Gui::RectCollection guiRectCollection;
@@ -258,11 +258,14 @@ bool Joystick::CursorMove(
 	Gui::Rect const& visibleRect,
 	bool occluded)
 {
-	return impl::Joystick_PointerMove(
+	auto const stickMoved = impl::Joystick_PointerMove(
 		*this,
 		widgetRect,
 		impl::cursorPointerId,
 		{ (f32)params.event.position.x, (f32)params.event.position.y });
+	if (stickMoved)
+		params.ctx.InvalidateRendering(*this);
+	return stickMoved;
 }
 
 bool Joystick::TouchMove2(
@@ -271,11 +274,14 @@ bool Joystick::TouchMove2(
 	Gui::Rect const& visibleRect,
 	bool occluded)
 {
-	return impl::Joystick_PointerMove(
+	auto const stickMoved = impl::Joystick_PointerMove(
 		*this,
 		widgetRect,
 		params.event.id,
 		params.event.position);
+	if (stickMoved)
+		params.ctx.InvalidateRendering(*this);
+	return stickMoved;
 }
 
 bool Joystick::TouchPress2(
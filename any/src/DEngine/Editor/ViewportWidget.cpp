@@ -1040,32 +1040,31 @@ namespace DEngine::Editor::impl {
 				Math::Vec3 rayOrigin = widget.cam.position;
 				Math::Vec3 rayDir = widget.BuildRayDirection(widgetRect, pointer.pos);
 				// Iterate over all physics components that also have a transform component
-				for (auto const& [entity, rb] : scene.GetAllComponents<Physics::Rigidbody2D>())
+				scene.View<Physics::Rigidbody2D const, Transform const>().ForEach([&](
+					Entity entity,
+					Physics::Rigidbody2D const& rb,
+					Transform const& transform)
 				{
-					Transform const* transform = appData.GetActiveScene().GetComponent<Transform>(entity);
-					if (transform)
+					Math::Vec2 vertices[4] = {
+						{-0.5f, 0.5f },
+						{ 0.5f, 0.5f },
+						{ 0.5f, -0.5f },
+						{ -0.5f, -0.5f } };
+					Std::Opt<f32> distanceOpt = Intersect_Ray_PhysicsCollider2D(
+						widget,
+						{ vertices, 4 },
+						transform.position.AsVec2(),
+						transform.rotation,
+						transform.scale,
+						rayOrigin,
+						rayDir);
+					if (distanceOpt.HasValue())
 					{
-						Math::Vec2 vertices[4] = {
-							{-0.5f, 0.5f },
-							{ 0.5f, 0.5f },
-							{ 0.5f, -0.5f },
-							{ -0.5f, -0.5f } };
-						Std::Opt<f32> distanceOpt = Intersect_Ray_PhysicsCollider2D(
-							widget,
-							{ vertices, 4 },
-							transform->position.AsVec2(),
-							transform->rotation,
-							transform->scale,
-							rayOrigin,
-							rayDir);
-						if (distanceOpt.HasValue())
-						{
-							auto const newDist = distanceOpt.Value();
-							if (!hitEntity.HasValue() || newDist <= hitEntity.Value().a)
-								hitEntity = { newDist, entity };
-						}
+						auto const newDist = distanceOpt.Value();
+						if (!hitEntity.HasValue() || newDist <= hitEntity.Value().a)
+							hitEntity = { newDist, entity };
 					}
-				}
+				});
 				if (hitEntity.HasValue()) {
 					appData.SelectEntity(hitEntity.Value().b);
 					return pointerInside;
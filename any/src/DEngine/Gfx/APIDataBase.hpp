@@ -16,7 +16,12 @@ namespace DEngine::Gfx
 		APIDataBase& operator=(APIDataBase const&) = delete;
 		APIDataBase& operator=(APIDataBase&&) = delete;
 
-		virtual void Draw(DrawParams const& drawParams) = 0;
+		// Only called from the thread that submits frames.
+		virtual DrawParams& AcquireDrawParams() = 0;
+		// Only called from the thread that submits frames.
+		virtual void SubmitDrawParams() = 0;
+		// Needs to be thread-safe
+		virtual FrameQueueStats GetFrameQueueStats() const = 0;
 
 		// Needs to be thread-safe
 		virtual void NewNativeWindow(NativeWindowID windowId) = 0;
@@ -29,7 +34,7 @@ namespace DEngine::Gfx
 		virtual void DeleteViewport(ViewportID id) = 0;
 
 		// Needs to be thread-safe
-		virtual void NewFontFace(FontFaceId fontFaceId) = 0;
+		virtual void NewFontFace(FontFaceId fontFaceId, FontFaceType type) = 0;
 
 		// Needs to be thread-safe
 		virtual void NewFontTextures(Std::Span<FontBitmapUploadJob const> const&) = 0;
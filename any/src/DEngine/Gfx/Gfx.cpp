@@ -47,13 +47,51 @@ Std::Opt<Gfx::Context> Gfx::Initialize(InitInfo const& initInfo)
 	return Std::Opt<Gfx::Context>{ Std::Move(returnVal) };
 }
 
+Gfx::DrawParams& Gfx::Context::BeginDraw()
+{
+	auto& apiData = *static_cast<APIDataBase*>(apiDataBase);
+
+	auto& params = apiData.AcquireDrawParams();
+	params.Clear();
+	return params;
+}
+
+void Gfx::Context::SubmitDraw()
+{
+	auto& apiData = *static_cast<APIDataBase*>(apiDataBase);
+
+	apiData.SubmitDrawParams();
+}
+
 void Gfx::Context::Draw(DrawParams const& params)
 {
 	DENGINE_IMPL_GFX_ASSERT(!params.nativeWindowUpdates.empty());
 
-	auto& apiData = *static_cast<APIDataBase*>(apiDataBase);
+	// Copy-assignment reuses the memory the packet already has.
+	BeginDraw() = params;
+	SubmitDraw();
+}
+
+Gfx::FrameQueueStats Gfx::Context::GetFrameQueueStats() const
+{
+	auto const& apiData = *static_cast<APIDataBase const*>(apiDataBase);
+
+	return apiData.GetFrameQueueStats();
+}
 
-	apiData.Draw(params);
+void Gfx::DrawParams::Clear() noexcept
+{
+	textureIDs.clear();
+	transforms.clear();
+	lineDrawCmds.clear();
+	lineVertices.clear();
+	viewportUpdates.clear();
+	guiVertices.clear();
+	guiIndices.clear();
+	guiUtfValues.clear();
+	guiTextGlyphRects.clear();
+	guiDrawCmds.clear();
+	nativeWindowUpdates.clear();
 }
 
 Gfx::ViewportRef Gfx::Context::NewViewport()
@@ -73,10 +111,10 @@ void Gfx::Context::DeleteViewport(ViewportID viewportID)
 	apiData.DeleteViewport(viewportID);
 }
 
-void Gfx::Context::NewFontFace(FontFaceId fontFaceId)
+void Gfx::Context::NewFontFace(FontFaceId fontFaceId, FontFaceType type)
 {
 	auto& apiData = *static_cast<APIDataBase*>(GetApiData());
-	return apiData.NewFontFace(fontFaceId);
+	return apiData.NewFontFace(fontFaceId, type);
 }
 
 void Gfx::Context::NewFontTextures(Std::Span<FontBitmapUploadJob const> const& jobs)
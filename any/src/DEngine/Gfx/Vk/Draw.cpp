@@ -19,31 +19,82 @@
 using namespace DEngine;
 using namespace DEngine::Gfx;
 
-void Vk::APIData::Draw(
-	DrawParams const& drawParams)
+Gfx::DrawParams& Vk::APIData::AcquireDrawParams()
+{
+	// The rendering thread only picks up a new packet once it's done with the previous one,
+	// and at most frameQueueDepth packets are queued. So when we get here, the thread is at worst
+	// drawing the packet right before the queued ones, and everything older than that is free.
+	// With frameQueueDepth + 2 packets in the ring, the next one is therefore always free to write into.
+	return drawPackets[drawPacketWriteIndex];
+}
+
+void Vk::APIData::SubmitDrawParams()
 {
 	APIData& apiData = *this;
 
+	auto const packetIndex = apiData.drawPacketWriteIndex;
+	DENGINE_IMPL_GFX_ASSERT(!apiData.drawPackets[packetIndex].nativeWindowUpdates.empty());
+	apiData.drawPacketWriteIndex = (packetIndex + 1) % apiData.DrawPacketCount();
+
+	auto const submitTime = ClockT::now();
 	if constexpr (Gfx::enableDedicatedThread)
 	{
 		std::unique_lock lock{ apiData.threadLock };
 
 		auto& threadData = apiData.thread;
+		auto const queueDepth = apiData.frameQueueDepth;
 		thread.drawParamsCondVarProducer.wait(
 			lock,
-			[&threadData]() { return !threadData.nextJobReady; });
+			[&threadData, queueDepth]() { return threadData.queuedPacketCount < queueDepth; });
 
-		threadData.drawParams = drawParams;
-		threadData.nextJobReady = true;
-		threadData.nextJobFn = [](APIData& apiData) {
-			APIData::InternalDraw(apiData, apiData.thread.drawParams);
-		};
+		auto const queuedTime = ClockT::now();
+		auto& counters = threadData.counters;
+		counters.submittedFrameCount += 1;
+		counters.totalSubmitBlockTime += queuedTime - submitTime;
+		counters.packetQueuedTimes[packetIndex] = queuedTime;
+
+		auto const backIndex = (threadData.queuedPacketsFront + threadData.queuedPacketCount) % maxFrameQueueDepth;
+		threadData.queuedPackets[backIndex] = packetIndex;
+		threadData.queuedPacketCount += 1;
 		lock.unlock();
 		thread.drawParamsCondVarWorker.notify_one();
 	}
 	else {
-		APIData::InternalDraw(apiData, drawParams);
+		APIData::InternalDraw(apiData, apiData.drawPackets[packetIndex]);
+
+		auto const renderEnd = ClockT::now();
+		std::lock_guard lock{ apiData.threadLock };
+		auto& counters = apiData.thread.counters;
+		counters.submittedFrameCount += 1;
+		counters.RecordRenderedFrame(submitTime, submitTime, renderEnd);
+	}
+}
+
+Gfx::FrameQueueStats Vk::APIData::GetFrameQueueStats() const
+{
+	using MilliT = std::chrono::duration<f64, std::milli>;
+
+	std::lock_guard lock{ threadLock };
+	auto const& counters = thread.counters;
+
+	FrameQueueStats returnVal = {};
+	returnVal.queueDepth = (u32)frameQueueDepth;
+	returnVal.submittedFrameCount = counters.submittedFrameCount;
+	returnVal.renderedFrameCount = counters.renderedFrameCount;
+	if (counters.submittedFrameCount != 0) {
+		returnVal.avgSubmitBlockTime =
+			MilliT(counters.totalSubmitBlockTime).count() / (f64)counters.submittedFrameCount;
+	}
+	if (counters.renderedFrameCount != 0) {
+		auto const renderedCount = (f64)counters.renderedFrameCount;
+		returnVal.avgQueueLatency = MilliT(counters.totalQueueLatency).count() / renderedCount;
+		returnVal.maxQueueLatency = MilliT(counters.maxQueueLatency).count();
+		returnVal.avgRenderTime = MilliT(counters.totalRenderTime).count() / renderedCount;
+		auto const renderSpan = MilliT(counters.lastRenderEnd - counters.firstRenderStart).count();
+		if (renderSpan > 0)
+			returnVal.renderedFramesPerSecond = renderedCount * 1000.0 / renderSpan;
 	}
+	return returnVal;
 }
 
 namespace DEngine::Gfx::Vk
@@ -69,33 +120,45 @@ namespace DEngine::Gfx::Vk
 		}
 	}
 
-	void RecordGraphicsCmdBuffer(
-		GlobUtils const& globUtils, 
+	// Begins a render pass whose contents are recorded in secondary cmd buffers.
+	void BeginRenderPass_Secondary(
+		DeviceDispatch const& device,
 		vk::CommandBuffer cmdBuffer,
-		ObjectDataManager const& objectDataManager,
-		TextureManager const& textureManager,
-		ViewportMgr_ViewportData const& viewportData,
-		ViewportUpdate const& viewportUpdate,
-		DrawParams const& drawParams,
-		u8 inFlightIndex,
-		APIData& test_apiData)
+		vk::RenderPass renderPass,
+		vk::Framebuffer framebuffer,
+		vk::Extent2D extent,
+		Math::Vec4 const& clearColor)
 	{
 		vk::RenderPassBeginInfo rpBegin = {};
-		rpBegin.framebuffer = viewportData.renderTarget.framebuffer;
-		rpBegin.renderPass = globUtils.gfxRenderPass;
-		rpBegin.renderArea.extent = viewportData.renderTarget.extent;
+		rpBegin.framebuffer = framebuffer;
+		rpBegin.renderPass = renderPass;
+		rpBegin.renderArea.extent = extent;
 		rpBegin.clearValueCount = 1;
 
 		vk::ClearColorValue clearVal = {};
 		clearVal.setFloat32({
-			viewportUpdate.clearColor.x,
-			viewportUpdate.clearColor.y,
-			viewportUpdate.clearColor.z,
-			viewportUpdate.clearColor.w });
+			clearColor.x,
+			clearColor.y,
+			clearColor.z,
+			clearColor.w });
 		vk::ClearValue clear = clearVal;
 		rpBegin.pClearValues = &clear;
-		globUtils.device.cmdBeginRenderPass(cmdBuffer, rpBegin, vk::SubpassContents::eInline);
+		device.cmdBeginRenderPass(cmdBuffer, rpBegin, vk::SubpassContents::eSecondaryCommandBuffers);
+	}
 
+	// Records the contents of the viewport's render pass. This only reads from the managers,
+	// so several viewports can be recorded at once.
+	void RecordGraphicsCmdBuffer(
+		GlobUtils const& globUtils, 
+		vk::CommandBuffer cmdBuffer,
+		ObjectDataManager const& objectDataManager,
+		TextureManager const& textureManager,
+		ViewportMgr_ViewportData const& viewportData,
+		ViewportUpdate const& viewportUpdate,
+		DrawParams const& drawParams,
+		u8 inFlightIndex,
+		APIData const& test_apiData)
+	{
 		vk::Viewport viewport = {};
 		viewport.width = static_cast<f32>(viewportData.renderTarget.extent.width);
 		viewport.height = static_cast<f32>(viewportData.renderTarget.extent.height);
@@ -103,25 +166,34 @@ namespace DEngine::Gfx::Vk
 
 		globUtils.device.cmdBindPipeline(cmdBuffer, vk::PipelineBindPoint::eGraphics, test_apiData.testPipeline);
 
-		for (uSize drawIndex = 0; drawIndex < drawParams.textureIDs.size(); drawIndex += 1)
+		if (!objectDataManager.batches.empty())
 		{
-			Std::Array<vk::DescriptorSet, 3> descrSets = {
+			// The camera and the sprite transforms are shared by every batch.
+			Std::Array<vk::DescriptorSet, 2> sharedDescrSets = {
 				viewportData.camDataDescrSets[inFlightIndex],
-				objectDataManager.descrSet,
-				textureManager.database.at(drawParams.textureIDs[drawIndex]).descrSet };
-
-			uSize objectDataBufferOffset = 0;
-			objectDataBufferOffset += objectDataManager.capacity * objectDataManager.elementSize * inFlightIndex;
-			objectDataBufferOffset += objectDataManager.elementSize * drawIndex;
-
+				objectDataManager.descrSet };
+			auto const objectDataBufferOffset = objectDataManager.resourceSetSize * inFlightIndex;
 			globUtils.device.cmdBindDescriptorSets(
 				cmdBuffer,
 				vk::PipelineBindPoint::eGraphics,
 				test_apiData.testPipelineLayout,
 				0,
-				{ (u32)descrSets.Size(), descrSets.Data() },
+				{ (u32)sharedDescrSets.Size(), sharedDescrSets.Data() },
 				(u32)objectDataBufferOffset);
-			globUtils.device.cmdDraw(cmdBuffer, 4, 1, 0, 0);
+
+			// One instanced draw per texture.
+			for (auto const& batch : objectDataManager.batches)
+			{
+				auto const textureDescrSet = textureManager.GetDescrSet(batch.textureId);
+				globUtils.device.cmdBindDescriptorSets(
+					cmdBuffer,
+					vk::PipelineBindPoint::eGraphics,
+					test_apiData.testPipelineLayout,
+					2,
+					textureDescrSet,
+					nullptr);
+				globUtils.device.cmdDraw(cmdBuffer, 4, batch.instanceCount, 0, batch.firstInstance);
+			}
 		}
 
 		// Draw our lines
@@ -147,8 +219,6 @@ namespace DEngine::Gfx::Vk
 				cmdBuffer,
 				inFlightIndex);
 		}
-		
-		globUtils.device.cmdEndRenderPass(cmdBuffer);
 	}
 }
 
@@ -204,8 +274,8 @@ void Vk::APIData::InternalDraw(APIData& apiData, DrawParams const& drawParams)
 
 
 	auto mainFence = apiData.mainFences[mainFenceIndex];
-	auto& stagingBufferAlloc = apiData.mainStagingBufferAllocs[inFlightIndex];
-	StagingBufferAlloc::Reset(stagingBufferAlloc);
+	auto& stagingBufferAlloc = apiData.mainStagingBufferAlloc;
+	StagingBufferAlloc::BeginFrame(stagingBufferAlloc, inFlightIndex);
 	auto mainCmdPool = apiData.mainCmdPools[inFlightIndex];
 	auto mainCmdBuffer = apiData.mainCmdBuffers[inFlightIndex];
 	BeginRecordingMainCmdBuffer(
@@ -214,6 +284,7 @@ void Vk::APIData::InternalDraw(APIData& apiData, DrawParams const& drawParams)
 		mainCmdBuffer,
 		inFlightIndex,
 		debugUtils);
+	SecondaryCmdRecorder::BeginFrame(apiData.secondaryCmdRecorder, device, inFlightIndex);
 
 	// Events that can happen right away?...
 	{
@@ -247,6 +318,15 @@ void Vk::APIData::InternalDraw(APIData& apiData, DrawParams const& drawParams)
 			.inFlightIndex = inFlightIndex,
 		};
 		GuiResourceManager::UpdateWindowUniforms(guiResourceMan, temp);
+		GuiResourceManager::UpdateGlyphInstances(
+			guiResourceMan,
+			{
+				.globUtils = globUtils,
+				.delQueue = delQueue,
+				.drawCmds = { drawParams.guiDrawCmds.data(), drawParams.guiDrawCmds.size() },
+				.utfValues = { drawParams.guiUtfValues.data(), drawParams.guiUtfValues.size() },
+				.glyphRects = { drawParams.guiTextGlyphRects.data(), drawParams.guiTextGlyphRects.size() },
+				.inFlightIndex = inFlightIndex });
 
 		ViewportManager::ProcessEvents(
 			viewportMan,
@@ -262,6 +342,7 @@ void Vk::APIData::InternalDraw(APIData& apiData, DrawParams const& drawParams)
 		ObjectDataManager::Update(
 			objectDataMan,
 			globUtils,
+			{ drawParams.textureIDs.data(), drawParams.textureIDs.size() },
 			transforms,
 			mainCmdBuffer,
 			delQueue,
@@ -281,29 +362,21 @@ void Vk::APIData::InternalDraw(APIData& apiData, DrawParams const& drawParams)
 	}
 
 
+	// Every viewport and every window gets its own secondary cmd buffer. These are recorded
+	// in parallel once we know which swapchain images we're drawing into, and then executed
+	// from the main cmd buffer in the same order as before.
+	auto const viewportCount = (int)drawParams.viewportUpdates.size();
+	auto viewportDatas = Std::NewVec_Reserve<ViewportMgr_ViewportData const*>(transientAlloc, viewportCount);
 	for (auto const& viewportUpdate : drawParams.viewportUpdates) {
 		auto const viewportDataIt = Std::FindIf(
 			apiData.viewportManager.viewportNodes.begin(),
 			apiData.viewportManager.viewportNodes.end(),
 			[&viewportUpdate](auto const& val) { return viewportUpdate.id == val.id; });
 		DENGINE_IMPL_GFX_ASSERT(viewportDataIt != apiData.viewportManager.viewportNodes.end());
-		auto const& viewportNode = *viewportDataIt;
-
-		RecordGraphicsCmdBuffer(
-			globUtils,
-			mainCmdBuffer,
-			apiData.objectDataManager,
-			apiData.textureManager,
-			viewportNode.viewport,
-			viewportUpdate,
-			drawParams,
-			inFlightIndex,
-			apiData);
+		viewportDatas.PushBack(&viewportDataIt->viewport);
 	}
 
 
-
-
 	// Wait for the main fences
 
 	{
@@ -329,6 +402,9 @@ void Vk::APIData::InternalDraw(APIData& apiData, DrawParams const& drawParams)
 		windowUpdateCount,
 		vk::PipelineStageFlagBits::eColorAttachmentOutput);
 
+	// Index into nativeWindowUpdates for every window we acquired an image for.
+	auto acquiredWindowUpdates = Std::NewVec_Reserve<int>(transientAlloc, windowUpdateCount);
+
 	for (int i = 0; i < windowUpdateCount; i += 1) {
 		auto const& windowUpdate = drawParams.nativeWindowUpdates[i];
 		auto const& nativeWindow = nativeWinMgr.GetWindowData(windowUpdate.id);
@@ -356,29 +432,98 @@ void Vk::APIData::InternalDraw(APIData& apiData, DrawParams const& drawParams)
 		swapchainIndices.PushBack(swapchainIndex);
 		swapchains.PushBack(nativeWindow.swapchain);
 		swapchainImageReadySemaphores.PushBack(nativeWindow.swapchainImgReadySem);
+		acquiredWindowUpdates.PushBack(i);
+	}
 
-		auto guiFramebuffer = nativeWindow.framebuffers[swapchainIndex];
+	// Viewports come first in the job list, then the windows.
+	auto const recordJobCount = viewportCount + (int)acquiredWindowUpdates.Size();
+	auto recordJobs = Std::NewVec_Reserve<SecondaryCmdRecorder::Job>(transientAlloc, recordJobCount);
+	for (auto const* viewportData : viewportDatas) {
+		recordJobs.PushBack({
+			.renderPass = globUtils.gfxRenderPass,
+			.framebuffer = viewportData->renderTarget.framebuffer });
+	}
+	for (int i = 0; i < (int)acquiredWindowUpdates.Size(); i += 1) {
+		auto const& nativeWindow = nativeWinMgr.GetWindowData(drawParams.nativeWindowUpdates[acquiredWindowUpdates[i]].id);
+		recordJobs.PushBack({
+			.renderPass = globUtils.guiRenderPass,
+			.framebuffer = nativeWindow.framebuffers[swapchainIndices[i]] });
+	}
+	auto secondaryCmdBuffers = Std::NewVec_Fill<vk::CommandBuffer>(transientAlloc, recordJobCount, vk::CommandBuffer{});
 
-		Std::Span<GuiDrawCmd const> drawCmds;
-		if (!drawParams.guiDrawCmds.empty()) {
-			DENGINE_IMPL_GFX_ASSERT((u64)windowUpdate.drawCmdOffset + (u64)windowUpdate.drawCmdCount <= drawParams.guiDrawCmds.size());
-			drawCmds = { &drawParams.guiDrawCmds[windowUpdate.drawCmdOffset], windowUpdate.drawCmdCount };
-		}
+	{
+		ZoneScopedNS("Record secondary cmd buffers", 10);
+		auto const recordFn = [&](int jobIndex, vk::CommandBuffer cmdBuffer) {
+			if (jobIndex < viewportCount) {
+				RecordGraphicsCmdBuffer(
+					globUtils,
+					cmdBuffer,
+					apiData.objectDataManager,
+					apiData.textureManager,
+					*viewportDatas[jobIndex],
+					drawParams.viewportUpdates[jobIndex],
+					drawParams,
+					inFlightIndex,
+					apiData);
+				return;
+			}
+
+			auto const& windowUpdate = drawParams.nativeWindowUpdates[acquiredWindowUpdates[jobIndex - viewportCount]];
+			auto const& nativeWindow = nativeWinMgr.GetWindowData(windowUpdate.id);
+
+			Std::Span<GuiDrawCmd const> drawCmds;
+			if (!drawParams.guiDrawCmds.empty()) {
+				DENGINE_IMPL_GFX_ASSERT((u64)windowUpdate.drawCmdOffset + (u64)windowUpdate.drawCmdCount <= drawParams.guiDrawCmds.size());
+				drawCmds = { &drawParams.guiDrawCmds[windowUpdate.drawCmdOffset], windowUpdate.drawCmdCount };
+			}
+
+			RecordGuiCmds_Params recordGuiParams = {
+				.globUtils = globUtils,
+				.guiResManager = guiResourceMan,
+				.viewportManager = apiData.viewportManager,
+				.windowUpdate = windowUpdate, };
+			recordGuiParams.cmdBuffer = cmdBuffer;
+			recordGuiParams.guiDrawCmds = drawCmds;
+			recordGuiParams.inFlightIndex = inFlightIndex;
+			recordGuiParams.utfValues = { drawParams.guiUtfValues.data(), drawParams.guiUtfValues.size() };
+			recordGuiParams.glyphRects = { drawParams.guiTextGlyphRects.data(), drawParams.guiTextGlyphRects.size() };
+			recordGuiParams.rotation = nativeWindow.GfxRotation();
+			recordGuiParams.windowExtent = nativeWindow.extent;
+			RecordGuiCmds(recordGuiParams);
+		};
+		SecondaryCmdRecorder::Record(
+			apiData.secondaryCmdRecorder,
+			device,
+			recordJobs.ToSpan(),
+			recordFn,
+			inFlightIndex,
+			secondaryCmdBuffers.ToSpan());
+	}
 
-		RecordGuiCmds_Params recordGuiParams = {
-			.globUtils = globUtils,
-			.guiResManager = guiResourceMan,
-			.viewportManager = apiData.viewportManager,
-			.windowUpdate = windowUpdate, };
-		recordGuiParams.cmdBuffer = mainCmdBuffer;
-		recordGuiParams.guiDrawCmds = drawCmds;
-		recordGuiParams.framebuffer = guiFramebuffer;
-		recordGuiParams.inFlightIndex = inFlightIndex;
-		recordGuiParams.utfValues = { drawParams.guiUtfValues.data(), drawParams.guiUtfValues.size() };
-		recordGuiParams.glyphRects = { drawParams.guiTextGlyphRects.data(), drawParams.guiTextGlyphRects.size() };
-		recordGuiParams.rotation = nativeWindow.GfxRotation();
-		recordGuiParams.windowExtent = nativeWindow.extent;
-		RecordGuiCmds(recordGuiParams);
+	for (int i = 0; i < viewportCount; i += 1) {
+		auto const& viewportData = *viewportDatas[i];
+		BeginRenderPass_Secondary(
+			device,
+			mainCmdBuffer,
+			globUtils.gfxRenderPass,
+			viewportData.renderTarget.framebuffer,
+			viewportData.renderTarget.extent,
+			drawParams.viewportUpdates[i].clearColor);
+		device.cmdExecuteCommands(mainCmdBuffer, secondaryCmdBuffers[i]);
+		device.cmdEndRenderPass(mainCmdBuffer);
+	}
+	for (int i = 0; i < (int)acquiredWindowUpdates.Size(); i += 1) {
+		auto const& windowUpdate = drawParams.nativeWindowUpdates[acquiredWindowUpdates[i]];
+		auto const& nativeWindow = nativeWinMgr.GetWindowData(windowUpdate.id);
+		BeginRenderPass_Secondary(
+			device,
+			mainCmdBuffer,
+			globUtils.guiRenderPass,
+			nativeWindow.framebuffers[swapchainIndices[i]],
+			nativeWindow.extent,
+			windowUpdate.clearColor);
+		device.cmdExecuteCommands(mainCmdBuffer, secondaryCmdBuffers[viewportCount + i]);
+		device.cmdEndRenderPass(mainCmdBuffer);
 	}
 
 	device.endCommandBuffer(mainCmdBuffer);
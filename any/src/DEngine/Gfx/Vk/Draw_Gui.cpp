@@ -21,19 +21,6 @@ void Gfx::Vk::RecordGuiCmds(
 
 
 	{
-		vk::RenderPassBeginInfo rpBegin{};
-		rpBegin.framebuffer = params.framebuffer;
-		rpBegin.renderPass = params.globUtils.guiRenderPass;
-		rpBegin.renderArea.extent = windowExtent;
-		rpBegin.clearValueCount = 1;
-		vk::ClearColorValue clearVal{};
-		for (uSize i = 0; i < 4; i++)
-			clearVal.float32[i] = params.windowUpdate.clearColor[i];
-		vk::ClearValue test = clearVal;
-		rpBegin.pClearValues = &test;
-
-		device.cmdBeginRenderPass(cmdBuffer, rpBegin, vk::SubpassContents::eInline);
-
 		{
 			vk::Viewport viewport{};
 			viewport.width = (float)windowExtent.width;
@@ -84,7 +71,8 @@ void Gfx::Vk::RecordGuiCmds(
 						perWindowDescrSet,
 						drawCmd.text,
 						params.utfValues,
-						params.glyphRects);
+						params.glyphRects,
+						inFlightIndex);
 					break;
 				}
 
@@ -188,7 +176,5 @@ void Gfx::Vk::RecordGuiCmds(
 				 */
 			}
 		}
-
-		device.cmdEndRenderPass(cmdBuffer);
 	}
 }
\ No newline at end of file
@@ -15,7 +15,6 @@ namespace DEngine::Gfx::Vk
 		ViewportManager const& viewportManager;
 		NativeWindowUpdate const& windowUpdate;
 		vk::CommandBuffer cmdBuffer;
-		vk::Framebuffer framebuffer;
 		Std::Span<GuiDrawCmd const> guiDrawCmds;
 		Std::Span<u32 const> utfValues;
 		Std::Span<GlyphRect const> glyphRects;
@@ -23,6 +22,7 @@ namespace DEngine::Gfx::Vk
 		vk::Extent2D windowExtent;
 		u8 inFlightIndex;
 	};
+	// Records the contents of the window's GUI render pass. The caller begins and ends the render pass.
 	void RecordGuiCmds(
 		RecordGuiCmds_Params const& params);
 }
\ No newline at end of file
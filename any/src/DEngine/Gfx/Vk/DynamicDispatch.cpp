@@ -86,6 +86,7 @@ DeviceDispatchRaw DeviceDispatchRaw::Build(
 	returnVal.vkCmdDraw = (PFN_vkCmdDraw)getDeviceProcAddr(device, "vkCmdDraw");
 	returnVal.vkCmdDrawIndexed = (PFN_vkCmdDrawIndexed)getDeviceProcAddr(device, "vkCmdDrawIndexed");
 	returnVal.vkCmdEndRenderPass = (PFN_vkCmdEndRenderPass)getDeviceProcAddr(device, "vkCmdEndRenderPass");
+	returnVal.vkCmdExecuteCommands = (PFN_vkCmdExecuteCommands)getDeviceProcAddr(device, "vkCmdExecuteCommands");
 	returnVal.vkCmdNextSubpass = (PFN_vkCmdNextSubpass)getDeviceProcAddr(device, "vkCmdNextSubpass");
 	returnVal.vkCmdPipelineBarrier = (PFN_vkCmdPipelineBarrier)getDeviceProcAddr(device, "vkCmdPipelineBarrier");
 	returnVal.vkCmdPushConstants = (PFN_vkCmdPushConstants)getDeviceProcAddr(device, "vkCmdPushConstants");
@@ -135,6 +136,7 @@ DeviceDispatchRaw DeviceDispatchRaw::Build(
 	returnVal.vkGetDeviceQueue = (PFN_vkGetDeviceQueue)getDeviceProcAddr(device, "vkGetDeviceQueue");
 	returnVal.vkGetFenceStatus = (PFN_vkGetFenceStatus)getDeviceProcAddr(device, "vkGetFenceStatus");
 	returnVal.vkGetImageMemoryRequirements = (PFN_vkGetImageMemoryRequirements)getDeviceProcAddr(device, "vkGetImageMemoryRequirements");
+	returnVal.vkGetPipelineCacheData = (PFN_vkGetPipelineCacheData)getDeviceProcAddr(device, "vkGetPipelineCacheData");
 	returnVal.vkInvalidateMappedMemoryRanges = (PFN_vkInvalidateMappedMemoryRanges)getDeviceProcAddr(device, "vkInvalidateMappedMemoryRanges");
 	returnVal.vkMapMemory = (PFN_vkMapMemory)getDeviceProcAddr(device, "vkMapMemory");
 	returnVal.vkResetCommandBuffer = (PFN_vkResetCommandBuffer)getDeviceProcAddr(device, "vkResetCommandBuffer");
@@ -660,6 +662,16 @@ void DeviceDispatch::cmdEndRenderPass(vk::CommandBuffer commandBuffer) const noe
 	raw.vkCmdEndRenderPass(static_cast<VkCommandBuffer>(commandBuffer));
 }
 
+void DeviceDispatch::cmdExecuteCommands(
+	vk::CommandBuffer commandBuffer,
+	vk::ArrayProxy<vk::CommandBuffer const> secondaryCmdBuffers) const noexcept
+{
+	raw.vkCmdExecuteCommands(
+		static_cast<VkCommandBuffer>(commandBuffer),
+		secondaryCmdBuffers.size(),
+		reinterpret_cast<VkCommandBuffer const*>(secondaryCmdBuffers.data()));
+}
+
 void DeviceDispatch::cmdPipelineBarrier(
 	vk::CommandBuffer commandBuffer,
 	vk::PipelineStageFlags srcStageMask,
@@ -826,6 +838,21 @@ vk::ImageView DeviceDispatch::createImageView(
 	return temp;
 }
 
+vk::PipelineCache DeviceDispatch::CreatePipelineCache(
+	vk::PipelineCacheCreateInfo const& createInfo,
+	vk::Optional<vk::AllocationCallbacks> allocator) const
+{
+	vk::PipelineCache outPipelineCache = {};
+	auto result = (vk::Result)raw.vkCreatePipelineCache(
+		static_cast<VkDevice>(handle),
+		reinterpret_cast<VkPipelineCacheCreateInfo const*>(&createInfo),
+		reinterpret_cast<VkAllocationCallbacks const*>(static_cast<vk::AllocationCallbacks const*>(allocator)),
+		reinterpret_cast<VkPipelineCache*>(&outPipelineCache));
+	if (result != vk::Result::eSuccess)
+		throw std::runtime_error("DEngine - Vulkan: Unable to create Vulkan pipeline cache.");
+	return outPipelineCache;
+}
+
 vk::PipelineLayout DeviceDispatch::CreatePipelineLayout(
 	vk::PipelineLayoutCreateInfo const& createInfo, 
 	vk::Optional<vk::AllocationCallbacks> allocator) const
@@ -975,6 +1002,13 @@ void DeviceDispatch::Destroy(
 	DENGINE_GFX_VK_DEVICEDISPATCH_MAKEDESTROYFUNC(Semaphore)
 }
 
+void DeviceDispatch::Destroy(
+	vk::PipelineCache in,
+	vk::Optional<vk::AllocationCallbacks> allocator) const
+{
+	DENGINE_GFX_VK_DEVICEDISPATCH_MAKEDESTROYFUNC(PipelineCache)
+}
+
 void DeviceDispatch::Destroy(
 	vk::RenderPass in, 
 	vk::Optional<vk::AllocationCallbacks> allocator) const
@@ -1040,6 +1074,18 @@ vk::Result DeviceDispatch::getFenceStatus(vk::Fence fence) const noexcept
 		static_cast<VkFence>(fence)));
 }
 
+vk::Result DeviceDispatch::GetPipelineCacheData(
+	vk::PipelineCache cache,
+	uSize* pDataSize,
+	void* pData) const noexcept
+{
+	return static_cast<vk::Result>(raw.vkGetPipelineCacheData(
+		static_cast<VkDevice>(handle),
+		static_cast<VkPipelineCache>(cache),
+		pDataSize,
+		pData));
+}
+
 vk::Queue DeviceDispatch::getQueue(
 	std::uint32_t familyIndex,
 	std::uint32_t queueIndex) const
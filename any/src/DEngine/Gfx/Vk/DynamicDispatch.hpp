@@ -61,6 +61,7 @@ namespace DEngine::Gfx::Vk
 		PFN_vkCmdDraw vkCmdDraw;
 		PFN_vkCmdDrawIndexed vkCmdDrawIndexed;
 		PFN_vkCmdEndRenderPass vkCmdEndRenderPass;
+		PFN_vkCmdExecuteCommands vkCmdExecuteCommands;
 		PFN_vkCmdNextSubpass vkCmdNextSubpass;
 		PFN_vkCmdPipelineBarrier vkCmdPipelineBarrier;
 		PFN_vkCmdPushConstants vkCmdPushConstants;
@@ -110,6 +111,7 @@ namespace DEngine::Gfx::Vk
 		PFN_vkGetDeviceQueue vkGetDeviceQueue;
 		PFN_vkGetFenceStatus vkGetFenceStatus;
 		PFN_vkGetImageMemoryRequirements vkGetImageMemoryRequirements;
+		PFN_vkGetPipelineCacheData vkGetPipelineCacheData;
 		PFN_vkInvalidateMappedMemoryRanges vkInvalidateMappedMemoryRanges;
 		PFN_vkMapMemory vkMapMemory;
 		PFN_vkResetCommandBuffer vkResetCommandBuffer;
@@ -429,6 +431,10 @@ namespace DEngine::Gfx::Vk
 
 		void cmdEndRenderPass(vk::CommandBuffer commandBuffer) const noexcept;
 
+		void cmdExecuteCommands(
+			vk::CommandBuffer commandBuffer,
+			vk::ArrayProxy<vk::CommandBuffer const> secondaryCmdBuffers) const noexcept;
+
 		void cmdPipelineBarrier(
 			vk::CommandBuffer commandBuffer,
 			vk::PipelineStageFlags srcStageMask,
@@ -539,6 +545,15 @@ namespace DEngine::Gfx::Vk
 			vk::ImageViewCreateInfo const& createInfo, 
 			vk::Optional<vk::AllocationCallbacks> allocator = nullptr) const;
 
+		[[nodiscard]] vk::PipelineCache CreatePipelineCache(
+			vk::PipelineCacheCreateInfo const& info,
+			vk::Optional<vk::AllocationCallbacks> allocator = nullptr) const;
+		[[nodiscard]] auto Create(
+			vk::PipelineCacheCreateInfo const& info,
+			vk::Optional<vk::AllocationCallbacks> allocator = nullptr) const {
+			return CreatePipelineCache(info, allocator);
+		}
+
 		[[nodiscard]] vk::PipelineLayout CreatePipelineLayout(
 			vk::PipelineLayoutCreateInfo const& info,
 			vk::Optional<vk::AllocationCallbacks> allocator = nullptr) const;
@@ -589,6 +604,9 @@ namespace DEngine::Gfx::Vk
 		void Destroy(
 			vk::ImageView in,
 			vk::Optional<vk::AllocationCallbacks> allocator = nullptr) const;
+		void Destroy(
+			vk::PipelineCache in,
+			vk::Optional<vk::AllocationCallbacks> allocator = nullptr) const;
 		void Destroy(
 			vk::RenderPass in,
 			vk::Optional<vk::AllocationCallbacks> allocator = nullptr) const;
@@ -627,6 +645,12 @@ namespace DEngine::Gfx::Vk
 
 		[[nodiscard]] vk::Result getFenceStatus(vk::Fence fence) const noexcept;
 
+		// Follows the usual Vulkan two-call idiom. Pass a null pData to query the size.
+		[[nodiscard]] vk::Result GetPipelineCacheData(
+			vk::PipelineCache cache,
+			uSize* pDataSize,
+			void* pData) const noexcept;
+
 		[[nodiscard]] vk::Queue getQueue(
 			std::uint32_t familyIndex, 
 			std::uint32_t queueIndex) const;
@@ -14,6 +14,8 @@ namespace DEngine::Gfx::Vk
 
 	class GuiResourceManager;
 
+	class ShaderBundle;
+
 
 	class ViewportManager;
 	class ViewportMgr_ViewportData;
@@ -5,6 +5,7 @@
 #include "QueueData.hpp"
 #include "Vk.hpp"
 #include "RaiiHandles.hpp"
+#include "ShaderBundle.hpp"
 
 #include <DEngine/Std/BumpAllocator.hpp>
 #include <DEngine/Std/Containers/Vec.hpp>
@@ -271,7 +272,7 @@ namespace DEngine::Gfx::Vk::impl
 	static void GizmoManager_InitializeArrowShader(
 		GizmoManager& manager,
 		DeviceDispatch const& device,
-		Std::AllocRef const& transientAlloc,
+		ShaderBundle const& shaderBundle,
 		DebugUtilsDispatch const* debugUtils,
 		APIData const& apiData)
 	{
@@ -298,38 +299,20 @@ namespace DEngine::Gfx::Vk::impl
 		pipelineLayoutInfo.pPushConstantRanges = pushConstantRanges.Data();
 		manager.pipelineLayout = device.Create(pipelineLayoutInfo);
 
-		App::FileInputStream vertFile{ "data/Gizmo/Arrow/vert.spv" };
-		if (!vertFile.IsOpen())
-			throw std::runtime_error("Could not open vertex shader file");
-		vertFile.Seek(0, App::FileInputStream::SeekOrigin::End);
-		u64 vertFileLength = vertFile.Tell().Value();
-		vertFile.Seek(0, App::FileInputStream::SeekOrigin::Start);
-		auto vertCode = Std::NewVec<char>(transientAlloc);
-		vertCode.Resize((uSize)vertFileLength);
-		vertFile.Read(vertCode.Data(), vertFileLength);
-		vertFile.Close();
+		auto const vertCode = shaderBundle.Get("Gizmo/Arrow/vert.spv");
 		vk::ShaderModuleCreateInfo vertModCreateInfo{};
-		vertModCreateInfo.codeSize = vertCode.Size();
-		vertModCreateInfo.pCode = reinterpret_cast<const u32*>(vertCode.Data());
+		vertModCreateInfo.codeSize = vertCode.Size() * sizeof(u32);
+		vertModCreateInfo.pCode = vertCode.Data();
 		vk::ShaderModule vertModule = device.createShaderModule(vertModCreateInfo);
 		vk::PipelineShaderStageCreateInfo vertStageInfo{};
 		vertStageInfo.stage = vk::ShaderStageFlagBits::eVertex;
 		vertStageInfo.module = vertModule;
 		vertStageInfo.pName = "main";
 
-		App::FileInputStream fragFile{ "data/Gizmo/Arrow/frag.spv" };
-		if (!fragFile.IsOpen())
-			throw std::runtime_error("Could not open fragment shader file");
-		fragFile.Seek(0, App::FileInputStream::SeekOrigin::End);
-		u64 fragFileLength = fragFile.Tell().Value();
-		fragFile.Seek(0, App::FileInputStream::SeekOrigin::Start);
-		auto fragCode = Std::NewVec<char>(transientAlloc);
-		fragCode.Resize((uSize)fragFileLength);
-		fragFile.Read(fragCode.Data(), fragFileLength);
-		fragFile.Close();
+		auto const fragCode = shaderBundle.Get("Gizmo/Arrow/frag.spv");
 		vk::ShaderModuleCreateInfo fragModInfo{};
-		fragModInfo.codeSize = fragCode.Size();
-		fragModInfo.pCode = reinterpret_cast<u32 const*>(fragCode.Data());
+		fragModInfo.codeSize = fragCode.Size() * sizeof(u32);
+		fragModInfo.pCode = fragCode.Data();
 		vk::ShaderModule fragModule = apiData.globUtils.device.createShaderModule(fragModInfo);
 		vk::PipelineShaderStageCreateInfo fragStageInfo{};
 		fragStageInfo.stage = vk::ShaderStageFlagBits::eFragment;
@@ -428,7 +411,7 @@ namespace DEngine::Gfx::Vk::impl
 		pipelineInfo.pStages = shaderStages.Data();
 
 		vkResult = apiData.globUtils.device.Create(
-			vk::PipelineCache(),
+			apiData.globUtils.pipelineCache,
 			{ 1, &pipelineInfo },
 			nullptr,
 			&manager.arrowPipeline);
@@ -442,44 +425,26 @@ namespace DEngine::Gfx::Vk::impl
 	static void GizmoManager_InitializeQuadShader(
 		GizmoManager& manager,
 		DeviceDispatch const& device,
-		Std::AllocRef const& transientAlloc,
+		ShaderBundle const& shaderBundle,
 		DebugUtilsDispatch const* debugUtils,
 		APIData const& apiData)
 	{
 		vk::Result vkResult{};
 
-		App::FileInputStream vertFile{ "data/Gizmo/Quad/vert.spv" };
-		if (!vertFile.IsOpen())
-			throw std::runtime_error("Could not open vertex shader file");
-		vertFile.Seek(0, App::FileInputStream::SeekOrigin::End);
-		u64 vertFileLength = vertFile.Tell().Value();
-		vertFile.Seek(0, App::FileInputStream::SeekOrigin::Start);
-		auto vertCode = Std::NewVec<char>(transientAlloc);
-		vertCode.Resize((uSize)vertFileLength);
-		vertFile.Read(vertCode.Data(), vertFileLength);
-		vertFile.Close();
+		auto const vertCode = shaderBundle.Get("Gizmo/Quad/vert.spv");
 		vk::ShaderModuleCreateInfo vertModCreateInfo{};
-		vertModCreateInfo.codeSize = vertCode.Size();
-		vertModCreateInfo.pCode = reinterpret_cast<u32 const*>(vertCode.Data());
+		vertModCreateInfo.codeSize = vertCode.Size() * sizeof(u32);
+		vertModCreateInfo.pCode = vertCode.Data();
 		vk::ShaderModule vertModule = device.createShaderModule(vertModCreateInfo);
 		vk::PipelineShaderStageCreateInfo vertStageInfo{};
 		vertStageInfo.stage = vk::ShaderStageFlagBits::eVertex;
 		vertStageInfo.module = vertModule;
 		vertStageInfo.pName = "main";
 
-		App::FileInputStream fragFile{ "data/Gizmo/Quad/frag.spv" };
-		if (!fragFile.IsOpen())
-			throw std::runtime_error("Could not open fragment shader file");
-		fragFile.Seek(0, App::FileInputStream::SeekOrigin::End);
-		u64 fragFileLength = fragFile.Tell().Value();
-		fragFile.Seek(0, App::FileInputStream::SeekOrigin::Start);
-		auto fragCode = Std::NewVec<char>(transientAlloc);
-		fragCode.Resize((uSize)fragFileLength);
-		fragFile.Read(fragCode.Data(), fragFileLength);
-		fragFile.Close();
+		auto const fragCode = shaderBundle.Get("Gizmo/Quad/frag.spv");
 		vk::ShaderModuleCreateInfo fragModInfo{};
-		fragModInfo.codeSize = fragCode.Size();
-		fragModInfo.pCode = reinterpret_cast<const u32*>(fragCode.Data());
+		fragModInfo.codeSize = fragCode.Size() * sizeof(u32);
+		fragModInfo.pCode = fragCode.Data();
 		vk::ShaderModule fragModule = device.createShaderModule(fragModInfo);
 		vk::PipelineShaderStageCreateInfo fragStageInfo{};
 		fragStageInfo.stage = vk::ShaderStageFlagBits::eFragment;
@@ -564,7 +529,7 @@ namespace DEngine::Gfx::Vk::impl
 		pipelineInfo.stageCount = (u32)shaderStages.Size();
 		pipelineInfo.pStages = shaderStages.Data();
 
-		vkResult = device.Create(pipelineInfo, &manager.quadPipeline);
+		vkResult = device.Create(apiData.globUtils.pipelineCache, pipelineInfo, &manager.quadPipeline);
 		if (vkResult != vk::Result::eSuccess)
 			throw std::runtime_error("Unable to make graphics pipeline.");
 
@@ -575,44 +540,26 @@ namespace DEngine::Gfx::Vk::impl
 	static void GizmoManager_InitializeLineShader(
 		GizmoManager& manager,
 		DeviceDispatch const& device,
-		Std::AllocRef const& transientAlloc,
+		ShaderBundle const& shaderBundle,
 		DebugUtilsDispatch const* debugUtils,
 		APIData const& apiData)
 	{
 		vk::Result vkResult = {};
 
-		App::FileInputStream vertFile{ "data/Gizmo/Line/vert.spv" };
-		if (!vertFile.IsOpen())
-			throw std::runtime_error("Could not open vertex shader file");
-		vertFile.Seek(0, App::FileInputStream::SeekOrigin::End);
-		u64 vertFileLength = vertFile.Tell().Value();
-		vertFile.Seek(0, App::FileInputStream::SeekOrigin::Start);
-		auto vertCode = Std::NewVec<char>(transientAlloc);
-		vertCode.Resize((uSize)vertFileLength);
-		vertFile.Read(vertCode.Data(), vertFileLength);
-		vertFile.Close();
+		auto const vertCode = shaderBundle.Get("Gizmo/Line/vert.spv");
 		vk::ShaderModuleCreateInfo vertModCreateInfo{};
-		vertModCreateInfo.codeSize = vertCode.Size();
-		vertModCreateInfo.pCode = reinterpret_cast<const u32*>(vertCode.Data());
+		vertModCreateInfo.codeSize = vertCode.Size() * sizeof(u32);
+		vertModCreateInfo.pCode = vertCode.Data();
 		vk::ShaderModule vertModule = device.createShaderModule(vertModCreateInfo);
 		vk::PipelineShaderStageCreateInfo vertStageInfo{};
 		vertStageInfo.stage = vk::ShaderStageFlagBits::eVertex;
 		vertStageInfo.module = vertModule;
 		vertStageInfo.pName = "main";
 
-		App::FileInputStream fragFile{ "data/Gizmo/Line/frag.spv" };
-		if (!fragFile.IsOpen())
-			throw std::runtime_error("Could not open fragment shader file");
-		fragFile.Seek(0, App::FileInputStream::SeekOrigin::End);
-		u64 fragFileLength = fragFile.Tell().Value();
-		fragFile.Seek(0, App::FileInputStream::SeekOrigin::Start);
-		auto fragCode = Std::NewVec<char>(transientAlloc);
-		fragCode.Resize((uSize)fragFileLength);
-		fragFile.Read(fragCode.Data(), fragFileLength);
-		fragFile.Close();
+		auto const fragCode = shaderBundle.Get("Gizmo/Line/frag.spv");
 		vk::ShaderModuleCreateInfo fragModInfo{};
-		fragModInfo.codeSize = fragCode.Size();
-		fragModInfo.pCode = reinterpret_cast<const u32*>(fragCode.Data());
+		fragModInfo.codeSize = fragCode.Size() * sizeof(u32);
+		fragModInfo.pCode = fragCode.Data();
 		vk::ShaderModule fragModule = apiData.globUtils.device.createShaderModule(fragModInfo);
 		vk::PipelineShaderStageCreateInfo fragStageInfo{};
 		fragStageInfo.stage = vk::ShaderStageFlagBits::eFragment;
@@ -702,7 +649,7 @@ namespace DEngine::Gfx::Vk::impl
 		pipelineInfo.stageCount = (u32)shaderStages.Size();
 		pipelineInfo.pStages = shaderStages.Data();
 
-		vkResult = device.Create(pipelineInfo, &manager.linePipeline);
+		vkResult = device.Create(apiData.globUtils.pipelineCache, pipelineInfo, &manager.linePipeline);
 		if (vkResult != vk::Result::eSuccess)
 			throw std::runtime_error("Unable to make graphics pipeline.");
 
@@ -1064,21 +1011,21 @@ void Vk::GizmoManager::Initialize(GizmoManager& manager, InitInfo const& initInf
 	impl::GizmoManager_InitializeArrowShader(
 		manager,
 		*initInfo.device,
-		*initInfo.frameAlloc,
+		*initInfo.shaderBundle,
 		initInfo.debugUtils,
 		*initInfo.apiData);
 
 	impl::GizmoManager_InitializeQuadShader(
 		manager,
 		*initInfo.device,
-		*initInfo.frameAlloc,
+		*initInfo.shaderBundle,
 		initInfo.debugUtils,
 		*initInfo.apiData);
 
 	impl::GizmoManager_InitializeLineShader(
 		manager,
 		*initInfo.device,
-		*initInfo.frameAlloc,
+		*initInfo.shaderBundle,
 		initInfo.debugUtils,
 		*initInfo.apiData);
 
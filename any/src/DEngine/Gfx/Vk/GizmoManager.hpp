@@ -49,6 +49,7 @@ namespace DEngine::Gfx::Vk
 			Std::BumpAllocator* frameAlloc;
 			DebugUtilsDispatch const* debugUtils;
 			APIData const* apiData;
+			ShaderBundle const* shaderBundle;
 			Std::Span<Math::Vec3 const> arrowMesh;
 			Std::Span<Math::Vec3 const> circleLineMesh;
 			Std::Span<Math::Vec3 const> arrowScaleMesh2d;
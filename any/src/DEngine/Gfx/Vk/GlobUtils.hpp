@@ -46,6 +46,9 @@ namespace DEngine::Gfx::Vk
 		vk::RenderPass guiRenderPass{};
 		vk::RenderPass gfxRenderPass{};
 
+		// Shared by every pipeline we create.
+		vk::PipelineCache pipelineCache{};
+
 	private:
 		GlobUtils();
 		friend class APIData;
@@ -5,11 +5,13 @@
 #include "GlobUtils.hpp"
 #include "RaiiHandles.hpp"
 #include "DeletionQueue.hpp"
+#include "ShaderBundle.hpp"
 #include "StagingBufferAlloc.hpp"
 #include <DEngine/Gfx/impl/Assert.hpp>
 
 #include <DEngine/Std/Containers/Array.hpp>
 #include <DEngine/Std/Containers/Defer.hpp>
+#include <DEngine/Std/Containers/Pair.hpp>
 #include <DEngine/Std/Containers/Vec.hpp>
 #include <DEngine/Std/Containers/AllocRef.hpp>
 #include <DEngine/Std/Utility.hpp>
@@ -17,6 +19,8 @@
 // For file IO
 #include <DEngine/Application.hpp>
 
+#include <tracy/Tracy.hpp>
+
 using namespace DEngine;
 using namespace DEngine::Gfx;
 using namespace DEngine::Gfx::Vk;
@@ -50,12 +54,40 @@ namespace DEngine::Gfx::Vk::GuiResourceManagerImpl
 		return { binding };
 	}
 
+	static Std::Array<vk::VertexInputAttributeDescription, 2> BuildTextVertexInputAttrDescr()
+	{
+		vk::VertexInputAttributeDescription glyphRect{};
+		glyphRect.binding = 0;
+		glyphRect.format = vk::Format::eR32G32B32A32Sfloat;
+		glyphRect.location = 0;
+		glyphRect.offset = offsetof(GuiResourceManager::GlyphInstance, rectOffset);
+
+		vk::VertexInputAttributeDescription glyphUvRect{};
+		glyphUvRect.binding = 0;
+		glyphUvRect.format = vk::Format::eR32G32B32A32Sfloat;
+		glyphUvRect.location = 1;
+		glyphUvRect.offset = offsetof(GuiResourceManager::GlyphInstance, uvOffset);
+
+		return { glyphRect, glyphUvRect };
+	}
+
+	static Std::Array<vk::VertexInputBindingDescription, 1> BuildTextVertexInputBindingDescr()
+	{
+		vk::VertexInputBindingDescription binding{};
+		binding.binding = 0;
+		binding.inputRate = vk::VertexInputRate::eInstance;
+		binding.stride = sizeof(GuiResourceManager::GlyphInstance);
+
+		return { binding };
+	}
+
 	static void CreateRectangleShader(
 		GuiResourceManager& manager,
 		DeviceDispatch const& device,
 		vk::DescriptorSetLayout descrSetLayout,
 		vk::RenderPass guiRenderPass,
-		Std::AllocRef const& transientAlloc,
+		vk::PipelineCache pipelineCache,
+		ShaderBundle const& shaderBundle,
 		DebugUtilsDispatch const* debugUtils)
 	{
 		vk::PipelineLayoutCreateInfo pipelineLayoutInfo{};
@@ -130,19 +162,10 @@ namespace DEngine::Gfx::Vk::GuiResourceManagerImpl
 		colorBlendState.blendConstants[3] = 0.0f;
 
 
-		App::FileInputStream vertFile{ "data/gui/Rectangle/vert.spv" };
-		if (!vertFile.IsOpen())
-			throw std::runtime_error("Could not open vertex shader file");
-		vertFile.Seek(0, App::FileInputStream::SeekOrigin::End);
-		u64 vertFileLength = vertFile.Tell().Value();
-		vertFile.Seek(0, App::FileInputStream::SeekOrigin::Start);
-		auto vertCode = Std::NewVec<char>(transientAlloc);
-		vertCode.Resize((uSize)vertFileLength);
-		vertFile.Read(vertCode.Data(), vertFileLength);
-		vertFile.Close();
+		auto const vertCode = shaderBundle.Get("gui/Rectangle/vert.spv");
 		vk::ShaderModuleCreateInfo vertModCreateInfo{};
-		vertModCreateInfo.codeSize = vertCode.Size();
-		vertModCreateInfo.pCode = reinterpret_cast<const u32*>(vertCode.Data());
+		vertModCreateInfo.codeSize = vertCode.Size() * sizeof(u32);
+		vertModCreateInfo.pCode = vertCode.Data();
 		vk::ShaderModule vertModule = device.createShaderModule(vertModCreateInfo);
 		vk::PipelineShaderStageCreateInfo vertStageInfo{};
 		vertStageInfo.stage = vk::ShaderStageFlagBits::eVertex;
@@ -150,19 +173,10 @@ namespace DEngine::Gfx::Vk::GuiResourceManagerImpl
 		vertStageInfo.pName = "main";
 
 
-		App::FileInputStream fragFile{ "data/gui/Rectangle/frag.spv" };
-		if (!fragFile.IsOpen())
-			throw std::runtime_error("Could not open fragment shader file");
-		fragFile.Seek(0, App::FileInputStream::SeekOrigin::End);
-		u64 fragFileLength = fragFile.Tell().Value();
-		fragFile.Seek(0, App::FileInputStream::SeekOrigin::Start);
-		auto fragCode = Std::NewVec<char>(transientAlloc);
-		fragCode.Resize((uSize)fragFileLength);
-		fragFile.Read(fragCode.Data(), fragFileLength);
-		fragFile.Close();
+		auto const fragCode = shaderBundle.Get("gui/Rectangle/frag.spv");
 		vk::ShaderModuleCreateInfo fragModInfo{};
-		fragModInfo.codeSize = fragCode.Size();
-		fragModInfo.pCode = reinterpret_cast<u32 const*>(fragCode.Data());
+		fragModInfo.codeSize = fragCode.Size() * sizeof(u32);
+		fragModInfo.pCode = fragCode.Data();
 		vk::ShaderModule fragModule = device.createShaderModule(fragModInfo);
 		vk::PipelineShaderStageCreateInfo fragStageInfo{};
 		fragStageInfo.stage = vk::ShaderStageFlagBits::eFragment;
@@ -194,7 +208,7 @@ namespace DEngine::Gfx::Vk::GuiResourceManagerImpl
 		pipelineInfo.pStages = shaderStages.Data();
 
 		vk::Pipeline pipeline = {};
-		vk::Result vkResult = device.Create(pipelineInfo, &pipeline);
+		vk::Result vkResult = device.Create(pipelineCache, pipelineInfo, &pipeline);
 		if (vkResult != vk::Result::eSuccess)
 			throw std::runtime_error("DEngine - Vulkan: Unable to create GUI shader.");
 		if (debugUtils != nullptr) {
@@ -216,7 +230,8 @@ namespace DEngine::Gfx::Vk::GuiResourceManagerImpl
 		DeviceDispatch const& device,
 		vk::DescriptorSetLayout descrSetLayout,
 		vk::RenderPass guiRenderPass,
-		Std::AllocRef const& transientAlloc,
+		vk::PipelineCache pipelineCache,
+		ShaderBundle const& shaderBundle,
 		DebugUtilsDispatch const* debugUtils)
 	{
 		vk::PipelineLayoutCreateInfo pipelineLayoutInfo{};
@@ -294,19 +309,10 @@ namespace DEngine::Gfx::Vk::GuiResourceManagerImpl
 		colorBlendState.pAttachments = &colorBlendAttachment;
 
 
-		App::FileInputStream vertFile{ "data/gui/FilledMesh/vert.spv" };
-		if (!vertFile.IsOpen())
-			throw std::runtime_error("Could not open vertex shader file");
-		vertFile.Seek(0, App::FileInputStream::SeekOrigin::End);
-		u64 vertFileLength = vertFile.Tell().Value();
-		vertFile.Seek(0, App::FileInputStream::SeekOrigin::Start);
-		auto vertCode = Std::NewVec<char>(transientAlloc);
-		vertCode.Resize((uSize)vertFileLength);
-		vertFile.Read(vertCode.Data(), vertFileLength);
-		vertFile.Close();
+		auto const vertCode = shaderBundle.Get("gui/FilledMesh/vert.spv");
 		vk::ShaderModuleCreateInfo vertModCreateInfo{};
-		vertModCreateInfo.codeSize = vertCode.Size();
-		vertModCreateInfo.pCode = reinterpret_cast<const u32*>(vertCode.Data());
+		vertModCreateInfo.codeSize = vertCode.Size() * sizeof(u32);
+		vertModCreateInfo.pCode = vertCode.Data();
 		vk::ShaderModule vertModule = device.createShaderModule(vertModCreateInfo);
 		vk::PipelineShaderStageCreateInfo vertStageInfo{};
 		vertStageInfo.stage = vk::ShaderStageFlagBits::eVertex;
@@ -314,19 +320,10 @@ namespace DEngine::Gfx::Vk::GuiResourceManagerImpl
 		vertStageInfo.pName = "main";
 
 
-		App::FileInputStream fragFile{ "data/gui/FilledMesh/frag.spv" };
-		if (!fragFile.IsOpen())
-			throw std::runtime_error("Could not open fragment shader file");
-		fragFile.Seek(0, App::FileInputStream::SeekOrigin::End);
-		u64 fragFileLength = fragFile.Tell().Value();
-		fragFile.Seek(0, App::FileInputStream::SeekOrigin::Start);
-		auto fragCode = Std::NewVec<char>(transientAlloc);
-		fragCode.Resize((uSize)fragFileLength);
-		fragFile.Read(fragCode.Data(), fragFileLength);
-		fragFile.Close();
+		auto const fragCode = shaderBundle.Get("gui/FilledMesh/frag.spv");
 		vk::ShaderModuleCreateInfo fragModInfo{};
-		fragModInfo.codeSize = fragCode.Size();
-		fragModInfo.pCode = reinterpret_cast<u32 const*>(fragCode.Data());
+		fragModInfo.codeSize = fragCode.Size() * sizeof(u32);
+		fragModInfo.pCode = fragCode.Data();
 		vk::ShaderModule fragModule = device.createShaderModule(fragModInfo);
 		vk::PipelineShaderStageCreateInfo fragStageInfo{};
 		fragStageInfo.stage = vk::ShaderStageFlagBits::eFragment;
@@ -357,7 +354,7 @@ namespace DEngine::Gfx::Vk::GuiResourceManagerImpl
 		pipelineInfo.stageCount = 2;
 		pipelineInfo.pStages = shaderStages.Data();
 
-		vk::Result vkResult = device.Create(pipelineInfo, &manager.filledMeshPipeline);
+		vk::Result vkResult = device.Create(pipelineCache, pipelineInfo, &manager.filledMeshPipeline);
 		if (vkResult != vk::Result::eSuccess)
 			throw std::runtime_error("DEngine - Vulkan: Unable to create GUI shader.");
 
@@ -378,7 +375,8 @@ namespace DEngine::Gfx::Vk::GuiResourceManagerImpl
 		vk::DescriptorSetLayout perWindowDescrLayout,
 		vk::DescriptorSetLayout viewportImgDescrLayout,
 		vk::RenderPass guiRenderPass,
-		Std::AllocRef const& transientAlloc,
+		vk::PipelineCache pipelineCache,
+		ShaderBundle const& shaderBundle,
 		DebugUtilsDispatch const* debugUtils)
 	{
 		vk::DescriptorSetLayout descrLayouts[2] = { perWindowDescrLayout, viewportImgDescrLayout };
@@ -438,19 +436,10 @@ namespace DEngine::Gfx::Vk::GuiResourceManagerImpl
 		colorBlendState.attachmentCount = 1;
 		colorBlendState.pAttachments = &colorBlendAttachment;
 
-		App::FileInputStream vertFile{ "data/gui/Viewport/vert.spv" };
-		if (!vertFile.IsOpen())
-			throw std::runtime_error("Could not open vertex shader file");
-		vertFile.Seek(0, App::FileInputStream::SeekOrigin::End);
-		u64 vertFileLength = vertFile.Tell().Value();
-		vertFile.Seek(0, App::FileInputStream::SeekOrigin::Start);
-		auto vertCode = Std::NewVec<char>(transientAlloc);
-		vertCode.Resize((uSize)vertFileLength);
-		vertFile.Read(vertCode.Data(), vertFileLength);
-		vertFile.Close();
+		auto const vertCode = shaderBundle.Get("gui/Viewport/vert.spv");
 		vk::ShaderModuleCreateInfo vertModCreateInfo{};
-		vertModCreateInfo.codeSize = vertCode.Size();
-		vertModCreateInfo.pCode = reinterpret_cast<const u32*>(vertCode.Data());
+		vertModCreateInfo.codeSize = vertCode.Size() * sizeof(u32);
+		vertModCreateInfo.pCode = vertCode.Data();
 		vk::ShaderModule vertModule = device.createShaderModule(vertModCreateInfo);
 		vk::PipelineShaderStageCreateInfo vertStageInfo{};
 		vertStageInfo.stage = vk::ShaderStageFlagBits::eVertex;
@@ -458,19 +447,10 @@ namespace DEngine::Gfx::Vk::GuiResourceManagerImpl
 		vertStageInfo.pName = "main";
 		
 		
-		App::FileInputStream fragFile{ "data/gui/Viewport/frag.spv" };
-		if (!fragFile.IsOpen())
-			throw std::runtime_error("Could not open fragment shader file");
-		fragFile.Seek(0, App::FileInputStream::SeekOrigin::End);
-		u64 fragFileLength = fragFile.Tell().Value();
-		fragFile.Seek(0, App::FileInputStream::SeekOrigin::Start);
-		auto fragCode = Std::NewVec<char>(transientAlloc);
-		fragCode.Resize((uSize)fragFileLength);
-		fragFile.Read(fragCode.Data(), fragFileLength);
-		fragFile.Close();
+		auto const fragCode = shaderBundle.Get("gui/Viewport/frag.spv");
 		vk::ShaderModuleCreateInfo fragModInfo{};
-		fragModInfo.codeSize = fragCode.Size();
-		fragModInfo.pCode = reinterpret_cast<u32 const*>(fragCode.Data());
+		fragModInfo.codeSize = fragCode.Size() * sizeof(u32);
+		fragModInfo.pCode = fragCode.Data();
 		vk::ShaderModule fragModule = device.createShaderModule(fragModInfo);
 		vk::PipelineShaderStageCreateInfo fragStageInfo{};
 		fragStageInfo.stage = vk::ShaderStageFlagBits::eFragment;
@@ -501,7 +481,7 @@ namespace DEngine::Gfx::Vk::GuiResourceManagerImpl
 		pipelineInfo.stageCount = 2;
 		pipelineInfo.pStages = shaderStages.Data();
 
-		vk::Result vkResult = device.Create(pipelineInfo, &manager.viewportPipeline);
+		vk::Result vkResult = device.Create(pipelineCache, pipelineInfo, &manager.viewportPipeline);
 		if (vkResult != vk::Result::eSuccess)
 			throw std::runtime_error("DEngine - Vulkan: Unable to create GUI shader.");
 		if (debugUtils)
@@ -520,8 +500,9 @@ namespace DEngine::Gfx::Vk::GuiResourceManagerImpl
 		GuiResourceManager& manager,
 		DeviceDispatch const& device,
 		vk::RenderPass guiRenderPass,
+		vk::PipelineCache pipelineCache,
 		vk::PipelineLayout pipelineLayout,
-		Std::AllocRef const& transientAlloc,
+		ShaderBundle const& shaderBundle,
 		DebugUtilsDispatch const* debugUtils)
 	{
 		vk::DynamicState dynamicStates[2] = { vk::DynamicState::eViewport, vk::DynamicState::eScissor };
@@ -536,6 +517,12 @@ namespace DEngine::Gfx::Vk::GuiResourceManagerImpl
 		rasterizationState.lineWidth = 1.f;
 		rasterizationState.polygonMode = vk::PolygonMode::eFill;
 		vk::PipelineVertexInputStateCreateInfo vertexInputState{};
+		auto vertexAttribDescrs = GuiResourceManagerImpl::BuildTextVertexInputAttrDescr();
+		vertexInputState.vertexAttributeDescriptionCount = (u32)vertexAttribDescrs.Size();
+		vertexInputState.pVertexAttributeDescriptions = vertexAttribDescrs.Data();
+		auto vertexBindingDescrs = GuiResourceManagerImpl::BuildTextVertexInputBindingDescr();
+		vertexInputState.vertexBindingDescriptionCount = (u32)vertexBindingDescrs.Size();
+		vertexInputState.pVertexBindingDescriptions = vertexBindingDescrs.Data();
 		vk::Viewport viewport{};
 		viewport.x = 0.0f;
 		viewport.y = 0.0f;
@@ -568,19 +555,10 @@ namespace DEngine::Gfx::Vk::GuiResourceManagerImpl
 		colorBlendState.pAttachments = &colorBlendAttachment;
 
 
-		App::FileInputStream vertFile{ "data/gui/Text/vert.spv" };
-		if (!vertFile.IsOpen())
-			throw std::runtime_error("Could not open vertex shader file");
-		vertFile.Seek(0, App::FileInputStream::SeekOrigin::End);
-		u64 vertFileLength = vertFile.Tell().Value();
-		vertFile.Seek(0, App::FileInputStream::SeekOrigin::Start);
-		auto vertCode = Std::NewVec<char>(transientAlloc);
-		vertCode.Resize((uSize)vertFileLength);
-		vertFile.Read(vertCode.Data(), vertFileLength);
-		vertFile.Close();
+		auto const vertCode = shaderBundle.Get("gui/Text/vert.spv");
 		vk::ShaderModuleCreateInfo vertModCreateInfo{};
-		vertModCreateInfo.codeSize = vertCode.Size();
-		vertModCreateInfo.pCode = reinterpret_cast<const u32*>(vertCode.Data());
+		vertModCreateInfo.codeSize = vertCode.Size() * sizeof(u32);
+		vertModCreateInfo.pCode = vertCode.Data();
 		vk::ShaderModule vertModule = device.createShaderModule(vertModCreateInfo);
 		vk::PipelineShaderStageCreateInfo vertStageInfo{};
 		vertStageInfo.stage = vk::ShaderStageFlagBits::eVertex;
@@ -588,19 +566,10 @@ namespace DEngine::Gfx::Vk::GuiResourceManagerImpl
 		vertStageInfo.pName = "main";
 
 
-		App::FileInputStream fragFile{ "data/gui/Text/frag.spv" };
-		if (!fragFile.IsOpen())
-			throw std::runtime_error("Could not open fragment shader file");
-		fragFile.Seek(0, App::FileInputStream::SeekOrigin::End);
-		u64 fragFileLength = fragFile.Tell().Value();
-		fragFile.Seek(0, App::FileInputStream::SeekOrigin::Start);
-		auto fragCode = Std::NewVec<char>(transientAlloc);
-		fragCode.Resize((uSize)fragFileLength);
-		fragFile.Read(fragCode.Data(), fragFileLength);
-		fragFile.Close();
+		auto const fragCode = shaderBundle.Get("gui/Text/frag.spv");
 		vk::ShaderModuleCreateInfo fragModInfo{};
-		fragModInfo.codeSize = fragCode.Size();
-		fragModInfo.pCode = reinterpret_cast<u32 const*>(fragCode.Data());
+		fragModInfo.codeSize = fragCode.Size() * sizeof(u32);
+		fragModInfo.pCode = fragCode.Data();
 		vk::ShaderModule fragModule = device.createShaderModule(fragModInfo);
 		vk::PipelineShaderStageCreateInfo fragStageInfo = {};
 		fragStageInfo.stage = vk::ShaderStageFlagBits::eFragment;
@@ -632,7 +601,7 @@ namespace DEngine::Gfx::Vk::GuiResourceManagerImpl
 		pipelineInfo.pStages = shaderStages.Data();
 
 		vk::Pipeline pipeline = {};
-		auto vkResult = device.Create(pipelineInfo, &pipeline);
+		auto vkResult = device.Create(pipelineCache, pipelineInfo, &pipeline);
 		if (vkResult != vk::Result::eSuccess)
 			throw std::runtime_error("DEngine - Vulkan: Unable to create GUI shader.");
 		if (debugUtils) {
@@ -644,8 +613,30 @@ namespace DEngine::Gfx::Vk::GuiResourceManagerImpl
 
 		manager.font_pipeline = pipeline;
 
+		// The signed distance field pipeline only differs in the fragment shader.
+		auto const sdfFragCode = shaderBundle.Get("gui/Text/sdf_frag.spv");
+		vk::ShaderModuleCreateInfo sdfFragModInfo{};
+		sdfFragModInfo.codeSize = sdfFragCode.Size() * sizeof(u32);
+		sdfFragModInfo.pCode = sdfFragCode.Data();
+		vk::ShaderModule sdfFragModule = device.createShaderModule(sdfFragModInfo);
+		shaderStages[1].module = sdfFragModule;
+
+		vk::Pipeline sdfPipeline = {};
+		vkResult = device.Create(pipelineCache, pipelineInfo, &sdfPipeline);
+		if (vkResult != vk::Result::eSuccess)
+			throw std::runtime_error("DEngine - Vulkan: Unable to create GUI shader.");
+		if (debugUtils) {
+			debugUtils->Helper_SetObjectName(
+				device.handle,
+				sdfPipeline,
+				"GuiResourceManager - Text SDF Pipeline");
+		}
+
+		manager.font_sdfPipeline = sdfPipeline;
+
 		device.Destroy(vertModule);
 		device.Destroy(fragModule);
+		device.Destroy(sdfFragModule);
 	}
 
 	static auto AllocateDescriptorSets(
@@ -861,6 +852,17 @@ namespace DEngine::Gfx::Vk::GuiResourceManagerImpl
 				"GuiResourceManager - Text Sampler");
 		}
 
+		// Distance fields are scaled, so they need to be interpolated.
+		samplerInfo.magFilter = vk::Filter::eLinear;
+		samplerInfo.minFilter = vk::Filter::eLinear;
+		auto sdfSampler = device.Create(samplerInfo);
+		if (debugUtils) {
+			debugUtils->Helper_SetObjectName(
+				device.handle,
+				sdfSampler,
+				"GuiResourceManager - Text SDF Sampler");
+		}
+
 		vk::PushConstantRange pushConstantRange = {};
 		pushConstantRange.stageFlags = vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment;
 		pushConstantRange.size = sizeof(GuiResourceManager::FontPushConstant);
@@ -884,8 +886,44 @@ namespace DEngine::Gfx::Vk::GuiResourceManagerImpl
 		guiResMgr.font_descrPool = descrPool;
 		guiResMgr.font_descrSetLayout = descrSetLayout;
 		guiResMgr.font_sampler = sampler;
+		guiResMgr.font_sdfSampler = sdfSampler;
 		guiResMgr.font_pipelineLayout = pipelineLayout;
 	}
+
+	static void CreateGlyphInstanceBuffer(
+		GuiResourceManager& guiResMgr,
+		DeviceDispatch const& device,
+		VmaAllocator vma,
+		uSize inFlightCapacity,
+		u8 inFlightCount,
+		DebugUtilsDispatch const* debugUtils)
+	{
+		vk::BufferCreateInfo bufferInfo{};
+		bufferInfo.sharingMode = vk::SharingMode::eExclusive;
+		bufferInfo.size = sizeof(GuiResourceManager::GlyphInstance) * inFlightCapacity * inFlightCount;
+		bufferInfo.usage = vk::BufferUsageFlagBits::eVertexBuffer;
+		VmaAllocationCreateInfo vmaAllocInfo{};
+		vmaAllocInfo.flags = VmaAllocationCreateFlagBits::VMA_ALLOCATION_CREATE_MAPPED_BIT;
+		vmaAllocInfo.usage = VmaMemoryUsage::VMA_MEMORY_USAGE_CPU_TO_GPU;
+		VmaAllocationInfo vmaAllocResultInfo;
+		auto vkResult = (vk::Result)vmaCreateBuffer(
+			vma,
+			(VkBufferCreateInfo*)&bufferInfo,
+			&vmaAllocInfo,
+			(VkBuffer*)&guiResMgr.glyphInstanceBuffer,
+			&guiResMgr.glyphInstanceVmaAlloc,
+			&vmaAllocResultInfo);
+		if (vkResult != vk::Result::eSuccess)
+			throw std::runtime_error("DEngine - Vulkan: VMA was unable to allocate memory for GUI glyph instances.");
+		if (debugUtils) {
+			debugUtils->Helper_SetObjectName(
+				device.handle,
+				guiResMgr.glyphInstanceBuffer,
+				"GuiResourceManager - GlyphInstanceBuffer");
+		}
+		guiResMgr.glyphInstanceMappedMem = { (u8*)vmaAllocResultInfo.pMappedData, (uSize)vmaAllocResultInfo.size };
+		guiResMgr.glyphInstanceInFlightCapacity = inFlightCapacity;
+	}
 }
 
 void Vk::GuiResourceManager::Init(
@@ -896,6 +934,8 @@ void Vk::GuiResourceManager::Init(
 	auto& vma = params.vma;
 	auto inFlightCount = params.inFlightCount;
 	auto guiRenderPass = params.guiRenderPass;
+	auto pipelineCache = params.pipelineCache;
+	auto const& shaderBundle = params.shaderBundle;
 	auto& transientAlloc = params.transientAlloc;
 	auto viewportImgDescrSetLayout = params.viewportImgDescrLayout;
 	auto* debugUtils = params.debugUtils;
@@ -924,15 +964,17 @@ void Vk::GuiResourceManager::Init(
 		device,
 		windowDescrSetLayout,
 		guiRenderPass,
-		transientAlloc,
+		pipelineCache,
+		shaderBundle,
 		debugUtils);
 
 	GuiResourceManagerImpl::CreateTextShader(
 		manager,
 		device,
 		guiRenderPass,
+		pipelineCache,
 		fontPipelineLayout,
-		transientAlloc,
+		shaderBundle,
 		debugUtils);
 
 	GuiResourceManagerImpl::CreateViewportShader(
@@ -941,7 +983,8 @@ void Vk::GuiResourceManager::Init(
 		windowDescrSetLayout,
 		viewportImgDescrSetLayout,
 		guiRenderPass,
-		transientAlloc,
+		pipelineCache,
+		shaderBundle,
 		debugUtils);
 
 	vk::BufferCreateInfo vtxBufferInfo{};
@@ -997,6 +1040,14 @@ void Vk::GuiResourceManager::Init(
 	manager.indexMappedMem = { (u8*)indexVmaAllocResultInfo.pMappedData, (uSize)indexVmaAllocResultInfo.size };
 	manager.indexInFlightCapacity = manager.indexMappedMem.Size() / inFlightCount;
 
+	GuiResourceManagerImpl::CreateGlyphInstanceBuffer(
+		manager,
+		device,
+		vma,
+		minGlyphInstanceCapacity,
+		inFlightCount,
+		debugUtils);
+
 
 	/*
 	GuiResourceManagerImpl::CreateFilledMeshShader(
@@ -1004,7 +1055,8 @@ void Vk::GuiResourceManager::Init(
 		device,
 		manager.windowUniforms.setLayout,
 		guiRenderPass,
-		transientAlloc,
+		pipelineCache,
+		shaderBundle,
 		debugUtils);
 	
 
@@ -1093,10 +1145,13 @@ namespace DEngine::Gfx::Vk {
 			return BoxVkImg::Adopt(vma, img, vmaAlloc);
 		}
 
-		[[nodiscard]] vk::ImageMemoryBarrier CreateSampledImgBarrier_PreCopy(vk::Image handle) {
+		[[nodiscard]] vk::ImageMemoryBarrier CreateSampledImgBarrier_PreCopy(
+			vk::Image handle,
+			vk::ImageLayout oldLayout)
+		{
 			vk::ImageMemoryBarrier preCopyBarrier {};
 			preCopyBarrier.image = handle;
-			preCopyBarrier.oldLayout = vk::ImageLayout::eUndefined;
+			preCopyBarrier.oldLayout = oldLayout;
 			preCopyBarrier.newLayout = vk::ImageLayout::eTransferDstOptimal;
 			preCopyBarrier.srcAccessMask = {};
 			preCopyBarrier.dstAccessMask = vk::AccessFlagBits::eTransferWrite;
@@ -1121,144 +1176,27 @@ namespace DEngine::Gfx::Vk {
 	}
 
 	[[nodiscard]] vk::BufferImageCopy FontGlyphs_CreateBufferImageCopy(
-		u32 imgWidth,
-		u32 imgHeight,
+		ShelfPacker::Rect const& dstRect,
 		u64 bufferOffset)
 	{
 		vk::BufferImageCopy buffImgCopy {};
 		buffImgCopy.bufferOffset = bufferOffset;
-		buffImgCopy.bufferImageHeight = imgHeight;
+		buffImgCopy.bufferImageHeight = dstRect.height;
 		buffImgCopy.bufferRowLength = 0;
-		buffImgCopy.imageExtent = vk::Extent3D{ imgWidth, imgHeight, 1 };
+		buffImgCopy.imageOffset = vk::Offset3D{ (i32)dstRect.x, (i32)dstRect.y, 0 };
+		buffImgCopy.imageExtent = vk::Extent3D{ dstRect.width, dstRect.height, 1 };
 		buffImgCopy.imageSubresource.aspectMask = vk::ImageAspectFlagBits::eColor;
 		buffImgCopy.imageSubresource.layerCount = 1;
 		return buffImgCopy;
 	}
 
-	void FontGlyphs_RecordTransfers_PreCopyBarriers(
-		DeviceDispatch const& device,
-		vk::CommandBuffer cmdBuffer,
-		Std::Span<BoxVkImg const> images,
-		TransientAllocRef transientAlloc)
-	{
-		int jobCount = (int)images.Size();
-
-		auto preCopyBarriers = Std::NewVec<vk::ImageMemoryBarrier>(transientAlloc);
-		preCopyBarriers.Reserve(jobCount);
-		for (auto const& img : images)
-			preCopyBarriers.PushBack(
-				Helper::CreateSampledImgBarrier_PreCopy(img.handle));
-		device.cmdPipelineBarrier(
-			cmdBuffer,
-			vk::PipelineStageFlagBits::eTopOfPipe,
-			vk::PipelineStageFlagBits::eTransfer,
-			{},
-			{},{},
-			{ (u32)preCopyBarriers.Size(), preCopyBarriers.Data() });
-	}
-
-
-	void FontGlyphs_RecordTransfers_PostCopyBarriers(
-		DeviceDispatch const& device,
-		vk::CommandBuffer cmdBuffer,
-		Std::Span<BoxVkImg const> images,
-		TransientAllocRef transientAlloc)
-	{
-		int jobCount = (int)images.Size();
-
-		auto preCopyBarriers = Std::NewVec<vk::ImageMemoryBarrier>(transientAlloc);
-		preCopyBarriers.Reserve(jobCount);
-		for (auto const& img : images)
-			preCopyBarriers.PushBack(
-				Helper::CreateSampledImgBarrier_PostCopy(img.handle));
-		device.cmdPipelineBarrier(
-			cmdBuffer,
-			vk::PipelineStageFlagBits::eTransfer,
-			vk::PipelineStageFlagBits::eFragmentShader,
-			vk::DependencyFlagBits(),
-			{},
-			{},
-			{ (u32)preCopyBarriers.Size(), preCopyBarriers.Data() });
-	}
-
-	auto FontGlyphs_RecordTransfers(
-		 DeviceDispatch const& device,
-		 vk::CommandBuffer cmdBuffer,
-		 vk::Buffer stagingBuffer,
-		 int stagingBufferOffset,
-		 Std::Span<GuiResourceManager::NewGlyphJob const> glyphJobs,
-		 Std::Span<BoxVkImg const> images,
-		 TransientAllocRef transientAlloc)
-	{
-		DENGINE_IMPL_GFX_ASSERT(glyphJobs.Size() == images.Size());
-
-		int jobCount = (int)glyphJobs.Size();
-
-		FontGlyphs_RecordTransfers_PreCopyBarriers(
-			device,
-			cmdBuffer,
-			images,
-			transientAlloc);
-		// Then we make the actual transfers
-		for (int i = 0; i < jobCount; i++) {
-			auto const& job = glyphJobs[i];
-			auto buffImgCopy = FontGlyphs_CreateBufferImageCopy(
-				job.imgWidth,
-				job.imgHeight,
-				stagingBufferOffset + job.dataOffset);
-			device.cmdCopyBufferToImage(
-				cmdBuffer,
-				stagingBuffer,
-				images[i].handle,
-				vk::ImageLayout::eTransferDstOptimal,
-				buffImgCopy);
-		}
-
-		FontGlyphs_RecordTransfers_PostCopyBarriers(
-			device,
-			cmdBuffer,
-			images,
-			transientAlloc);
-	}
-
-	[[nodiscard]] std::string CreateFontGlyphOjectName(
-		FontFaceId fontFaceId,
-		u32 utfValue)
+	[[nodiscard]] std::string CreateGlyphAtlasPageObjectName(uSize pageIndex)
 	{
 		std::string name = "GuiResourceManager, ";
-		name += "FontFace " + std::to_string((int)fontFaceId) + ", ";
-		name += "Glyph " + std::to_string(utfValue);
+		name += "GlyphAtlasPage " + std::to_string(pageIndex);
 		return name;
 	}
 
-	[[nodiscard]] auto FontGlyphs_CreateVkImages(
-		DeviceDispatch const& device,
-		VmaAllocator vma,
-		Std::Span<GuiResourceManager::NewGlyphJob const> glyphJobs,
-		TransientAllocRef transientAlloc,
-		DebugUtilsDispatch const* debugUtils)
-	{
-		auto jobCount = glyphJobs.Size();
-
-		// Create an array of all our images we want to insert,
-		// And alloc space for each of these images.
-		auto imgVec = Std::NewVec<BoxVkImg>(transientAlloc);
-		imgVec.Resize(jobCount);
-		for (int i = 0; i < jobCount; i++) {
-			auto const& job = glyphJobs[i];
-			auto& img = imgVec[i];
-			img = Helper::AllocSampledImage(vma, job.imgWidth, job.imgHeight);
-
-			if (debugUtils) {
-				auto name = CreateFontGlyphOjectName(job.fontFaceId, job.utfValue);
-				name += " - VkImage";
-				debugUtils->Helper_SetObjectName(device.handle, img.handle, name.c_str());
-			}
-		}
-
-		return imgVec;
-	}
-
 	[[nodiscard]] vk::ImageView CreateFontGlyphImgView(
 		DeviceDispatch const& device,
 		vk::Image imgHandle)
@@ -1273,103 +1211,92 @@ namespace DEngine::Gfx::Vk {
 		return device.createImageView(imgViewInfo);
 	}
 
-	[[nodiscard]] auto FontGlyphs_CreateImgViews(
+	[[nodiscard]] GuiResourceManager::GlyphAtlasPage CreateGlyphAtlasPage(
+		GuiResourceManager const& guiResMgr,
 		DeviceDispatch const& device,
-		Std::Span<GuiResourceManager::NewGlyphJob const> glyphJobs,
-		Std::Span<BoxVkImg const> images,
-		TransientAllocRef transientAlloc,
-		DebugUtilsDispatch const* debugUtils)
-	{
-		auto jobCount = glyphJobs.Size();
-
-		auto imgViewVec = Std::NewVec<vk::ImageView>(transientAlloc);
-		imgViewVec.Resize(jobCount);
-		for (int i = 0; i < jobCount; i++) {
-			auto& imgView = imgViewVec[i];
-			imgView = CreateFontGlyphImgView(device, images[i].handle);
-
-			if (debugUtils) {
-				auto const& job = glyphJobs[i];
-				auto name = CreateFontGlyphOjectName(job.fontFaceId, job.utfValue);
-				name += " - VkImageView";
-				debugUtils->Helper_SetObjectName(device.handle, imgView, name.c_str());
-			}
-		}
-
-		return imgViewVec;
-	}
-
-	[[nodiscard]] auto FontGlyphs_AllocDescrSets(
-		DeviceDispatch const& device,
-		vk::DescriptorPool descrPool,
-		vk::DescriptorSetLayout setLayout,
-		uSize count,
-		TransientAllocRef transientAlloc,
-		Std::Span<GuiResourceManager::NewGlyphJob const> glyphJobs,
+		VmaAllocator vma,
+		uSize pageIndex,
 		DebugUtilsDispatch const* debugUtils)
 	{
-		// Create the descriptor sets.
-		auto setLayouts = Std::NewVec<vk::DescriptorSetLayout>(transientAlloc);
-		setLayouts.Resize(count);
-		for (auto& item : setLayouts)
-			item = setLayout;
+		constexpr auto pageSize = GuiResourceManager::glyphAtlasPageSize;
 
-		auto descrSets = Std::NewVec<vk::DescriptorSet>(transientAlloc);
-		descrSets.Resize(count);
+		auto img = Helper::AllocSampledImage(vma, pageSize, pageSize);
+		auto imgView = CreateFontGlyphImgView(device, img.handle);
 
+		// One set for bitmap glyphs and one for signed distance field glyphs.
+		vk::DescriptorSetLayout const descrSetLayouts[] = {
+			guiResMgr.font_descrSetLayout,
+			guiResMgr.font_descrSetLayout };
 		vk::DescriptorSetAllocateInfo descrSetAllocInfo {};
-		descrSetAllocInfo.descriptorPool = descrPool;
-		descrSetAllocInfo.descriptorSetCount = count;
-		descrSetAllocInfo.pSetLayouts = setLayouts.Data();
-		auto result = device.Alloc(descrSetAllocInfo, descrSets.Data());
+		descrSetAllocInfo.descriptorPool = guiResMgr.font_descrPool;
+		descrSetAllocInfo.descriptorSetCount = 2;
+		descrSetAllocInfo.pSetLayouts = descrSetLayouts;
+		vk::DescriptorSet descrSets[2] = {};
+		auto result = device.Alloc(descrSetAllocInfo, descrSets);
 		if (result != vk::Result::eSuccess)
 			throw std::runtime_error("Unable to allocate descriptor set memory.");
+		auto const descrSet = descrSets[0];
+		auto const sdfDescrSet = descrSets[1];
+
+		vk::DescriptorImageInfo descrImgInfos[2] = {};
+		descrImgInfos[0].imageLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+		descrImgInfos[0].imageView = imgView;
+		descrImgInfos[0].sampler = guiResMgr.font_sampler;
+		descrImgInfos[1] = descrImgInfos[0];
+		descrImgInfos[1].sampler = guiResMgr.font_sdfSampler;
+		vk::WriteDescriptorSet descrWrites[2] = {};
+		for (int i = 0; i < 2; i++) {
+			descrWrites[i].descriptorCount = 1;
+			descrWrites[i].descriptorType = vk::DescriptorType::eCombinedImageSampler;
+			descrWrites[i].dstBinding = 0;
+			descrWrites[i].dstSet = descrSets[i];
+			descrWrites[i].pImageInfo = &descrImgInfos[i];
+		}
+		device.updateDescriptorSets({ 2, descrWrites }, {});
 
 		if (debugUtils) {
-			for (int i = 0; i < count; i++) {
-				auto const& job = glyphJobs[i];
-				auto name = CreateFontGlyphOjectName(job.fontFaceId, job.utfValue);
-				name += " - DescrSet";
-				debugUtils->Helper_SetObjectName(device.handle, descrSets[i], name.c_str());
-			}
+			auto name = CreateGlyphAtlasPageObjectName(pageIndex);
+			debugUtils->Helper_SetObjectName(device.handle, img.handle, (name + " - VkImage").c_str());
+			debugUtils->Helper_SetObjectName(device.handle, imgView, (name + " - VkImageView").c_str());
+			debugUtils->Helper_SetObjectName(device.handle, descrSet, (name + " - DescrSet").c_str());
+			debugUtils->Helper_SetObjectName(device.handle, sdfDescrSet, (name + " - SDF DescrSet").c_str());
 		}
 
-		return descrSets;
+		GuiResourceManager::GlyphAtlasPage returnVal {};
+		auto releasedImg = img.Release();
+		returnVal.img = releasedImg.handle;
+		returnVal.imgAlloc = releasedImg.alloc;
+		returnVal.imgView = imgView;
+		returnVal.descrSet = descrSet;
+		returnVal.sdfDescrSet = sdfDescrSet;
+		returnVal.packer = ShelfPacker{ pageSize, pageSize };
+		return returnVal;
 	}
 
-	void FontGlyphs_WriteDescriptorSets(
+	// Finds room for the glyph in the first atlas page that has space,
+	// and creates a new page if none of them do.
+	[[nodiscard]] Std::Pair<u32, ShelfPacker::Rect> GlyphAtlas_Insert(
+		GuiResourceManager& guiResMgr,
 		DeviceDispatch const& device,
-		vk::Sampler fontSampler,
-		Std::Span<vk::DescriptorSet const> descrSets,
-		Std::Span<vk::ImageView const> imgViews,
-		TransientAllocRef transientAlloc)
+		VmaAllocator vma,
+		u32 width,
+		u32 height,
+		DebugUtilsDispatch const* debugUtils)
 	{
-		int count = (int)descrSets.Size();
-
-		auto descrImgInfos = Std::NewVec<vk::DescriptorImageInfo>(transientAlloc);
-		descrImgInfos.Resize(count);
-		for (int i = 0; i < count; i++) {
-			auto& descrImgInfo = descrImgInfos[i];
-			descrImgInfo.imageLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
-			descrImgInfo.imageView = imgViews[i];
-			descrImgInfo.sampler = fontSampler;
-		}
-
-		auto descrWrites = Std::NewVec<vk::WriteDescriptorSet>(transientAlloc);
-		descrWrites.Resize(count);
-		for (int i = 0; i < count; i++) {
-			auto& descrWrite = descrWrites[i];
-			descrWrite.descriptorCount = 1;
-			descrWrite.descriptorType = vk::DescriptorType::eCombinedImageSampler;
-			descrWrite.dstBinding = 0;
-			descrWrite.dstSet = descrSets[i];
-			descrWrite.pImageInfo = &descrImgInfos[i];
+		auto& pages = guiResMgr.glyphAtlasPages;
+		for (uSize i = 0; i < pages.size(); i++) {
+			auto rect = pages[i].packer.Insert(width, height);
+			if (rect.HasValue())
+				return { (u32)i, rect.Value() };
 		}
 
-		device.updateDescriptorSets({ (u32)descrWrites.Size(), descrWrites.Data() }, {});
+		pages.push_back(CreateGlyphAtlasPage(guiResMgr, device, vma, pages.size(), debugUtils));
+		auto rect = pages.back().packer.Insert(width, height);
+		if (!rect.HasValue())
+			throw std::runtime_error("DEngine - Vulkan: Glyph bitmap does not fit inside a glyph atlas page.");
+		return { (u32)(pages.size() - 1), rect.Value() };
 	}
 
-
 	struct Fonts_FlushJobs_Params {
 		DeviceDispatch const& device;
 		StagingBufferAlloc& stagingBufferAlloc;
@@ -1390,20 +1317,24 @@ namespace DEngine::Gfx::Vk {
 		auto* debugUtils = params.debugUtils;
 
 
-		std::lock_guard queueLock { guiResMgr.jobQueueLock };
 		// Flush the new font face creation jobs
-		{
-			auto& fontFaceJobs = guiResMgr.newFontFaceJobs;
-			for (auto const& item : fontFaceJobs) {
-				GuiResourceManager::FontFaceNode newNode {};
-				newNode.id = item.id;
-				guiResMgr.fontFaceNodes.push_back(Std::Move(newNode));
-			}
-			fontFaceJobs.clear();
-		}
+		guiResMgr.newFontFaceJobQueue.ConsumeAll([&guiResMgr](auto const& item) {
+			GuiResourceManager::FontFaceNode newNode {};
+			newNode.id = item.id;
+			newNode.face.type = item.type;
+			guiResMgr.fontFaceNodes.push_back(Std::Move(newNode));
+		});
 
 		auto& glyphJobs = guiResMgr.newGlyphJobs;
 		auto& glyphBitmapData = guiResMgr.queuedGlyphBitmapData;
+		guiResMgr.newGlyphBatchQueue.ConsumeAll([&](auto const& batch) {
+			auto const dataOffset = (int)glyphBitmapData.size();
+			glyphBitmapData.insert(glyphBitmapData.end(), batch.bitmapData.begin(), batch.bitmapData.end());
+			for (auto job : batch.jobs) {
+				job.dataOffset += dataOffset;
+				glyphJobs.push_back(job);
+			}
+		});
 
 		// Defer the cleanup to the end of this function.
 		Std::Defer clearQueueRoutine = [&]() {
@@ -1414,6 +1345,8 @@ namespace DEngine::Gfx::Vk {
 		int jobCount = (int)glyphJobs.size();
 		if (jobCount == 0)
 			return;
+		ZoneScopedN("Glyph uploads");
+		ZoneValue((u64)jobCount);
 		Std::ConstByteSpan allBitmapData = {
 			glyphBitmapData.data(),
 			glyphBitmapData.size() };
@@ -1421,77 +1354,131 @@ namespace DEngine::Gfx::Vk {
 
 		// Allocate the staging buffer
 		// This contains all the bitmap data.
-		// We will then transfer parts of into the destination images
+		// We will then transfer parts of it into the atlas pages
 		// in GPU memory.
 		auto stagingBuffer = stagingBufferAlloc.Alloc(device, allBitmapData.Size(), 1);
 		std::memcpy(stagingBuffer.mappedMem.Data(), allBitmapData.Data(), allBitmapData.Size());
 
+		// Find a spot in the atlas for every glyph.
+		auto glyphPageIndices = Std::NewVec<u32>(transientAlloc);
+		glyphPageIndices.Resize(jobCount, 0);
+		auto glyphRects = Std::NewVec<ShelfPacker::Rect>(transientAlloc);
+		glyphRects.Resize(jobCount, {});
+		for (int i = 0; i < jobCount; i++) {
+			auto const& job = glyphJobs[i];
+			if (job.imgWidth == 0 || job.imgHeight == 0)
+				continue;
+			auto [pageIndex, rect] = GlyphAtlas_Insert(
+				guiResMgr,
+				device,
+				vma,
+				(u32)job.imgWidth,
+				(u32)job.imgHeight,
+				debugUtils);
+			glyphPageIndices[i] = pageIndex;
+			glyphRects[i] = rect;
+		}
 
-		// Create an array of all our images we want to insert,
-		// And alloc space for each of these images.
-		auto imgVec = FontGlyphs_CreateVkImages(
-			device,
-			vma,
-			{ glyphJobs.data(), glyphJobs.size() },
-			transientAlloc,
-			debugUtils);
-
-		auto imgViewVec = FontGlyphs_CreateImgViews(
-			device,
-			{ glyphJobs.data(), glyphJobs.size() },
-			imgVec.ToSpan(),
-			transientAlloc,
-			debugUtils);
+		// Every page that receives a glyph this frame needs to go through a transfer layout.
+		auto const pageCount = guiResMgr.glyphAtlasPages.size();
+		auto pageIsDirty = Std::NewVec<bool>(transientAlloc);
+		pageIsDirty.Resize(pageCount, false);
+		for (int i = 0; i < jobCount; i++) {
+			auto const& job = glyphJobs[i];
+			if (job.imgWidth != 0 && job.imgHeight != 0)
+				pageIsDirty[glyphPageIndices[i]] = true;
+		}
 
-		FontGlyphs_RecordTransfers(
-			device,
-			cmdBuffer,
-			stagingBuffer.buffer,
-			stagingBuffer.bufferOffset,
-			{ guiResMgr.newGlyphJobs.data(), guiResMgr.newGlyphJobs.size() },
-			imgVec.ToSpan(),
-			transientAlloc);
+		auto preCopyBarriers = Std::NewVec<vk::ImageMemoryBarrier>(transientAlloc);
+		auto postCopyBarriers = Std::NewVec<vk::ImageMemoryBarrier>(transientAlloc);
+		for (uSize i = 0; i < pageCount; i++) {
+			if (!pageIsDirty[i])
+				continue;
+			auto& page = guiResMgr.glyphAtlasPages[i];
+			// Pages that already hold glyphs must keep their contents.
+			auto const oldLayout = page.hasContents ?
+				vk::ImageLayout::eShaderReadOnlyOptimal :
+				vk::ImageLayout::eUndefined;
+			preCopyBarriers.PushBack(Helper::CreateSampledImgBarrier_PreCopy(page.img, oldLayout));
+			postCopyBarriers.PushBack(Helper::CreateSampledImgBarrier_PostCopy(page.img));
+			page.hasContents = true;
+		}
 
-		// Create the descriptor sets.
-		auto descrSets = FontGlyphs_AllocDescrSets(
-			device,
-			guiResMgr.font_descrPool,
-			guiResMgr.font_descrSetLayout,
-			jobCount,
-			transientAlloc,
-			{ guiResMgr.newGlyphJobs.data(), guiResMgr.newGlyphJobs.size() },
-			debugUtils);
+		if (!preCopyBarriers.Empty()) {
+			// The source stage covers earlier frames still sampling the pages we write to.
+			device.cmdPipelineBarrier(
+				cmdBuffer,
+				vk::PipelineStageFlagBits::eFragmentShader,
+				vk::PipelineStageFlagBits::eTransfer,
+				{},
+				{},{},
+				{ (u32)preCopyBarriers.Size(), preCopyBarriers.Data() });
+
+			// One copy command per page, with a region for every glyph going into it.
+			// Opening a new font size queues hundreds of glyphs, and these would otherwise
+			// be just as many tiny copy commands.
+			auto copyRegions = Std::NewVec_Reserve<vk::BufferImageCopy>(transientAlloc, jobCount);
+			for (uSize pageIndex = 0; pageIndex < pageCount; pageIndex++) {
+				if (!pageIsDirty[pageIndex])
+					continue;
+				copyRegions.Clear();
+				for (int i = 0; i < jobCount; i++) {
+					auto const& job = glyphJobs[i];
+					if (job.imgWidth == 0 || job.imgHeight == 0 || glyphPageIndices[i] != pageIndex)
+						continue;
+					copyRegions.PushBack(FontGlyphs_CreateBufferImageCopy(
+						glyphRects[i],
+						stagingBuffer.bufferOffset + job.dataOffset));
+				}
+				device.cmdCopyBufferToImage(
+					cmdBuffer,
+					stagingBuffer.buffer,
+					guiResMgr.glyphAtlasPages[pageIndex].img,
+					vk::ImageLayout::eTransferDstOptimal,
+					{ (u32)copyRegions.Size(), copyRegions.Data() });
+			}
 
-		FontGlyphs_WriteDescriptorSets(
-			device,
-			guiResMgr.font_sampler,
-			descrSets.ToSpan(),
-			imgViewVec.ToSpan(),
-			transientAlloc);
+			device.cmdPipelineBarrier(
+				cmdBuffer,
+				vk::PipelineStageFlagBits::eTransfer,
+				vk::PipelineStageFlagBits::eFragmentShader,
+				vk::DependencyFlagBits(),
+				{},
+				{},
+				{ (u32)postCopyBarriers.Size(), postCopyBarriers.Data() });
+		}
 
-		// Now create descriptor sets and insert all the stuff into our containers.
+		// Now insert all the glyphs into our containers.
+		constexpr auto pageSize = (f32)GuiResourceManager::glyphAtlasPageSize;
 		for (int i = 0; i < jobCount; i++) {
-			auto const& job = guiResMgr.newGlyphJobs[i];
+			auto const& job = glyphJobs[i];
 
 			auto fontFaceIt = Std::FindIf(
 				guiResMgr.fontFaceNodes.begin(),
 				guiResMgr.fontFaceNodes.end(),
 				[&job](auto const& item) { return item.id == job.fontFaceId; });
 			DENGINE_IMPL_GFX_ASSERT(fontFaceIt != guiResMgr.fontFaceNodes.end());
-			auto& fontFace = fontFaceIt->face;
+			auto const isSdf = fontFaceIt->face.type == FontFaceType::Sdf;
+			auto& fontFace = isSdf ? guiResMgr.sdfGlyphs : fontFaceIt->face;
 
+			auto const& rect = glyphRects[i];
 			GuiResourceManager::GlyphData glyphData {};
-			auto releasedImg = imgVec[i].Release();
-			glyphData.img = releasedImg.handle;
-			glyphData.imgAlloc = releasedImg.alloc;
-			glyphData.imgView = imgViewVec[i];
-			glyphData.descrSet = descrSets[i];
+			glyphData.atlasPageIndex = glyphPageIndices[i];
+			glyphData.uvOffset = { (f32)rect.x / pageSize, (f32)rect.y / pageSize };
+			glyphData.uvExtent = { (f32)rect.width / pageSize, (f32)rect.height / pageSize };
+			if (isSdf) {
+				auto const outlineWidth = (f32)rect.width - 2 * job.sdfPaddingX;
+				auto const outlineHeight = (f32)rect.height - 2 * job.sdfPaddingY;
+				if (outlineWidth > 0.f && outlineHeight > 0.f)
+					glyphData.sdfPadding = { job.sdfPaddingX / outlineWidth, job.sdfPaddingY / outlineHeight };
+			}
+			glyphData.isValid = true;
 
 			// Then insert it into the font-face
 			if (job.utfValue < fontFace.lowUtfGlyphDatas.Size()) {
 				fontFace.lowUtfGlyphDatas[job.utfValue] = glyphData;
 			} else {
-				DENGINE_IMPL_UNREACHABLE();
+				fontFace.glyphDatas[job.utfValue] = glyphData;
 			}
 		}
 	}
@@ -1535,15 +1522,20 @@ void Vk::GuiResourceManager::NewFontTextures(
 	GuiResourceManager& manager,
 	Std::Span<FontBitmapUploadJob const> const& jobs)
 {
-	std::lock_guard queueLock { manager.jobQueueLock };
+	NewGlyphBatch batch {};
+	batch.jobs.reserve(jobs.Size());
+	uSize totalDataSize = 0;
+	for (auto const& job : jobs)
+		totalDataSize += job.data.Size();
+	batch.bitmapData.reserve(totalDataSize);
 
 	for (auto const& job : jobs) {
 		// Append the data
-		auto const oldLength = (int)manager.queuedGlyphBitmapData.size();
+		auto const oldLength = (int)batch.bitmapData.size();
 		auto const newLength = oldLength + job.data.Size();
-		manager.queuedGlyphBitmapData.resize((uSize)newLength);
+		batch.bitmapData.resize((uSize)newLength);
 		memcpy(
-			manager.queuedGlyphBitmapData.data() + oldLength,
+			batch.bitmapData.data() + oldLength,
 			job.data.Data(),
 			job.data.Size());
 
@@ -1554,7 +1546,48 @@ void Vk::GuiResourceManager::NewFontTextures(
 		newJob.imgHeight = (int)job.height;
 		newJob.dataOffset = oldLength;
 		newJob.dataLength = (int)job.data.Size();
-		manager.newGlyphJobs.push_back(newJob);
+		newJob.sdfPaddingX = job.sdfPaddingX;
+		newJob.sdfPaddingY = job.sdfPaddingY;
+		batch.jobs.push_back(newJob);
+	}
+
+	manager.newGlyphBatchQueue.Push(Std::Move(batch));
+}
+
+namespace DEngine::Gfx::Vk::GuiResourceManagerImpl
+{
+	[[nodiscard]] static GuiResourceManager::FontFace const& GetFontFace(
+		GuiResourceManager const& manager,
+		FontFaceId id)
+	{
+		auto fontFaceIt = Std::FindIf(
+			manager.fontFaceNodes.begin(),
+			manager.fontFaceNodes.end(),
+			[id](auto const& item) { return item.id == id; });
+		DENGINE_IMPL_GFX_ASSERT(fontFaceIt != manager.fontFaceNodes.end());
+		return fontFaceIt->face;
+	}
+
+	// Returns nullptr if the bitmap for this glyph has not been uploaded yet.
+	// This is expected while the text manager is still pre-warming a font size,
+	// the glyph is then drawn as soon as its bitmap arrives.
+	[[nodiscard]] static GuiResourceManager::GlyphData const* FindGlyphData(
+		GuiResourceManager const& manager,
+		GuiResourceManager::FontFace const& fontFace,
+		u32 utfValue)
+	{
+		auto const& glyphFace = fontFace.type == FontFaceType::Sdf ? manager.sdfGlyphs : fontFace;
+		GuiResourceManager::GlyphData const* returnVal = nullptr;
+		if (utfValue < glyphFace.lowUtfGlyphDatas.Size()) {
+			returnVal = &glyphFace.lowUtfGlyphDatas[utfValue];
+		} else {
+			auto it = glyphFace.glyphDatas.find(utfValue);
+			if (it != glyphFace.glyphDatas.end())
+				returnVal = &it->second;
+		}
+		if (returnVal != nullptr && !returnVal->isValid)
+			returnVal = nullptr;
+		return returnVal;
 	}
 }
 
@@ -1563,32 +1596,83 @@ GuiResourceManager::GlyphData GuiResourceManager::GetGlyphData(
 	FontFaceId fontFace,
 	u32 utfValue)
 {
-	// First find the font face with this node.
-	auto const nodeIt = Std::FindIf(
-		mgr.fontFaceNodes.begin(),
-		mgr.fontFaceNodes.end(),
-		[fontFace](auto const& item) { return item.id == fontFace; });
-	DENGINE_IMPL_GFX_ASSERT(nodeIt != mgr.fontFaceNodes.end());
-	auto const& face = nodeIt->face;
-
-	if (utfValue < face.lowUtfGlyphDatas.Size()) {
-		return face.lowUtfGlyphDatas[utfValue];
-	} else {
-		auto it = face.glyphDatas.find(utfValue);
-		DENGINE_IMPL_GFX_ASSERT(it != face.glyphDatas.end());
-		return it->second;
-	}
+	auto const& face = GuiResourceManagerImpl::GetFontFace(mgr, fontFace);
+	auto const* glyphData = GuiResourceManagerImpl::FindGlyphData(mgr, face, utfValue);
+	return glyphData != nullptr ? *glyphData : GlyphData{};
 }
 
 void GuiResourceManager::NewFontFace(
 	GuiResourceManager& manager,
-	FontFaceId id)
+	FontFaceId id,
+	FontFaceType type)
 {
-	std::lock_guard queueLock { manager.jobQueueLock };
-
 	NewFontFaceJob newJob {};
 	newJob.id = id;
-	manager.newFontFaceJobs.push_back(newJob);
+	newJob.type = type;
+	manager.newFontFaceJobQueue.Push(newJob);
+}
+
+void GuiResourceManager::UpdateGlyphInstances(
+	GuiResourceManager& manager,
+	UpdateGlyphInstances_Params const& params)
+{
+	auto const& globUtils = params.globUtils;
+	auto& delQueue = params.delQueue;
+	auto const& drawCmds = params.drawCmds;
+	auto const& utfValues = params.utfValues;
+	auto const& glyphRects = params.glyphRects;
+	auto inFlightIndex = params.inFlightIndex;
+	DENGINE_IMPL_GFX_ASSERT(utfValues.Size() == glyphRects.Size());
+
+	// Grow the instance buffer if this frame has more glyphs than we can fit.
+	auto const glyphCount = utfValues.Size();
+	if (glyphCount > manager.glyphInstanceInFlightCapacity) {
+		delQueue.Destroy(manager.glyphInstanceVmaAlloc, manager.glyphInstanceBuffer);
+		auto newCapacity = manager.glyphInstanceInFlightCapacity;
+		while (newCapacity < glyphCount)
+			newCapacity *= 2;
+		GuiResourceManagerImpl::CreateGlyphInstanceBuffer(
+			manager,
+			globUtils.device,
+			globUtils.vma,
+			newCapacity,
+			globUtils.inFlightCount,
+			globUtils.DebugUtilsPtr());
+	}
+
+	auto* const dstInstances =
+		reinterpret_cast<GlyphInstance*>(manager.glyphInstanceMappedMem.Data()) +
+		manager.glyphInstanceInFlightCapacity * inFlightIndex;
+
+	for (auto const& drawCmd : drawCmds) {
+		if (drawCmd.type != GuiDrawCmd::Type::Text)
+			continue;
+		auto const& textCmd = drawCmd.text;
+		DENGINE_IMPL_GFX_ASSERT(textCmd.startIndex + textCmd.count <= glyphCount);
+		auto const& fontFace = GuiResourceManagerImpl::GetFontFace(manager, textCmd.fontFaceId);
+
+		for (uSize i = textCmd.startIndex; i < textCmd.startIndex + textCmd.count; i++) {
+			auto const& glyphRect = glyphRects[i];
+			auto& instance = dstInstances[i];
+			instance = {};
+			// Glyphs without a bitmap, or whose bitmap is not uploaded yet,
+			// become degenerate instances.
+			if (glyphRect.extent == Math::Vec2::Zero())
+				continue;
+			auto const* glyphData = GuiResourceManagerImpl::FindGlyphData(manager, fontFace, utfValues[i]);
+			if (glyphData == nullptr)
+				continue;
+			// The rect covers the glyph outline, distance field glyphs
+			// need the area around it as well to fade out the edges.
+			Math::Vec2 const padding = {
+				glyphRect.extent.x * glyphData->sdfPadding.x,
+				glyphRect.extent.y * glyphData->sdfPadding.y };
+			instance.rectOffset = glyphRect.pos - padding;
+			instance.rectExtent = glyphRect.extent + padding * 2.f;
+			instance.uvOffset = glyphData->uvOffset;
+			instance.uvExtent = glyphData->uvExtent;
+		}
+	}
 }
 
 void GuiResourceManager::PerformGuiDrawCmd_Text(
@@ -1598,66 +1682,80 @@ void GuiResourceManager::PerformGuiDrawCmd_Text(
 	vk::DescriptorSet perWindowDescrSet,
 	GuiDrawCmd::Text const& drawCmd,
 	Std::Span<u32 const> utfValuesAll,
-	Std::Span<GlyphRect const> glyphRectsAll)
+	Std::Span<GlyphRect const> glyphRectsAll,
+	u8 inFlightIndex)
 {
+	if (drawCmd.count == 0)
+		return;
+
 	auto utfValues = utfValuesAll.Subspan(drawCmd.startIndex, drawCmd.count);
 	auto glyphRects = glyphRectsAll.Subspan(drawCmd.startIndex, drawCmd.count);
 
-	auto fontFaceIt = Std::FindIf(
-		manager.fontFaceNodes.begin(),
-		manager.fontFaceNodes.end(),
-		[&](auto const& item) { return item.id == drawCmd.fontFaceId; });
-	DENGINE_IMPL_ASSERT(fontFaceIt != manager.fontFaceNodes.end());
-	auto const& fontFace = fontFaceIt->face;
+	auto const& fontFace = GuiResourceManagerImpl::GetFontFace(manager, drawCmd.fontFaceId);
+	auto const isSdf = fontFace.type == FontFaceType::Sdf;
 
 	device.cmdBindPipeline(
 		cmdBuffer,
 		vk::PipelineBindPoint::eGraphics,
-		manager.font_pipeline);
-
-	for (int i = 0; i < (int)drawCmd.count; i++)
-	{
-		auto const& glyphRect = glyphRects[i];
-		if (glyphRect.extent == Math::Vec2::Zero())
-			continue;
-		GuiResourceManager::FontPushConstant pushConstant {};
-		pushConstant.color = drawCmd.color;
-		pushConstant.rectOffset = drawCmd.posOffset + glyphRect.pos;
-		pushConstant.rectExtent = glyphRect.extent;
-		device.cmdPushConstants(
-			cmdBuffer,
-			manager.font_pipelineLayout,
-			vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment,
-			0,
-			32,
-			&pushConstant);
-
-		// Get glyph-data
-		auto utfValue = utfValues[i];
-
-		GuiResourceManager::GlyphData const* glyphData = nullptr;
-		if (utfValue < fontFace.lowUtfGlyphDatas.Size()) {
-			glyphData = &fontFace.lowUtfGlyphDatas[utfValue];
-		} else {
-			DENGINE_IMPL_GFX_UNREACHABLE();
-		}
+		isSdf ? manager.font_sdfPipeline : manager.font_pipeline);
 
-		DENGINE_IMPL_GFX_ASSERT(glyphData->img != vk::Image{});
+	GuiResourceManager::FontPushConstant pushConstant {};
+	pushConstant.color = drawCmd.color;
+	pushConstant.rectOffset = drawCmd.posOffset;
+	device.cmdPushConstants(
+		cmdBuffer,
+		manager.font_pipelineLayout,
+		vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment,
+		0,
+		sizeof(pushConstant),
+		&pushConstant);
 
+	// The instances for this draw-cmd were written by UpdateGlyphInstances.
+	vk::DeviceSize const instanceBufferOffset =
+		sizeof(GlyphInstance) * (manager.glyphInstanceInFlightCapacity * inFlightIndex + drawCmd.startIndex);
+	device.cmdBindVertexBuffers(
+		cmdBuffer,
+		0,
+		manager.glyphInstanceBuffer,
+		instanceBufferOffset);
+
+	// Draw each run of glyphs that share an atlas page in a single call.
+	auto const glyphCount = (u32)drawCmd.count;
+	u32 runStart = 0;
+	Std::Opt<u32> runPageIndex;
+	auto const flushRun = [&](u32 runEnd) {
+		if (!runPageIndex.HasValue() || runEnd == runStart)
+			return;
+		auto const& page = manager.glyphAtlasPages[runPageIndex.Value()];
 		device.cmdBindDescriptorSets(
 			cmdBuffer,
 			vk::PipelineBindPoint::eGraphics,
 			manager.font_pipelineLayout,
 			0,
-			{ perWindowDescrSet, glyphData->descrSet },
+			{ perWindowDescrSet, isSdf ? page.sdfDescrSet : page.descrSet },
 			nullptr);
 		device.cmdDraw(
 			cmdBuffer,
 			6,
-			1,
+			runEnd - runStart,
 			0,
-			0);
+			runStart);
+	};
+	for (u32 i = 0; i < glyphCount; i++) {
+		// Glyphs without a bitmap are degenerate, they can join any run.
+		if (glyphRects[i].extent == Math::Vec2::Zero())
+			continue;
+		auto const* glyphData = GuiResourceManagerImpl::FindGlyphData(manager, fontFace, utfValues[i]);
+		if (glyphData == nullptr)
+			continue;
+		auto const pageIndex = glyphData->atlasPageIndex;
+		if (runPageIndex.HasValue() && runPageIndex.Value() == pageIndex)
+			continue;
+		flushRun(i);
+		runStart = i;
+		runPageIndex = pageIndex;
 	}
+	flushRun(glyphCount);
 }
 
 void GuiResourceManager::RenderRectangle(
@@ -6,6 +6,8 @@
 #include "TransientAllocRef.hpp"
 #include "NativeWindowManager.hpp"
 #include "StagingBufferAlloc.hpp"
+#include "ShelfPacker.hpp"
+#include "MpscQueue.hpp"
 
 #include <DEngine/Std/BumpAllocator.hpp>
 #include <DEngine/Std/Containers/AllocRef.hpp>
@@ -20,7 +22,6 @@
 #include <DEngine/Gfx/Gfx.hpp>
 
 #include <unordered_map>
-#include <mutex>
 
 namespace DEngine::Gfx {
 	struct GuiVertex;
@@ -111,11 +112,11 @@ namespace DEngine::Gfx::Vk
 		vk::Pipeline rectanglePipeline{};
 		vk::PipelineLayout rectanglePipelineLayout{};
 		
-		std::mutex jobQueueLock;
 		struct NewFontFaceJob {
 			FontFaceId id;
+			FontFaceType type;
 		};
-		std::vector<NewFontFaceJob> newFontFaceJobs;
+		MpscQueue<NewFontFaceJob> newFontFaceJobQueue;
 		struct NewGlyphJob {
 			FontFaceId fontFaceId;
 			int dataOffset;
@@ -123,18 +124,51 @@ namespace DEngine::Gfx::Vk
 			int imgWidth;
 			int imgHeight;
 			u32 utfValue;
+			f32 sdfPaddingX;
+			f32 sdfPaddingY;
 		};
+		// Every NewFontTextures call is pushed as one batch, carrying its own copy of the bitmaps.
+		// The producer builds it without touching any shared state.
+		struct NewGlyphBatch {
+			std::vector<NewGlyphJob> jobs;
+			// Job data offsets are relative to the start of this.
+			std::vector<char> bitmapData;
+		};
+		MpscQueue<NewGlyphBatch> newGlyphBatchQueue;
+		// Only accessed by the rendering thread. The batches are gathered in here
+		// when flushing, these keep their memory between frames.
 		std::vector<NewGlyphJob> newGlyphJobs;
 		std::vector<char> queuedGlyphBitmapData;
 
-		struct GlyphData {
+		// All glyph bitmaps are packed into a small set of large atlas pages,
+		// so that a whole run of text can be drawn with a single descriptor set.
+		static constexpr u32 glyphAtlasPageSize = 1024;
+		struct GlyphAtlasPage {
 			vk::Image img{};
 			VmaAllocation imgAlloc{};
 			vk::ImageView imgView{};
 			vk::DescriptorSet descrSet{};
+			// Same image, but with a linear sampler for signed distance field glyphs.
+			vk::DescriptorSet sdfDescrSet{};
+			ShelfPacker packer;
+			// False until the first upload, the image is in undefined layout until then.
+			bool hasContents = false;
+		};
+		std::vector<GlyphAtlasPage> glyphAtlasPages;
+
+		struct GlyphData {
+			u32 atlasPageIndex = 0;
+			// Normalized position of the glyph inside the atlas page.
+			Math::Vec2 uvOffset{};
+			Math::Vec2 uvExtent{};
+			// Only for signed distance field glyphs. How much the glyph quad is grown on each side,
+			// relative to the size of the glyph outline.
+			Math::Vec2 sdfPadding{};
+			bool isValid = false;
 		};
 
 		struct FontFace {
+			FontFaceType type = FontFaceType::Bitmap;
 			std::unordered_map<u32, GlyphData> glyphDatas;
 			static constexpr uSize lowUtfGlyphDatasSize = 128;
 			Std::Array<GlyphData, lowUtfGlyphDatasSize> lowUtfGlyphDatas;
@@ -155,17 +189,36 @@ namespace DEngine::Gfx::Vk
 			FontFace face;
 		};
 		std::vector<FontFaceNode> fontFaceNodes;
+		// The glyphs shared by every signed distance field face.
+		FontFace sdfGlyphs;
 
 		struct FontPushConstant {
 			Math::Vec2 rectOffset;
-			Math::Vec2 rectExtent;
+			char padding0[8] = {};
 			Math::Vec4 color;
 		};
+		// Per-instance vertex data for the text pipeline, one instance per glyph.
+		struct GlyphInstance {
+			Math::Vec2 rectOffset;
+			Math::Vec2 rectExtent;
+			Math::Vec2 uvOffset;
+			Math::Vec2 uvExtent;
+		};
+		// Holds the glyph instances of every text draw-cmd in the frame,
+		// indexed the same way as the utf values. Duplicated per in-flight frame.
+		static constexpr uSize minGlyphInstanceCapacity = 1024;
+		vk::Buffer glyphInstanceBuffer{};
+		VmaAllocation glyphInstanceVmaAlloc{};
+		Std::Span<u8> glyphInstanceMappedMem;
+		// Measured in amount of instances.
+		uSize glyphInstanceInFlightCapacity = 0;
 		vk::DescriptorPool font_descrPool{};
 		vk::DescriptorSetLayout font_descrSetLayout{};
 		vk::Sampler font_sampler{};
+		vk::Sampler font_sdfSampler{};
 		vk::PipelineLayout font_pipelineLayout{};
 		vk::Pipeline font_pipeline{};
+		vk::Pipeline font_sdfPipeline{};
 
 		struct ViewportPushConstant {
 			Math::Vec2 rectOffset;
@@ -180,6 +233,8 @@ namespace DEngine::Gfx::Vk
 			DeviceDispatch const& device;
 			VmaAllocator vma;
 			vk::RenderPass guiRenderPass;
+			vk::PipelineCache pipelineCache;
+			ShaderBundle const& shaderBundle;
 			vk::DescriptorSetLayout viewportImgDescrLayout;
 			u8 inFlightCount;
 			Std::AllocRef transientAlloc;
@@ -221,9 +276,24 @@ namespace DEngine::Gfx::Vk
 			GuiResourceManager& manager,
 			UpdateWindowUniforms_Params const& params);
 
+		struct UpdateGlyphInstances_Params {
+			GlobUtils const& globUtils;
+			DeletionQueue& delQueue;
+			Std::Span<GuiDrawCmd const> drawCmds;
+			Std::Span<u32 const> utfValues;
+			Std::Span<GlyphRect const> glyphRects;
+			int inFlightIndex;
+		};
+		// Writes the glyph instances for every text draw-cmd of this frame.
+		// Needs to run after UpdateWindowUniforms so that all glyphs are in the atlas.
+		static void UpdateGlyphInstances(
+			GuiResourceManager& manager,
+			UpdateGlyphInstances_Params const& params);
+
 		static void NewFontFace(
 			GuiResourceManager &manager,
-			FontFaceId id);
+			FontFaceId id,
+			FontFaceType type);
 
 		static void NewFontTextures(
 			GuiResourceManager &manager,
@@ -241,7 +311,8 @@ namespace DEngine::Gfx::Vk
 			vk::DescriptorSet perWindowDescrSet,
 			GuiDrawCmd::Text const& drawCmd,
 			Std::Span<u32 const> utfValuesAll,
-			Std::Span<GlyphRect const> glyphRectsAll);
+			Std::Span<GlyphRect const> glyphRectsAll,
+			u8 inFlightIndex);
 
 		static void RenderRectangle(
 			GuiResourceManager const& manager,
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <DEngine/Std/Utility.hpp>
+
+#include <atomic>
+
+namespace DEngine::Gfx::Vk
+{
+	// Lock-free queue with any amount of producer threads and a single consumer thread.
+	// Pushing never blocks, not even while the consumer is draining the queue.
+	// Every item lives in its own node, allocated by the producer and freed by the consumer.
+	template<class T>
+	class MpscQueue
+	{
+	public:
+		MpscQueue() = default;
+		MpscQueue(MpscQueue const&) = delete;
+		MpscQueue& operator=(MpscQueue const&) = delete;
+		~MpscQueue() { ConsumeAll([](T&) {}); }
+
+		// Thread safe.
+		void Push(T value)
+		{
+			auto* node = new Node{ nullptr, Std::Move(value) };
+			node->next = head.load(std::memory_order_relaxed);
+			while (!head.compare_exchange_weak(
+				node->next,
+				node,
+				std::memory_order_release,
+				std::memory_order_relaxed)) {}
+		}
+
+		// Only call this from the consumer thread.
+		// Invokes the callable on every item pushed so far, in the order they were pushed.
+		template<class Callable>
+		void ConsumeAll(Callable&& callable)
+		{
+			Node* node = head.exchange(nullptr, std::memory_order_acquire);
+			// The nodes are linked newest first.
+			Node* oldest = nullptr;
+			while (node) {
+				auto* next = node->next;
+				node->next = oldest;
+				oldest = node;
+				node = next;
+			}
+			while (oldest) {
+				auto* next = oldest->next;
+				callable(oldest->value);
+				delete oldest;
+				oldest = next;
+			}
+		}
+
+	private:
+		struct Node {
+			Node* next;
+			T value;
+		};
+		std::atomic<Node*> head = nullptr;
+	};
+}
@@ -252,9 +252,7 @@ void Vk::NativeWinMgr_PushCreateWindowJob(
 	newJob.id = windowId;
 	newJob.surface = surface;
 
-	std::scoped_lock _{ manager.insertionJobs.lock };
-
-	manager.insertionJobs.createQueue.push_back(newJob);
+	manager.insertionJobs.createQueue.Push(newJob);
 }
 
 void Vk::NativeWinMgr_PushDeleteWindowJob(
@@ -264,9 +262,7 @@ void Vk::NativeWinMgr_PushDeleteWindowJob(
 	NativeWinMgr::DeleteJob newJob = {};
 	newJob.id = windowId;
 
-	std::scoped_lock _{ manager.insertionJobs.lock };
-
-	manager.insertionJobs.deleteQueue.push_back(newJob);
+	manager.insertionJobs.deleteQueue.Push(newJob);
 }
 
 static vk::SwapchainKHR NativeWinMgrImpl::CreateSwapchain(
@@ -437,15 +433,10 @@ static void NativeWinMgrImpl::HandleCreationJobs(
 	auto const& device = globUtils.device;
 	auto const* debugUtils = globUtils.DebugUtilsPtr();
 
-	// Copy the jobs over so we can release the mutex early
 	auto tempCreateJobs = Std::NewVec<NativeWinMgr::CreateJob>(transientAlloc);
-	{
-		std::scoped_lock lock{ manager.insertionJobs.lock };
-		tempCreateJobs.Resize(manager.insertionJobs.createQueue.size());
-		for (auto i = 0; i < tempCreateJobs.Size(); i += 1)
-			tempCreateJobs[i] = manager.insertionJobs.createQueue[i];
-		manager.insertionJobs.createQueue.clear();
-	}
+	manager.insertionJobs.createQueue.ConsumeAll([&tempCreateJobs](auto const& createJob) {
+		tempCreateJobs.PushBack(createJob);
+	});
 
 	vk::Result vkResult = {};
 
@@ -551,15 +542,10 @@ static void NativeWinMgrImpl::HandleDeletionJobs(
 	DelQueue& delQueue,
 	Std::AllocRef const& transientAlloc)
 {
-	// Copy the jobs over so we can release the mutex early
 	auto tempDeleteJobs = Std::NewVec<NativeWinMgr::DeleteJob>(transientAlloc);
-	{
-		std::lock_guard lock{ manager.insertionJobs.lock };
-		tempDeleteJobs.Resize(manager.insertionJobs.deleteQueue.size());
-		for (auto i = 0; i < tempDeleteJobs.Size(); i += 1)
-			tempDeleteJobs[i] = manager.insertionJobs.deleteQueue[i];
-		manager.insertionJobs.deleteQueue.clear();
-	}
+	manager.insertionJobs.deleteQueue.ConsumeAll([&tempDeleteJobs](auto const& deleteJob) {
+		tempDeleteJobs.PushBack(deleteJob);
+	});
 
 	auto& nativeWindows = manager.main.nativeWindows;
 
@@ -6,6 +6,7 @@
 #include "Constants.hpp"
 #include "VMAIncluder.hpp"
 #include "ForwardDeclarations.hpp"
+#include "MpscQueue.hpp"
 
 #include <DEngine/Std/BumpAllocator.hpp>
 #include <DEngine/Std/Containers/AllocRef.hpp>
@@ -69,9 +70,8 @@ namespace DEngine::Gfx::Vk
 			NativeWindowID id;
 		};
 		struct InsertionJobsT {
-			std::mutex lock;
-			std::vector<CreateJob> createQueue;
-			std::vector<DeleteJob> deleteQueue;
+			MpscQueue<CreateJob> createQueue;
+			MpscQueue<DeleteJob> deleteQueue;
 		};
 		InsertionJobsT insertionJobs;
 		// Insertion locked resources end
@@ -7,6 +7,8 @@
 
 #include <DEngine/Gfx/impl/Assert.hpp>
 
+#include <algorithm>
+#include <cstring>
 #include <string>
 
 using namespace DEngine;
@@ -25,11 +27,16 @@ namespace DEngine::Gfx::Vk {
 		auto inFlightCount = globUtils.inFlightCount;
 		auto elementSize = manager.elementSize;
 
+		// Every in-flight frame gets its own region, bound through a dynamic offset.
+		auto const alignment = manager.minStorageBufferOffsetAlignment;
+		uSize resourceSetSize = elementSize * newCapacity;
+		resourceSetSize = (resourceSetSize + alignment - 1) / alignment * alignment;
+
 		// Allocate the buffer
 		vk::BufferCreateInfo buffInfo = {};
 		buffInfo.sharingMode = vk::SharingMode::eExclusive;
-		buffInfo.size = elementSize * newCapacity * inFlightCount;
-		buffInfo.usage = vk::BufferUsageFlagBits::eUniformBuffer;
+		buffInfo.size = resourceSetSize * inFlightCount;
+		buffInfo.usage = vk::BufferUsageFlagBits::eStorageBuffer;
 		VmaAllocationCreateInfo vmaAllocInfo = {};
 		vmaAllocInfo.flags = VmaAllocationCreateFlagBits::VMA_ALLOCATION_CREATE_MAPPED_BIT;
 		vmaAllocInfo.usage = VmaMemoryUsage::VMA_MEMORY_USAGE_CPU_TO_GPU;
@@ -55,7 +62,7 @@ namespace DEngine::Gfx::Vk {
 		// Allocate the descriptor-set stuff
 		vk::DescriptorPoolSize descrPoolSize = {};
 		descrPoolSize.descriptorCount = 1;
-		descrPoolSize.type = vk::DescriptorType::eUniformBufferDynamic;
+		descrPoolSize.type = vk::DescriptorType::eStorageBufferDynamic;
 		vk::DescriptorPoolCreateInfo descrPoolInfo = {};
 		descrPoolInfo.maxSets = 1;
 		descrPoolInfo.poolSizeCount = 1;
@@ -87,16 +94,17 @@ namespace DEngine::Gfx::Vk {
 		vk::DescriptorBufferInfo descrBuffInfo = {};
 		descrBuffInfo.buffer = newBuffer;
 		descrBuffInfo.offset = 0;
-		descrBuffInfo.range = (int)elementSize;
+		descrBuffInfo.range = resourceSetSize;
 		vk::WriteDescriptorSet write = {};
 		write.descriptorCount = 1;
-		write.descriptorType = vk::DescriptorType::eUniformBufferDynamic;
+		write.descriptorType = vk::DescriptorType::eStorageBufferDynamic;
 		write.dstBinding = 0;
 		write.dstSet = descrSet;
 		write.pBufferInfo = &descrBuffInfo;
 		device.updateDescriptorSets(write, nullptr);
 
 		manager.capacity = newCapacity;
+		manager.resourceSetSize = resourceSetSize;
 		manager.buffer = newBuffer;
 		manager.vmaAlloc = vmaAlloc;
 		manager.mappedMem = vmaAllocResultInfo.pMappedData;
@@ -109,13 +117,16 @@ namespace DEngine::Gfx::Vk {
 void ObjectDataManager::Update(
 	ObjectDataManager& manager,
 	GlobUtils const& globUtils,
+	Std::Span<TextureID const> textureIds,
 	Std::Span<Math::Mat4 const> transforms,
 	vk::CommandBuffer cmdBuffer,
 	DeletionQueue& delQueue,
 	u8 inFlightIndex,
 	DebugUtilsDispatch const* debugUtils)
 {
+	DENGINE_IMPL_GFX_ASSERT(textureIds.Size() == transforms.Size());
 
+	manager.batches.clear();
 	if (transforms.Empty())
 		return;
 
@@ -143,13 +154,35 @@ void ObjectDataManager::Update(
 	}
 
 
-	auto resourceSetSize = manager.capacity * manager.elementSize;
+	// Group the sprites by texture. The sort is stable so sprites
+	// sharing a texture keep their submission order.
+	auto& sortedIndices = manager.sortedIndices;
+	sortedIndices.resize(transforms.Size());
+	for (uSize i = 0; i < sortedIndices.size(); i += 1)
+		sortedIndices[i] = (u32)i;
+	std::stable_sort(
+		sortedIndices.begin(),
+		sortedIndices.end(),
+		[&textureIds](u32 a, u32 b) { return textureIds[a] < textureIds[b]; });
+
+	auto resourceSetSize = manager.resourceSetSize;
 	auto offset = resourceSetSize * inFlightIndex;
 	auto dstResourceSet = (char*)manager.mappedMem + offset;
-	for (uSize i = 0; i < transforms.Size(); i += 1) {
-		auto const& item = transforms[i];
+	for (uSize i = 0; i < sortedIndices.size(); i += 1) {
+		auto const srcIndex = sortedIndices[i];
+		auto const& item = transforms[srcIndex];
 		char* dst = dstResourceSet + manager.elementSize * i;
 		std::memcpy(dst, item.Data(), sizeof(item));
+
+		auto const textureId = textureIds[srcIndex];
+		if (manager.batches.empty() || manager.batches.back().textureId != textureId) {
+			ObjectDataManager::SpriteBatch newBatch = {};
+			newBatch.textureId = textureId;
+			newBatch.firstInstance = (u32)i;
+			newBatch.instanceCount = 0;
+			manager.batches.push_back(newBatch);
+		}
+		manager.batches.back().instanceCount += 1;
 	}
 
 	vk::BufferMemoryBarrier barrier = {};
@@ -159,7 +192,7 @@ void ObjectDataManager::Update(
 	barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
 	barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
 	barrier.srcAccessMask = vk::AccessFlagBits::eHostWrite;
-	barrier.dstAccessMask = vk::AccessFlagBits::eUniformRead;
+	barrier.dstAccessMask = vk::AccessFlagBits::eShaderRead;
 	device.cmdPipelineBarrier(
 		cmdBuffer,
 		vk::PipelineStageFlagBits::eHost,
@@ -170,22 +203,20 @@ void ObjectDataManager::Update(
 
 bool DEngine::Gfx::Vk::ObjectDataManager::Init(
 	ObjectDataManager& manager,
-	uSize minUniformBufferOffsetAlignment,
+	uSize minStorageBufferOffsetAlignment,
 	DeviceDispatch const& device,
 	DebugUtilsDispatch const* debugUtils)
 {
 	vk::Result vkResult{};
 
-	manager.elementSize = Math::Max(
-		ObjectDataManager::minElementSize,
-		minUniformBufferOffsetAlignment);
+	manager.minStorageBufferOffsetAlignment = Math::Max(minStorageBufferOffsetAlignment, (uSize)1);
 	manager.capacity = 0;
 
 	// Create descriptor set layout
 	vk::DescriptorSetLayoutBinding objectDataBinding{};
 	objectDataBinding.binding = 0;
 	objectDataBinding.descriptorCount = 1;
-	objectDataBinding.descriptorType = vk::DescriptorType::eUniformBufferDynamic;
+	objectDataBinding.descriptorType = vk::DescriptorType::eStorageBufferDynamic;
 	objectDataBinding.stageFlags = vk::ShaderStageFlagBits::eVertex;
 	vk::DescriptorSetLayoutCreateInfo descrSetLayoutInfo{};
 	descrSetLayoutInfo.bindingCount = 1;
@@ -2,37 +2,59 @@
 
 #include <DEngine/FixedWidthTypes.hpp>
 #include <DEngine/Std/Containers/Span.hpp>
+#include <DEngine/Gfx/Gfx.hpp>
 
 #include <DEngine/Math/Matrix.hpp>
 
+#include <vector>
+
 #include "VulkanIncluder.hpp"
 #include "VMAIncluder.hpp"
 #include "ForwardDeclarations.hpp"
 
 namespace DEngine::Gfx::Vk
 {
+	// Holds the transform of every sprite in a storage buffer,
+	// so that sprites can be drawn instanced.
 	struct ObjectDataManager
 	{
 		// Contains minimum capacity of amount of elements.
 		// Not measured in bytes.
 		static constexpr uSize minCapacity = 256;
-		// Measured in bytes.
-		static constexpr uSize minElementSize = 64;
+		// Measured in bytes. The elements are tightly packed.
+		static constexpr uSize elementSize = sizeof(Math::Mat4);
 		VmaAllocation vmaAlloc = {};
 		vk::Buffer buffer = {};
 		void* mappedMem = nullptr;
 		// Contains the capacity of amount of elements.
 		// This is not amount in bytes.
 		int capacity = 0;
-		// Measured in bytes.
-		uSize elementSize = 0;
+		// Measured in bytes. Size of the region of one in-flight frame,
+		// padded to the storage buffer offset alignment.
+		uSize resourceSetSize = 0;
+		uSize minStorageBufferOffsetAlignment = 0;
 		vk::DescriptorPool descrPool{};
 		vk::DescriptorSetLayout descrSetLayout{};
 		vk::DescriptorSet descrSet{};
 
+		// A run of sprites that share a texture. Their transforms are
+		// next to each other in the buffer, so it's a single instanced draw.
+		struct SpriteBatch
+		{
+			TextureID textureId;
+			u32 firstInstance;
+			u32 instanceCount;
+		};
+		// Rebuilt on every update.
+		std::vector<SpriteBatch> batches;
+		// Only kept around to reuse the memory.
+		std::vector<u32> sortedIndices;
+
+		// Sorts the sprites by texture and writes their transforms to this frame's region.
 		static void Update(
 			ObjectDataManager& manager,
 			GlobUtils const& globUtils,
+			Std::Span<TextureID const> textureIds,
 			Std::Span<Math::Mat4 const> transforms,
 			vk::CommandBuffer cmdBuffer,
 			DeletionQueue& delQueue,
@@ -41,7 +63,7 @@ namespace DEngine::Gfx::Vk
 
 		[[nodiscard]] static bool Init(
 			ObjectDataManager& manager,
-			uSize minUniformBufferOffsetAlignment,
+			uSize minStorageBufferOffsetAlignment,
 			DeviceDispatch const& device,
 			DebugUtilsDispatch const* debugUtils);
 	};
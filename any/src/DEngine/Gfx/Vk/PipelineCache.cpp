@@ -0,0 +1,155 @@
+#include "PipelineCache.hpp"
+
+#include <DEngine/Std/Containers/Vec.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+using namespace DEngine;
+using namespace DEngine::Gfx;
+using namespace DEngine::Gfx::Vk;
+
+namespace DEngine::Gfx::Vk::PipelineCache::impl
+{
+	// "DEPC" in little endian
+	constexpr u32 blobMagic = 0x43504544;
+	// Guards against allocating garbage sizes from a corrupted header.
+	constexpr u64 maxBlobDataSize = 256 * 1024 * 1024;
+
+	struct BlobHeader
+	{
+		u32 magic;
+		u32 version;
+		u32 vendorId;
+		u32 deviceId;
+		u32 driverVersion;
+		u8 pipelineCacheUuid[VK_UUID_SIZE];
+		u64 dataSize;
+		u64 dataHash;
+	};
+
+	[[nodiscard]] static u64 HashBytes(void const* data, uSize size) noexcept
+	{
+		// FNV-1a
+		auto const* bytes = static_cast<u8 const*>(data);
+		u64 hash = 0xcbf29ce484222325ULL;
+		for (uSize i = 0; i < size; i += 1) {
+			hash ^= bytes[i];
+			hash *= 0x100000001b3ULL;
+		}
+		return hash;
+	}
+
+	[[nodiscard]] static BlobHeader BuildHeader(PhysDeviceInfo const& physDevice) noexcept
+	{
+		auto const& properties = physDevice.properties;
+		BlobHeader returnVal = {};
+		returnVal.magic = blobMagic;
+		returnVal.version = blobVersion;
+		returnVal.vendorId = properties.vendorID;
+		returnVal.deviceId = properties.deviceID;
+		returnVal.driverVersion = properties.driverVersion;
+		std::memcpy(returnVal.pipelineCacheUuid, properties.pipelineCacheUUID.data(), VK_UUID_SIZE);
+		return returnVal;
+	}
+
+	[[nodiscard]] static bool HeaderMatchesDevice(BlobHeader const& header, BlobHeader const& expected) noexcept
+	{
+		return
+			header.magic == expected.magic &&
+			header.version == expected.version &&
+			header.vendorId == expected.vendorId &&
+			header.deviceId == expected.deviceId &&
+			header.driverVersion == expected.driverVersion &&
+			std::memcmp(header.pipelineCacheUuid, expected.pipelineCacheUuid, VK_UUID_SIZE) == 0;
+	}
+}
+
+PipelineCache::Create_Return PipelineCache::Create(
+	DeviceDispatch const& device,
+	PhysDeviceInfo const& physDevice,
+	Std::Span<char const> path,
+	Std::AllocRef const& transientAlloc,
+	DebugUtilsDispatch const* debugUtils)
+{
+	auto blobData = Std::NewVec<char>(transientAlloc);
+
+	if (path.Size() != 0) {
+		std::string const pathString = { path.Data(), path.Size() };
+		std::FILE* file = std::fopen(pathString.c_str(), "rb");
+		if (file) {
+			impl::BlobHeader header = {};
+			bool validBlob = std::fread(&header, sizeof(header), 1, file) == 1;
+			validBlob = validBlob && impl::HeaderMatchesDevice(header, impl::BuildHeader(physDevice));
+			validBlob = validBlob && header.dataSize <= impl::maxBlobDataSize;
+			if (validBlob) {
+				blobData.Resize((uSize)header.dataSize);
+				validBlob = std::fread(blobData.Data(), 1, blobData.Size(), file) == blobData.Size();
+				validBlob = validBlob && impl::HashBytes(blobData.Data(), blobData.Size()) == header.dataHash;
+			}
+			if (!validBlob)
+				blobData.Clear();
+			std::fclose(file);
+		}
+	}
+
+	vk::PipelineCacheCreateInfo cacheInfo = {};
+	cacheInfo.initialDataSize = blobData.Size();
+	cacheInfo.pInitialData = blobData.Size() != 0 ? blobData.Data() : nullptr;
+
+	Create_Return returnVal = {};
+	returnVal.handle = device.Create(cacheInfo);
+	returnVal.loadedFromDisk = blobData.Size() != 0;
+	if (debugUtils) {
+		debugUtils->Helper_SetObjectName(
+			device.handle,
+			returnVal.handle,
+			"Main PipelineCache");
+	}
+	return returnVal;
+}
+
+bool PipelineCache::Save(
+	DeviceDispatch const& device,
+	PhysDeviceInfo const& physDevice,
+	vk::PipelineCache cache,
+	Std::Span<char const> path,
+	Std::AllocRef const& transientAlloc)
+{
+	if (path.Size() == 0)
+		return true;
+
+	uSize dataSize = 0;
+	auto vkResult = device.GetPipelineCacheData(cache, &dataSize, nullptr);
+	if (vkResult != vk::Result::eSuccess)
+		return false;
+	auto blobData = Std::NewVec<char>(transientAlloc);
+	blobData.Resize(dataSize);
+	vkResult = device.GetPipelineCacheData(cache, &dataSize, blobData.Data());
+	if (vkResult != vk::Result::eSuccess)
+		return false;
+
+	auto header = impl::BuildHeader(physDevice);
+	header.dataSize = dataSize;
+	header.dataHash = impl::HashBytes(blobData.Data(), dataSize);
+
+	// Write to a temporary file first, so that a crash while saving
+	// never leaves a truncated blob behind.
+	std::string const pathString = { path.Data(), path.Size() };
+	std::string const tempPathString = pathString + ".tmp";
+	std::FILE* file = std::fopen(tempPathString.c_str(), "wb");
+	if (!file)
+		return false;
+	bool success = std::fwrite(&header, sizeof(header), 1, file) == 1;
+	success = success && std::fwrite(blobData.Data(), 1, dataSize, file) == dataSize;
+	success = std::fclose(file) == 0 && success;
+	if (!success) {
+		std::remove(tempPathString.c_str());
+		return false;
+	}
+
+	// std::rename does not overwrite existing files on every platform.
+	std::remove(pathString.c_str());
+	return std::rename(tempPathString.c_str(), pathString.c_str()) == 0;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "VulkanIncluder.hpp"
+#include "DynamicDispatch.hpp"
+#include "PhysDeviceInfo.hpp"
+
+#include <DEngine/Gfx/Gfx.hpp>
+#include <DEngine/FixedWidthTypes.hpp>
+#include <DEngine/Std/Containers/AllocRef.hpp>
+#include <DEngine/Std/Containers/Span.hpp>
+
+// One pipeline cache is shared by every pipeline the backend creates.
+// Its contents are stored on disk between runs, wrapped in a small header
+// that ties the blob to the physical device and driver that produced it.
+// A blob from any other device or driver version is discarded.
+namespace DEngine::Gfx::Vk::PipelineCache
+{
+	// Bump this if the layout of the on-disk header changes.
+	constexpr u32 blobVersion = 1;
+
+	struct Create_Return {
+		vk::PipelineCache handle = {};
+		// True if the cache was seeded with a valid blob from disk.
+		bool loadedFromDisk = false;
+	};
+	// An empty path disables loading, the cache then starts out empty.
+	[[nodiscard]] Create_Return Create(
+		DeviceDispatch const& device,
+		PhysDeviceInfo const& physDevice,
+		Std::Span<char const> path,
+		Std::AllocRef const& transientAlloc,
+		DebugUtilsDispatch const* debugUtils);
+
+	// Writes the cache contents to disk. Returns false if this failed.
+	// An empty path is a no-op.
+	bool Save(
+		DeviceDispatch const& device,
+		PhysDeviceInfo const& physDevice,
+		vk::PipelineCache cache,
+		Std::Span<char const> path,
+		Std::AllocRef const& transientAlloc);
+}
@@ -0,0 +1,211 @@
+#include "SecondaryCmdRecorder.hpp"
+
+#include <DEngine/Gfx/impl/Assert.hpp>
+#include <DEngine/Std/Utility.hpp>
+
+#include <stdexcept>
+#include <string>
+
+#if defined(DENGINE_TRACY_LINKED)
+#include <tracy/Tracy.hpp>
+#endif
+
+using namespace DEngine;
+using namespace DEngine::Gfx;
+using namespace DEngine::Gfx::Vk;
+
+void SecondaryCmdRecorder::Init(
+	SecondaryCmdRecorder& recorder,
+	DeviceDispatch const& device,
+	u32 queueFamilyIndex,
+	int inFlightCount,
+	int workerCount,
+	DebugUtilsDispatch const* debugUtils)
+{
+	DENGINE_IMPL_GFX_ASSERT(workerCount >= 0 && workerCount <= maxWorkerCount);
+
+	recorder.device = &device;
+	recorder.perThread.resize(workerCount + 1);
+	for (int threadIndex = 0; threadIndex < (int)recorder.perThread.size(); threadIndex += 1) {
+		auto& threadData = recorder.perThread[threadIndex];
+		threadData.cmdPools.Resize(inFlightCount);
+		threadData.cmdBuffers.Resize(inFlightCount);
+		threadData.usedCmdBufferCounts.Resize(inFlightCount);
+		for (int i = 0; i < inFlightCount; i += 1) {
+			vk::CommandPoolCreateInfo cmdPoolInfo = {};
+			cmdPoolInfo.queueFamilyIndex = queueFamilyIndex;
+			auto cmdPool = device.Create(cmdPoolInfo);
+			if (cmdPool.result != vk::Result::eSuccess)
+				throw std::runtime_error("DEngine - Vulkan: Unable to make secondary command pool.");
+			threadData.cmdPools[i] = cmdPool.value;
+			threadData.usedCmdBufferCounts[i] = 0;
+			if (debugUtils) {
+				std::string name = "Secondary CmdPool - Thread #";
+				name += std::to_string(threadIndex);
+				name += " #";
+				name += std::to_string(i);
+				debugUtils->Helper_SetObjectName(device.handle, cmdPool.value, name.c_str());
+			}
+		}
+	}
+
+	for (int i = 0; i < workerCount; i += 1)
+		recorder.workers.push_back(std::thread(&WorkerEntryPoint, &recorder, i));
+}
+
+void SecondaryCmdRecorder::Destroy(
+	SecondaryCmdRecorder& recorder,
+	DeviceDispatch const& device)
+{
+	{
+		std::lock_guard lock{ recorder.lock };
+		recorder.shutdown = true;
+	}
+	recorder.workerCondVar.notify_all();
+	for (auto& worker : recorder.workers)
+		worker.join();
+	recorder.workers.clear();
+
+	// Destroying the pool frees its cmd buffers.
+	for (auto const& threadData : recorder.perThread) {
+		for (auto const& cmdPool : threadData.cmdPools)
+			device.Destroy(cmdPool);
+	}
+	recorder.perThread.clear();
+}
+
+void SecondaryCmdRecorder::BeginFrame(
+	SecondaryCmdRecorder& recorder,
+	DeviceDispatch const& device,
+	u8 inFlightIndex)
+{
+	// A worker that woke up late might still be looking at the previous Record call.
+	std::unique_lock lock{ recorder.lock };
+	recorder.doneCondVar.wait(lock, [&recorder]() { return recorder.activeWorkerCount == 0; });
+
+	for (auto& threadData : recorder.perThread) {
+		device.resetCommandPool(threadData.cmdPools[inFlightIndex]);
+		threadData.usedCmdBufferCounts[inFlightIndex] = 0;
+	}
+}
+
+void SecondaryCmdRecorder::Record(
+	SecondaryCmdRecorder& recorder,
+	DeviceDispatch const& device,
+	Std::Span<Job const> jobs,
+	RecordFnT const& recordFn,
+	u8 inFlightIndex,
+	Std::Span<vk::CommandBuffer> outCmdBuffers)
+{
+	DENGINE_IMPL_GFX_ASSERT(recorder.device == &device);
+	DENGINE_IMPL_GFX_ASSERT(jobs.Size() == outCmdBuffers.Size());
+	if (jobs.Size() == 0)
+		return;
+
+	{
+		std::unique_lock lock{ recorder.lock };
+		recorder.doneCondVar.wait(lock, [&recorder]() { return recorder.activeWorkerCount == 0; });
+		recorder.currJobs = jobs;
+		recorder.currRecordFn = &recordFn;
+		recorder.currOutCmdBuffers = outCmdBuffers;
+		recorder.currInFlightIndex = inFlightIndex;
+		recorder.nextJobIndex.store(0, std::memory_order_relaxed);
+		recorder.generation += 1;
+	}
+	// Waking the workers costs more than recording a single job.
+	if (jobs.Size() > 1)
+		recorder.workerCondVar.notify_all();
+
+	RecordJobs(recorder, (int)recorder.perThread.size() - 1);
+
+	// Every job has been claimed once we get here. The ones we didn't record
+	// ourselves are done once no worker is active anymore.
+	std::unique_lock lock{ recorder.lock };
+	recorder.doneCondVar.wait(lock, [&recorder]() { return recorder.activeWorkerCount == 0; });
+	recorder.currRecordFn = nullptr;
+}
+
+void SecondaryCmdRecorder::RecordJobs(SecondaryCmdRecorder& recorder, int threadIndex)
+{
+	auto const& device = *recorder.device;
+	auto& threadData = recorder.perThread[threadIndex];
+	auto const inFlightIndex = recorder.currInFlightIndex;
+	auto const cmdPool = threadData.cmdPools[inFlightIndex];
+	auto& cmdBuffers = threadData.cmdBuffers[inFlightIndex];
+	auto& usedCmdBufferCount = threadData.usedCmdBufferCounts[inFlightIndex];
+	auto const jobCount = (int)recorder.currJobs.Size();
+
+	while (true) {
+		auto const jobIndex = recorder.nextJobIndex.fetch_add(1, std::memory_order_relaxed);
+		if (jobIndex >= jobCount)
+			break;
+
+		if (usedCmdBufferCount == cmdBuffers.size()) {
+			vk::CommandBufferAllocateInfo allocInfo = {};
+			allocInfo.commandPool = cmdPool;
+			allocInfo.commandBufferCount = 1;
+			allocInfo.level = vk::CommandBufferLevel::eSecondary;
+			vk::CommandBuffer newCmdBuffer = {};
+			auto vkResult = device.allocateCommandBuffers(allocInfo, &newCmdBuffer);
+			if (vkResult != vk::Result::eSuccess)
+				throw std::runtime_error("DEngine - Vulkan: Failed to allocate secondary commandbuffer.");
+			cmdBuffers.push_back(newCmdBuffer);
+		}
+		auto const cmdBuffer = cmdBuffers[usedCmdBufferCount];
+		usedCmdBufferCount += 1;
+
+		auto const& job = recorder.currJobs[jobIndex];
+		vk::CommandBufferInheritanceInfo inheritInfo = {};
+		inheritInfo.renderPass = job.renderPass;
+		inheritInfo.subpass = 0;
+		inheritInfo.framebuffer = job.framebuffer;
+		vk::CommandBufferBeginInfo beginInfo = {};
+		beginInfo.flags =
+			vk::CommandBufferUsageFlagBits::eOneTimeSubmit |
+			vk::CommandBufferUsageFlagBits::eRenderPassContinue;
+		beginInfo.pInheritanceInfo = &inheritInfo;
+		device.beginCommandBuffer(cmdBuffer, beginInfo);
+
+		recorder.currRecordFn->Invoke(jobIndex, cmdBuffer);
+
+		device.endCommandBuffer(cmdBuffer);
+		recorder.currOutCmdBuffers[jobIndex] = cmdBuffer;
+	}
+}
+
+void SecondaryCmdRecorder::WorkerEntryPoint(SecondaryCmdRecorder* inRecorder, int threadIndex)
+{
+	std::string threadName = "CmdRecordThread #" + std::to_string(threadIndex);
+	Std::NameThisThread({ threadName.data(), threadName.size() });
+
+	auto& recorder = *inRecorder;
+	u64 seenGeneration = 0;
+	while (true) {
+		{
+			std::unique_lock lock{ recorder.lock };
+			recorder.workerCondVar.wait(
+				lock,
+				[&recorder, seenGeneration]() { return recorder.shutdown || recorder.generation != seenGeneration; });
+			if (recorder.shutdown)
+				break;
+			seenGeneration = recorder.generation;
+			recorder.activeWorkerCount += 1;
+		}
+
+		{
+#if defined(DENGINE_TRACY_LINKED)
+			ZoneScopedN("Record secondary cmd buffers");
+#endif
+			RecordJobs(recorder, threadIndex);
+		}
+
+		bool lastWorker = false;
+		{
+			std::lock_guard lock{ recorder.lock };
+			recorder.activeWorkerCount -= 1;
+			lastWorker = recorder.activeWorkerCount == 0;
+		}
+		if (lastWorker)
+			recorder.doneCondVar.notify_all();
+	}
+}
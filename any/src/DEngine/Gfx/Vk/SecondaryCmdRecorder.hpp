@@ -0,0 +1,110 @@
+#pragma once
+
+#include "Constants.hpp"
+#include "DynamicDispatch.hpp"
+#include "VulkanIncluder.hpp"
+
+#include <DEngine/FixedWidthTypes.hpp>
+#include <DEngine/Std/Containers/FnRef.hpp>
+#include <DEngine/Std/Containers/Span.hpp>
+#include <DEngine/Std/Containers/StackVec.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace DEngine::Gfx::Vk
+{
+	// Records secondary command buffers on a small set of worker threads.
+	// The thread calling Record takes part in the recording as well.
+	//
+	// Every recording thread has its own command pool per in-flight index,
+	// so no pool is ever touched by two threads. The cmd buffers are
+	// allocated on demand and reused every time the in-flight index comes around again.
+	struct SecondaryCmdRecorder
+	{
+		SecondaryCmdRecorder() = default;
+		SecondaryCmdRecorder(SecondaryCmdRecorder const&) = delete;
+		SecondaryCmdRecorder(SecondaryCmdRecorder&&) = delete;
+
+		// Upper limit on worker threads, on top of the thread calling Record.
+		static constexpr int maxWorkerCount = 7;
+
+		struct Job {
+			// The render pass and framebuffer the cmd buffer will be executed inside.
+			vk::RenderPass renderPass = {};
+			vk::Framebuffer framebuffer = {};
+		};
+
+		// Called with the job index and a cmd buffer that has already been begun
+		// inside the job's render pass. It must only record commands into it, and
+		// may be called from several threads at once.
+		using RecordFnT = Std::FnRef<void(int, vk::CommandBuffer)>;
+
+		// Records one secondary cmd buffer per job and writes them to outCmdBuffers, in job order.
+		// Blocks until every job has been recorded.
+		static void Record(
+			SecondaryCmdRecorder& recorder,
+			DeviceDispatch const& device,
+			Std::Span<Job const> jobs,
+			RecordFnT const& recordFn,
+			u8 inFlightIndex,
+			Std::Span<vk::CommandBuffer> outCmdBuffers);
+
+		// Resets the pools of this in-flight index. Has the same requirements as
+		// resetting the main command pool, the GPU must be done with them.
+		static void BeginFrame(
+			SecondaryCmdRecorder& recorder,
+			DeviceDispatch const& device,
+			u8 inFlightIndex);
+
+		// Worker count 0 records everything on the calling thread.
+		static void Init(
+			SecondaryCmdRecorder& recorder,
+			DeviceDispatch const& device,
+			u32 queueFamilyIndex,
+			int inFlightCount,
+			int workerCount,
+			DebugUtilsDispatch const* debugUtils);
+
+		// The GPU must be done with every cmd buffer.
+		static void Destroy(
+			SecondaryCmdRecorder& recorder,
+			DeviceDispatch const& device);
+
+		[[nodiscard]] int WorkerCount() const noexcept { return (int)workers.size(); }
+
+	private:
+		struct PerThread {
+			Std::StackVec<vk::CommandPool, Constants::maxInFlightCount> cmdPools;
+			// Every cmd buffer allocated from the pool of the same in-flight index.
+			Std::StackVec<std::vector<vk::CommandBuffer>, Constants::maxInFlightCount> cmdBuffers;
+			// How many of them have been handed out since the pool was last reset.
+			Std::StackVec<uSize, Constants::maxInFlightCount> usedCmdBufferCounts;
+		};
+		static void RecordJobs(SecondaryCmdRecorder& recorder, int threadIndex);
+		static void WorkerEntryPoint(SecondaryCmdRecorder* recorder, int threadIndex);
+
+		// One per worker, followed by the one for the thread calling Record.
+		std::vector<PerThread> perThread;
+		std::vector<std::thread> workers;
+		DeviceDispatch const* device = nullptr;
+
+		// Guards everything below, except the job counter.
+		// The current frame's state only changes while no worker is active.
+		std::mutex lock;
+		std::condition_variable workerCondVar;
+		std::condition_variable doneCondVar;
+		u64 generation = 0;
+		int activeWorkerCount = 0;
+		bool shutdown = false;
+
+		Std::Span<Job const> currJobs;
+		RecordFnT const* currRecordFn = nullptr;
+		Std::Span<vk::CommandBuffer> currOutCmdBuffers;
+		u8 currInFlightIndex = 0;
+		std::atomic<int> nextJobIndex = 0;
+	};
+}
@@ -0,0 +1,72 @@
+#include "ShaderBundle.hpp"
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+using namespace DEngine;
+using namespace DEngine::Gfx;
+using namespace DEngine::Gfx::Vk;
+
+namespace DEngine::Gfx::Vk::impl
+{
+	constexpr uSize shaderBundleHeaderSize = sizeof(u32) * 4;
+}
+
+void ShaderBundle::Load(ShaderBundle& bundle, char const* path)
+{
+	if (!bundle.file.Open(path))
+		throw std::runtime_error(std::string("DEngine - Vulkan: Could not open shader bundle '") + path + "'.");
+	auto const fileData = bundle.file.Data();
+	u64 const fileLength = fileData.Size();
+	if (fileLength < impl::shaderBundleHeaderSize || fileLength % sizeof(u32) != 0)
+		throw std::runtime_error("DEngine - Vulkan: Shader bundle is malformed.");
+	// The SPIR-V code is handed to Vulkan in place, which requires 4-byte alignment.
+	// Desktop mappings are page aligned, but on Android an uncompressed asset is read
+	// straight out of the APK, so this depends on the APK having been zipaligned.
+	if (reinterpret_cast<uSize>(fileData.Data()) % alignof(u32) != 0)
+		throw std::runtime_error("DEngine - Vulkan: Shader bundle is not mapped at an aligned address.");
+
+	auto const* words = bundle.Words();
+	if (words[0] != magic || words[1] != version)
+		throw std::runtime_error("DEngine - Vulkan: Shader bundle has the wrong magic or version. Rerun refresh_assets.");
+	bundle.entryCount = words[2];
+
+	// Validate the whole index up front, so lookups don't need to.
+	auto const entriesEnd = impl::shaderBundleHeaderSize + bundle.entryCount * sizeof(Entry);
+	if (entriesEnd > fileLength)
+		throw std::runtime_error("DEngine - Vulkan: Shader bundle is malformed.");
+	auto const* entries = reinterpret_cast<Entry const*>(words + 4);
+	for (uSize i = 0; i < bundle.entryCount; i += 1) {
+		auto const& entry = entries[i];
+		bool const valid =
+			(u64)entry.nameOffset + entry.nameLength <= fileLength &&
+			(u64)entry.codeOffset + entry.codeSize <= fileLength &&
+			entry.codeOffset % sizeof(u32) == 0 &&
+			entry.codeSize % sizeof(u32) == 0;
+		if (!valid)
+			throw std::runtime_error("DEngine - Vulkan: Shader bundle is malformed.");
+	}
+}
+
+Std::Span<u32 const> ShaderBundle::Get(char const* name) const
+{
+	auto const nameLength = std::strlen(name);
+	auto const* words = Words();
+	auto const* bytes = reinterpret_cast<char const*>(words);
+	auto const* entries = reinterpret_cast<Entry const*>(words + 4);
+	for (uSize i = 0; i < entryCount; i += 1) {
+		auto const& entry = entries[i];
+		if (entry.nameLength == nameLength && std::memcmp(bytes + entry.nameOffset, name, nameLength) == 0) {
+			return {
+				words + entry.codeOffset / sizeof(u32),
+				entry.codeSize / sizeof(u32) };
+		}
+	}
+	throw std::runtime_error(std::string("DEngine - Vulkan: Shader '") + name + "' is not in the shader bundle.");
+}
+
+u32 const* ShaderBundle::Words() const noexcept
+{
+	return reinterpret_cast<u32 const*>(file.Data().Data());
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <DEngine/Application.hpp>
+#include <DEngine/FixedWidthTypes.hpp>
+#include <DEngine/Std/Containers/Span.hpp>
+
+namespace DEngine::Gfx::Vk
+{
+	// All the compiled SPIR-V shaders, packed into a single indexed file by the
+	// refresh_assets tool. The file is memory mapped and the shader modules
+	// are created straight from the mapping.
+	//
+	// File layout, all little endian u32s:
+	//	Header: magic, version, entryCount, reserved
+	//	Entries: nameOffset, nameLength, codeOffset, codeSize
+	//	Names, then the shader code.
+	// Offsets are in bytes from the start of the file. Code offsets are aligned to 4 bytes.
+	// Names are the shader paths relative to the data directory, using '/' as separator.
+	class ShaderBundle
+	{
+	public:
+		static constexpr u32 magic = 0x56505344; // "DSPV" in little endian
+		static constexpr u32 version = 1;
+		static constexpr char const* defaultPath = "data/shaders.bundle";
+
+		// Throws if the file can't be opened or is malformed.
+		static void Load(ShaderBundle& bundle, char const* path);
+
+		// Throws if the bundle has no shader with this name.
+		[[nodiscard]] Std::Span<u32 const> Get(char const* name) const;
+
+		[[nodiscard]] uSize EntryCount() const noexcept { return entryCount; }
+
+	private:
+		struct Entry {
+			u32 nameOffset;
+			u32 nameLength;
+			u32 codeOffset;
+			u32 codeSize;
+		};
+
+		[[nodiscard]] u32 const* Words() const noexcept;
+
+		App::MappedFile file;
+		uSize entryCount = 0;
+	};
+}
@@ -0,0 +1,54 @@
+#include "ShelfPacker.hpp"
+
+using namespace DEngine;
+using namespace DEngine::Gfx;
+using namespace DEngine::Gfx::Vk;
+
+ShelfPacker::ShelfPacker(u32 width, u32 height, u32 padding) noexcept :
+	width{ width },
+	height{ height },
+	padding{ padding }
+{
+}
+
+Std::Opt<ShelfPacker::Rect> ShelfPacker::Insert(u32 inWidth, u32 inHeight)
+{
+	auto const paddedWidth = inWidth + padding;
+	auto const paddedHeight = inHeight + padding;
+	if (paddedWidth > width || paddedHeight > height)
+		return Std::nullOpt;
+
+	// Find the shelf that wastes the least vertical space.
+	Shelf* bestShelf = nullptr;
+	for (auto& shelf : shelves) {
+		if (shelf.height < paddedHeight || width - shelf.usedWidth < paddedWidth)
+			continue;
+		if (bestShelf == nullptr || shelf.height < bestShelf->height)
+			bestShelf = &shelf;
+	}
+
+	if (bestShelf == nullptr) {
+		if (height - nextShelfY < paddedHeight)
+			return Std::nullOpt;
+		Shelf newShelf = {};
+		newShelf.y = nextShelfY;
+		newShelf.height = paddedHeight;
+		shelves.push_back(newShelf);
+		nextShelfY += paddedHeight;
+		bestShelf = &shelves.back();
+	}
+
+	Rect returnVal = {};
+	returnVal.x = bestShelf->usedWidth;
+	returnVal.y = bestShelf->y;
+	returnVal.width = inWidth;
+	returnVal.height = inHeight;
+	bestShelf->usedWidth += paddedWidth;
+	return returnVal;
+}
+
+void ShelfPacker::Reset() noexcept
+{
+	shelves.clear();
+	nextShelfY = 0;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <DEngine/FixedWidthTypes.hpp>
+#include <DEngine/Std/Containers/Opt.hpp>
+
+#include <vector>
+
+namespace DEngine::Gfx::Vk
+{
+	// Packs rectangles into a fixed size area by stacking horizontal shelves.
+	// A rectangle goes onto the shortest existing shelf it fits on, otherwise
+	// a new shelf is opened below the last one.
+	//
+	// This has no Vulkan dependencies so it can be exercised on the CPU alone.
+	class ShelfPacker
+	{
+	public:
+		struct Rect {
+			u32 x = 0;
+			u32 y = 0;
+			u32 width = 0;
+			u32 height = 0;
+		};
+
+		ShelfPacker() = default;
+		// Padding is the amount of empty texels kept to the right of and below every rectangle,
+		// so that sampling one rectangle never bleeds into its neighbours.
+		ShelfPacker(u32 width, u32 height, u32 padding = 1) noexcept;
+
+		// Returns nullOpt if the rectangle does not fit anywhere.
+		[[nodiscard]] Std::Opt<Rect> Insert(u32 width, u32 height);
+
+		// Removes all rectangles.
+		void Reset() noexcept;
+
+		[[nodiscard]] u32 Width() const noexcept { return width; }
+		[[nodiscard]] u32 Height() const noexcept { return height; }
+		// The amount of vertical space claimed by shelves so far.
+		[[nodiscard]] u32 UsedHeight() const noexcept { return nextShelfY; }
+
+	private:
+		struct Shelf {
+			u32 y = 0;
+			u32 height = 0;
+			u32 usedWidth = 0;
+		};
+		std::vector<Shelf> shelves;
+		u32 nextShelfY = 0;
+		u32 width = 0;
+		u32 height = 0;
+		u32 padding = 0;
+	};
+}
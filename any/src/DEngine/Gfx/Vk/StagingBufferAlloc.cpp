@@ -1,9 +1,52 @@
 #include "StagingBufferAlloc.hpp"
 
+#include <DEngine/Gfx/impl/Assert.hpp>
 #include <DEngine/Math/Common.hpp>
 
+#include <stdexcept>
+
+using namespace DEngine;
 using namespace DEngine::Gfx::Vk;
 
+auto StagingBufferAlloc::CreateBlock(VmaAllocator vma, uSize capacity) -> Block
+{
+	vk::BufferCreateInfo bufferInfo = {};
+	bufferInfo.size = capacity;
+	bufferInfo.sharingMode = vk::SharingMode::eExclusive;
+	bufferInfo.usage = vk::BufferUsageFlagBits::eTransferSrc;
+	VmaAllocationCreateInfo allocInfo = {};
+	allocInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
+	allocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+	Block block = {};
+	auto vkResult = (vk::Result)vmaCreateBuffer(
+		vma,
+		(VkBufferCreateInfo const*)&bufferInfo,
+		&allocInfo,
+		(VkBuffer*)&block.bufferHandle,
+		&block.vmaAlloc,
+		&block.vmaAllocResultInfo);
+	if (vkResult != vk::Result::eSuccess) {
+		throw std::runtime_error("DEngine - Vulkan: VMA was unable to allocate staging buffer.");
+	}
+
+	block.capacity = capacity;
+	block.mappedMemory = { (char*)block.vmaAllocResultInfo.pMappedData, capacity };
+	return block;
+}
+
+auto StagingBufferAlloc::AllocFromBlock(Block const& block, uSize offset, int size) -> Alloc_Return
+{
+	Alloc_Return out = {};
+	out.buffer = block.bufferHandle;
+	out.bufferOffset = (int)offset;
+	out.bufferSize = size;
+	out.mappedMem = block.mappedMemory.Subspan(offset, size);
+	out.memory = block.vmaAllocResultInfo.deviceMemory;
+	out.memoryOffset = (int)block.vmaAllocResultInfo.offset;
+	return out;
+}
+
 auto StagingBufferAlloc::Alloc_Internal(
 	StagingBufferAlloc& alloc,
 	DeviceDispatch const& device,
@@ -11,60 +54,112 @@ auto StagingBufferAlloc::Alloc_Internal(
 	int align)
 	-> Alloc_Return
 {
-	auto tempOffset = Math::CeilToMultiple((u32)alloc.nextOffset, (u32)align);
-
-	if (tempOffset + size <= alloc.capacity) {
-		// Allocate stuff
+	DENGINE_IMPL_GFX_ASSERT(size >= 0 && align > 0);
 
-		Alloc_Return out = {};
-		out.buffer = alloc.bufferHandle;
-		out.bufferOffset = (int)tempOffset;
-		out.bufferSize = (int)size;
-		out.mappedMem = alloc.mappedMemory.Subspan(tempOffset, size);
-		out.memory = alloc.vmaAllocResultInfo.deviceMemory;
-		out.memoryOffset = (int)alloc.vmaAllocResultInfo.offset;
+	// Try the ring first. An allocation never straddles the end of the ring,
+	// if it doesn't fit before the end we skip ahead to the start.
+	auto const ringCapacity = alloc.ring.capacity;
+	auto const headPos = (uSize)(alloc.ringHead % ringCapacity);
+	uSize offset = Math::CeilToMultiple((u32)headPos, (u32)align);
+	u64 newHead = alloc.ringHead + (offset - headPos) + size;
+	if (offset + size > ringCapacity) {
+		offset = 0;
+		newHead = alloc.ringHead + (ringCapacity - headPos) + size;
+	}
+	if (newHead - alloc.ringTail <= ringCapacity) {
+		alloc.ringHead = newHead;
+		return AllocFromBlock(alloc.ring, offset, size);
+	}
 
-		alloc.nextOffset = tempOffset + size;
-		return out;
+	// The ring is full, fall back to an overflow block.
+	alloc.frameOverflowSize += size;
+	for (auto& block : alloc.overflowBlocks) {
+		if (block.ownerInFlightIndex != -1 && block.ownerInFlightIndex != alloc.currInFlightIndex)
+			continue;
+		uSize const blockOffset = Math::CeilToMultiple((u32)block.nextOffset, (u32)align);
+		if (blockOffset + size > block.capacity)
+			continue;
+		block.ownerInFlightIndex = alloc.currInFlightIndex;
+		block.lastUsedFrame = alloc.frameCount;
+		block.nextOffset = blockOffset + size;
+		return AllocFromBlock(block, blockOffset, size);
 	}
 
-	DENGINE_IMPL_GFX_UNREACHABLE();
+	auto const blockCapacity = Math::Max(
+		(uSize)overflowBlockMinCapacity,
+		(uSize)Math::CeilToMultiple((u32)size, (u32)overflowBlockMinCapacity));
+	auto& newBlock = alloc.overflowBlocks.emplace_back(CreateBlock(alloc.vma, blockCapacity));
+	newBlock.ownerInFlightIndex = alloc.currInFlightIndex;
+	newBlock.lastUsedFrame = alloc.frameCount;
+	newBlock.nextOffset = size;
+	alloc.stats.overflowBlockCount += 1;
+	alloc.stats.overflowBlocksCapacity += blockCapacity;
+	return AllocFromBlock(newBlock, 0, size);
 }
 
 void StagingBufferAlloc::BuildInPlace(
 	StagingBufferAlloc& alloc,
 	DeviceDispatch const& device,
-	VmaAllocator vma)
+	VmaAllocator vma,
+	int inFlightCount)
 {
-	vk::BufferCreateInfo bufferInfo = {};
-	bufferInfo.size = StagingBufferAlloc::minCapacity;
-	bufferInfo.sharingMode = vk::SharingMode::eExclusive;
-	bufferInfo.usage = vk::BufferUsageFlagBits::eTransferSrc;
-	VmaAllocationCreateInfo allocInfo = {};
-	allocInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
-	allocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+	alloc.vma = vma;
+	alloc.ring = CreateBlock(vma, ringCapacity);
+	alloc.frameRingEnds.resize(inFlightCount, 0);
+}
 
-	vk::Buffer bufferOut = {};
-	VmaAllocation vmaAllocation = {};
-	VmaAllocationInfo vmaResultInfo = {};
-	auto vkResult = (vk::Result)vmaCreateBuffer(
-		vma,
-		(VkBufferCreateInfo const*)&bufferInfo,
-		&allocInfo,
-		(VkBuffer*)&bufferOut,
-		&vmaAllocation,
-		&vmaResultInfo);
-	if (vkResult != vk::Result::eSuccess) {
-		throw std::runtime_error("");
+void StagingBufferAlloc::BeginFrame(StagingBufferAlloc& alloc, int inFlightIndex)
+{
+	DENGINE_IMPL_GFX_ASSERT(inFlightIndex >= 0 && inFlightIndex < (int)alloc.frameRingEnds.size());
+
+	// Wrap up the previous frame.
+	if (alloc.frameCount != 0) {
+		auto const frameSize = (uSize)(alloc.ringHead - alloc.frameRingStart) + alloc.frameOverflowSize;
+		alloc.stats.lastFrameSize = frameSize;
+		alloc.stats.highWaterMark = Math::Max(alloc.stats.highWaterMark, frameSize);
+		if (alloc.frameOverflowSize != 0)
+			alloc.stats.overflowFrameCount += 1;
+		alloc.frameRingEnds[alloc.currInFlightIndex] = alloc.ringHead;
 	}
+	alloc.frameCount += 1;
+	alloc.currInFlightIndex = inFlightIndex;
+	alloc.frameRingStart = alloc.ringHead;
+	alloc.frameOverflowSize = 0;
+
+	// Frames finish in order, so everything up to where this in-flight index
+	// ended its last frame can be reused.
+	alloc.ringTail = Math::Max(alloc.ringTail, alloc.frameRingEnds[inFlightIndex]);
 
-	alloc.bufferHandle = bufferOut;
-	alloc.capacity = bufferInfo.size;
-	alloc.vmaAlloc = vmaAllocation;
-	alloc.vmaAllocResultInfo = vmaResultInfo;
-	alloc.mappedMemory = { (char*)vmaResultInfo.pMappedData, bufferInfo.size };
+	for (auto& block : alloc.overflowBlocks) {
+		if (block.ownerInFlightIndex == inFlightIndex) {
+			block.ownerInFlightIndex = -1;
+			block.nextOffset = 0;
+		}
+	}
+
+	// Trim overflow blocks that have been free for a while.
+	for (uSize i = 0; i < alloc.overflowBlocks.size();) {
+		auto const& block = alloc.overflowBlocks[i];
+		bool const trim =
+			block.ownerInFlightIndex == -1 &&
+			alloc.frameCount - block.lastUsedFrame > overflowTrimFrameCount;
+		if (trim) {
+			alloc.stats.overflowBlockCount -= 1;
+			alloc.stats.overflowBlocksCapacity -= block.capacity;
+			vmaDestroyBuffer(alloc.vma, (VkBuffer)block.bufferHandle, block.vmaAlloc);
+			alloc.overflowBlocks.erase(alloc.overflowBlocks.begin() + i);
+		}
+		else
+			i += 1;
+	}
 }
 
-void StagingBufferAlloc::Reset(StagingBufferAlloc& alloc) {
-	alloc.nextOffset = 0;
-}
\ No newline at end of file
+void StagingBufferAlloc::Destroy(StagingBufferAlloc& alloc)
+{
+	for (auto const& block : alloc.overflowBlocks)
+		vmaDestroyBuffer(alloc.vma, (VkBuffer)block.bufferHandle, block.vmaAlloc);
+	alloc.overflowBlocks.clear();
+	if (alloc.ring.bufferHandle)
+		vmaDestroyBuffer(alloc.vma, (VkBuffer)alloc.ring.bufferHandle, alloc.ring.vmaAlloc);
+	alloc.ring = {};
+}
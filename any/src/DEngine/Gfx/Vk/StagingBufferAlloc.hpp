@@ -6,14 +6,26 @@
 
 #include <DEngine/Std/Containers/Span.hpp>
 
+#include <vector>
+
 namespace DEngine::Gfx::Vk {
+	// A persistently mapped ring buffer shared by all in-flight frames.
+	// A frame's allocations are released when the same in-flight index comes around again,
+	// at which point the GPU is known to be done with them.
+	//
+	// If a frame needs more than the ring has free, the rest is served from
+	// overflow blocks. These are reused by later frames and destroyed once
+	// they have gone unused for a while.
 	struct StagingBufferAlloc {
 
 		StagingBufferAlloc() = default;
 		StagingBufferAlloc(StagingBufferAlloc&&) = delete;
 		StagingBufferAlloc(StagingBufferAlloc const&) = delete;
 
-		static constexpr int minCapacity = 1024 * 1024 * 4;
+		static constexpr int ringCapacity = 1024 * 1024 * 8;
+		static constexpr int overflowBlockMinCapacity = 1024 * 1024 * 4;
+		// Free overflow blocks are destroyed after going unused for this many frames.
+		static constexpr int overflowTrimFrameCount = 300;
 
 		struct Alloc_Return {
 			vk::Buffer buffer = {};
@@ -34,12 +46,30 @@ namespace DEngine::Gfx::Vk {
 			return Alloc_Internal(*this, device, size, align);
 		}
 
+		// Meant for tuning the ring capacity. All sizes are in bytes.
+		struct Stats {
+			// The most staging memory used by a single frame.
+			uSize highWaterMark = 0;
+			uSize lastFrameSize = 0;
+			// The amount of frames that did not fit in the ring.
+			u64 overflowFrameCount = 0;
+			int overflowBlockCount = 0;
+			uSize overflowBlocksCapacity = 0;
+		};
+		[[nodiscard]] Stats const& GetStats() const { return stats; }
+
 		static void BuildInPlace(
 			StagingBufferAlloc& alloc,
 			DeviceDispatch const& device,
-			VmaAllocator vma);
+			VmaAllocator vma,
+			int inFlightCount);
+
+		// Call at the start of every frame, before allocating anything.
+		// The GPU must be done with the previous frame that had this in-flight index.
+		static void BeginFrame(StagingBufferAlloc& alloc, int inFlightIndex);
 
-		static void Reset(StagingBufferAlloc& alloc);
+		// The GPU must be done with every frame.
+		static void Destroy(StagingBufferAlloc& alloc);
 
 	private:
 		[[nodiscard]] static Alloc_Return Alloc_Internal(
@@ -48,12 +78,34 @@ namespace DEngine::Gfx::Vk {
 			int size,
 			int align);
 
-		vk::Buffer bufferHandle = {};
-		VmaAllocation vmaAlloc = {};
-		VmaAllocationInfo vmaAllocResultInfo = {};
-		Std::ByteSpan mappedMemory = {};
-		uSize nextOffset = 0;
-		uSize capacity = 0;
+		struct Block {
+			vk::Buffer bufferHandle = {};
+			VmaAllocation vmaAlloc = {};
+			VmaAllocationInfo vmaAllocResultInfo = {};
+			Std::ByteSpan mappedMemory = {};
+			uSize nextOffset = 0;
+			uSize capacity = 0;
+			// The in-flight index whose allocations live in this block, -1 if it's free.
+			int ownerInFlightIndex = -1;
+			u64 lastUsedFrame = 0;
+		};
+		[[nodiscard]] static Block CreateBlock(VmaAllocator vma, uSize capacity);
+		[[nodiscard]] static Alloc_Return AllocFromBlock(Block const& block, uSize offset, int size);
+
+		VmaAllocator vma = {};
+		Block ring = {};
+		// These only ever grow, the position in the ring is the value modulo the capacity.
+		// Everything between the tail and the head may still be in use by the GPU.
+		u64 ringHead = 0;
+		u64 ringTail = 0;
+		// Where the ring head was when each in-flight index last ended its frame.
+		std::vector<u64> frameRingEnds;
+		std::vector<Block> overflowBlocks;
+
+		int currInFlightIndex = 0;
+		u64 frameCount = 0;
+		u64 frameRingStart = 0;
+		uSize frameOverflowSize = 0;
+		Stats stats = {};
 	};
 }
-
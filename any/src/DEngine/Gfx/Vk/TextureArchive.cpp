@@ -0,0 +1,75 @@
+#include "TextureArchive.hpp"
+
+#include <cstring>
+
+using namespace DEngine;
+using namespace DEngine::Gfx;
+using namespace DEngine::Gfx::Vk;
+
+namespace DEngine::Gfx::Vk::impl
+{
+	constexpr uSize textureArchiveHeaderSize = sizeof(u32) * 4;
+}
+
+bool TextureArchive::Load(TextureArchive& archive, char const* path)
+{
+	archive.entryCount = 0;
+	if (!archive.file.Open(path))
+		return false;
+	auto const fileData = archive.file.Data();
+	u64 const fileLength = fileData.Size();
+
+	bool valid =
+		fileLength >= impl::textureArchiveHeaderSize &&
+		reinterpret_cast<uSize>(fileData.Data()) % alignof(Entry) == 0;
+	u32 header[4] = {};
+	if (valid) {
+		std::memcpy(header, fileData.Data(), sizeof(header));
+		valid = header[0] == magic && header[1] == version;
+	}
+	valid = valid && impl::textureArchiveHeaderSize + (u64)header[2] * sizeof(Entry) <= fileLength;
+	if (valid) {
+		// Validate the whole index up front, so lookups don't need to.
+		auto const* entries = reinterpret_cast<Entry const*>(fileData.Data() + impl::textureArchiveHeaderSize);
+		for (uSize i = 0; i < header[2] && valid; i += 1) {
+			auto const& entry = entries[i];
+			valid =
+				entry.dataOffset <= fileLength &&
+				entry.dataSize <= fileLength - entry.dataOffset &&
+				(i == 0 || entries[i - 1].id < entry.id);
+		}
+	}
+	if (!valid) {
+		archive.file.Close();
+		return false;
+	}
+
+	archive.entryCount = header[2];
+	return true;
+}
+
+Std::Opt<Std::Span<std::byte const>> TextureArchive::Find(TextureID id) const noexcept
+{
+	auto const* entries = Entries();
+	uSize first = 0;
+	uSize last = entryCount;
+	while (first < last) {
+		uSize const middle = first + (last - first) / 2;
+		auto const& entry = entries[middle];
+		if (entry.id == (u64)id) {
+			return Std::Span<std::byte const>{
+				file.Data().Data() + entry.dataOffset,
+				(uSize)entry.dataSize };
+		}
+		if (entry.id < (u64)id)
+			first = middle + 1;
+		else
+			last = middle;
+	}
+	return Std::nullOpt;
+}
+
+TextureArchive::Entry const* TextureArchive::Entries() const noexcept
+{
+	return reinterpret_cast<Entry const*>(file.Data().Data() + impl::textureArchiveHeaderSize);
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <DEngine/Application.hpp>
+#include <DEngine/FixedWidthTypes.hpp>
+#include <DEngine/Gfx/Gfx.hpp>
+#include <DEngine/Std/Containers/Opt.hpp>
+#include <DEngine/Std/Containers/Span.hpp>
+
+namespace DEngine::Gfx::Vk
+{
+	// Every texture file listed in the texture manifest, packed into a single
+	// indexed file by the refresh_assets tool. The file is memory mapped, and a
+	// texture is resolved with a binary search on its TextureID.
+	//
+	// File layout, all little endian:
+	//	Header: u32 magic, u32 version, u32 entryCount, u32 reserved
+	//	Entries, sorted by id: u64 id, u64 dataOffset, u64 dataSize
+	//	The texture files.
+	// Offsets are in bytes from the start of the file.
+	class TextureArchive
+	{
+	public:
+		static constexpr u32 magic = 0x41585444; // "DTXA" in little endian
+		static constexpr u32 version = 1;
+
+		// Returns false if the file can't be opened or is malformed.
+		// The archive is then left empty.
+		static bool Load(TextureArchive& archive, char const* path);
+
+		// Returns nullOpt if the archive has no texture with this id.
+		[[nodiscard]] Std::Opt<Std::Span<std::byte const>> Find(TextureID id) const noexcept;
+
+		[[nodiscard]] uSize EntryCount() const noexcept { return entryCount; }
+
+	private:
+		struct Entry {
+			u64 id;
+			u64 dataOffset;
+			u64 dataSize;
+		};
+		[[nodiscard]] Entry const* Entries() const noexcept;
+
+		App::MappedFile file;
+		uSize entryCount = 0;
+	};
+}
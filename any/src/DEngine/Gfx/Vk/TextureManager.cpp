@@ -2,44 +2,446 @@
 
 #include "GlobUtils.hpp"
 #include "DeletionQueue.hpp"
+#include "TextureArchive.hpp"
 
+#include <DEngine/Gfx/impl/Assert.hpp>
 #include <DEngine/Std/Containers/Vec.hpp>
+#include <DEngine/Std/Utility.hpp>
 
 #include <Texas/Texas.hpp>
 #include <Texas/Tools.hpp>
 #include <Texas/VkTools.hpp>
 #include <DEngine/Application.hpp>
 
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
 using namespace DEngine;
 using namespace DEngine::Gfx;
 using namespace DEngine::Gfx::Vk;
 
 namespace DEngine::Gfx::Vk
 {
-	struct TextureFileStream : public Texas::InputStream
+	// Serves Texas straight out of a mapped file, so reading and seeking
+	// are plain memory operations instead of a syscall each.
+	struct TextureMemoryStream : public Texas::InputStream
 	{
-		App::FileInputStream stream;
+		Std::Span<std::byte const> data;
+		uSize pos = 0;
 		virtual Texas::Result read(Texas::ByteSpan dst) noexcept override
 		{
-			bool result = stream.Read((char*)dst.data(), dst.size());
-			if (result)
-				return Texas::successResult;
-			else
+			if (pos > data.Size() || dst.size() > data.Size() - pos)
 				return Texas::Result{ Texas::ResultType::UnknownError, "Error when reading file." };
+			std::memcpy(dst.data(), data.Data() + pos, dst.size());
+			pos += dst.size();
+			return Texas::successResult;
 		}
 		virtual void ignore(std::size_t amount) noexcept override
 		{
-			stream.Seek(amount, App::FileInputStream::SeekOrigin::Current);
+			pos += amount;
 		}
 		virtual std::size_t tell() noexcept override
 		{
-			return (uSize)stream.Tell().Value();
+			return pos;
 		}
-		virtual void seek(std::size_t pos) noexcept override
+		virtual void seek(std::size_t newPos) noexcept override
 		{
-			stream.Seek(pos, App::FileInputStream::SeekOrigin::Start);
+			pos = newPos;
 		}
 	};
+
+	struct TextureLoadRequest
+	{
+		TextureID id = TextureID::Invalid;
+		// Points into the texture archive if the texture is packed in it.
+		// Otherwise the texture is loaded from the path.
+		Std::Opt<Std::Span<std::byte const>> archiveData;
+		std::string path;
+	};
+
+	struct DecodedTexture
+	{
+		TextureID id = TextureID::Invalid;
+		// Empty if the texture was loaded successfully.
+		std::string errorMessage;
+		Texas::TextureInfo textureInfo = {};
+		std::vector<std::byte> imageData;
+	};
+
+	struct TextureLoader
+	{
+		std::vector<std::thread> threads;
+
+		// Loaded before the threads start and never modified afterwards,
+		// so it can be read without holding the lock.
+		TextureArchive archive;
+
+		std::mutex lock;
+		std::condition_variable condVar;
+		bool shutdown = false;
+		std::deque<TextureLoadRequest> requests;
+		// Decoded textures that the rendering thread has not picked up yet.
+		std::vector<DecodedTexture> finished;
+
+		// Only accessed by the rendering thread.
+		// Decoded textures that did not fit in the upload budget of their frame.
+		std::vector<DecodedTexture> pendingUploads;
+	};
+
+	struct TextureUploadInfo
+	{
+		// Only used for naming the objects.
+		Std::Span<char const> debugName;
+		vk::ImageType imageType = {};
+		vk::ImageViewType viewType = {};
+		vk::Format format = {};
+		vk::Extent3D extent = {};
+		u32 mipCount = 0;
+		u32 layerCount = 0;
+		Std::Span<std::byte const> data;
+		// The buffer offsets are relative to the start of data.
+		Std::Span<vk::BufferImageCopy const> regions;
+	};
+}
+
+namespace DEngine::Gfx::Vk::impl
+{
+	[[nodiscard]] static DecodedTexture DecodeTexture(TextureLoadRequest const& request)
+	{
+		DecodedTexture returnVal = {};
+		returnVal.id = request.id;
+
+		App::MappedFile file;
+		TextureMemoryStream fileStream{};
+		if (request.archiveData.HasValue()) {
+			fileStream.data = request.archiveData.Value();
+		}
+		else {
+			if (!file.Open(request.path.c_str())) {
+				returnVal.errorMessage = "DEngine - Vulkan: Could not open texture file '" + request.path + "'.";
+				return returnVal;
+			}
+			fileStream.data = file.Data();
+		}
+
+		auto parseResult = Texas::parseStream(fileStream);
+		if (!parseResult.isSuccessful()) {
+			if (request.archiveData.HasValue())
+				returnVal.errorMessage = "DEngine - Vulkan: Could not parse texture #" + std::to_string((u64)request.id) + " in the texture archive.";
+			else
+				returnVal.errorMessage = "DEngine - Vulkan: Could not parse texture file '" + request.path + "'.";
+			return returnVal;
+		}
+		auto& texFileInfo = parseResult.value();
+
+		returnVal.imageData.resize((uSize)texFileInfo.memoryRequired());
+		std::vector<std::byte> workingMemory((uSize)texFileInfo.workingMemoryRequired());
+		Texas::ByteSpan dstImageDataSpan = {
+			returnVal.imageData.data(),
+			returnVal.imageData.size() };
+		Texas::ByteSpan workingMemSpan = {
+			workingMemory.data(),
+			workingMemory.size() };
+		auto loadImageDataResult = Texas::loadImageData(
+			fileStream,
+			texFileInfo,
+			dstImageDataSpan,
+			workingMemSpan);
+		if (!loadImageDataResult.isSuccessful()) {
+			returnVal.errorMessage = "DEngine - Vulkan: Texas was unable to load image-data. Detailed error: ";
+			returnVal.errorMessage += loadImageDataResult.errorMessage();
+			returnVal.imageData.clear();
+			return returnVal;
+		}
+
+		returnVal.textureInfo = texFileInfo.textureInfo();
+		return returnVal;
+	}
+
+	static void TextureLoaderEntryPoint(TextureLoader* loaderPtr, uSize threadIndex)
+	{
+		std::string name = "TextureLoader #" + std::to_string(threadIndex);
+		Std::NameThisThread({ name.data(), name.size() });
+
+		auto& loader = *loaderPtr;
+		while (true) {
+			TextureLoadRequest request = {};
+			{
+				std::unique_lock lock{ loader.lock };
+				loader.condVar.wait(
+					lock,
+					[&loader]() { return loader.shutdown || !loader.requests.empty(); });
+				if (loader.shutdown)
+					break;
+				request = Std::Move(loader.requests.front());
+				loader.requests.pop_front();
+			}
+
+			auto decoded = DecodeTexture(request);
+
+			std::scoped_lock lock{ loader.lock };
+			loader.finished.push_back(Std::Move(decoded));
+		}
+	}
+
+	// Records the upload of the image-data and creates the image, view and descriptor set.
+	[[nodiscard]] static TextureManager::Inner UploadTexture(
+		TextureManager const& manager,
+		GlobUtils const& globUtils,
+		StagingBufferAlloc& stagingBufferAlloc,
+		vk::CommandBuffer cmdBuffer,
+		TextureUploadInfo const& uploadInfo,
+		Std::AllocRef const& transientAlloc)
+	{
+		auto const* debugUtils = globUtils.DebugUtilsPtr();
+		auto const& device = globUtils.device;
+
+		vk::Result vkResult = {};
+
+		TextureManager::Inner newInner{};
+
+		// Copy the image-data onto the staging buffer.
+		auto stagingBuffer = stagingBufferAlloc.Alloc(
+			device,
+			(int)uploadInfo.data.Size(),
+			4);
+		std::memcpy(stagingBuffer.mappedMem.Data(), uploadInfo.data.Data(), uploadInfo.data.Size());
+
+		vk::ImageCreateInfo imgInfo{};
+		imgInfo.arrayLayers = uploadInfo.layerCount;
+		imgInfo.extent = uploadInfo.extent;
+		imgInfo.format = uploadInfo.format;
+		imgInfo.imageType = uploadInfo.imageType;
+		imgInfo.initialLayout = vk::ImageLayout::eUndefined;
+		imgInfo.mipLevels = uploadInfo.mipCount;
+		imgInfo.samples = vk::SampleCountFlagBits::e1;
+		imgInfo.sharingMode = vk::SharingMode::eExclusive;
+		imgInfo.tiling = vk::ImageTiling::eOptimal;
+		imgInfo.usage = vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eTransferDst;
+		VmaAllocationCreateInfo imgVmaAllocInfo{};
+		imgVmaAllocInfo.usage = VmaMemoryUsage::VMA_MEMORY_USAGE_GPU_ONLY;
+		vkResult = (vk::Result)vmaCreateImage(
+			globUtils.vma,
+			(VkImageCreateInfo const*)&imgInfo,
+			&imgVmaAllocInfo,
+			(VkImage*)&newInner.img,
+			&newInner.imgVmaAlloc,
+			nullptr);
+		if (vkResult != vk::Result::eSuccess)
+			throw std::runtime_error("DEngine - Vulkan: VMA was unable to allocate image.");
+		if (debugUtils) {
+			std::string name = "TextureManager - ";
+			name.append(uploadInfo.debugName.Data(), uploadInfo.debugName.Size());
+			name += " - Img";
+			debugUtils->Helper_SetObjectName(
+				device.handle,
+				newInner.img,
+				name.c_str());
+		}
+
+
+		vk::BufferMemoryBarrier buffBarrier{};
+		buffBarrier.buffer = stagingBuffer.buffer;
+		buffBarrier.offset = stagingBuffer.BufferOffset();
+		buffBarrier.size = stagingBuffer.BufferSize();
+		buffBarrier.srcAccessMask = {};
+		buffBarrier.dstAccessMask = vk::AccessFlagBits::eTransferRead;
+		vk::ImageMemoryBarrier imgBarrierA{};
+		imgBarrierA.image = newInner.img;
+		imgBarrierA.oldLayout = vk::ImageLayout::eUndefined;
+		imgBarrierA.newLayout = vk::ImageLayout::eTransferDstOptimal;
+		imgBarrierA.srcAccessMask = {};
+		imgBarrierA.dstAccessMask = vk::AccessFlagBits::eTransferWrite;
+		imgBarrierA.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eColor;
+		imgBarrierA.subresourceRange.layerCount = imgInfo.arrayLayers;
+		imgBarrierA.subresourceRange.levelCount = imgInfo.mipLevels;
+		device.cmdPipelineBarrier(
+			cmdBuffer,
+			vk::PipelineStageFlagBits::eTopOfPipe,
+			vk::PipelineStageFlagBits::eTransfer,
+			vk::DependencyFlagBits::eByRegion,
+			{},
+			buffBarrier,
+			imgBarrierA);
+
+		auto buffImgCopies = Std::NewVec<vk::BufferImageCopy>(transientAlloc);
+		for (auto buffImgCopy : uploadInfo.regions) {
+			buffImgCopy.bufferOffset += stagingBuffer.BufferOffset();
+			buffImgCopies.PushBack(buffImgCopy);
+		}
+		device.cmdCopyBufferToImage(
+			cmdBuffer,
+			stagingBuffer.buffer,
+			newInner.img,
+			vk::ImageLayout::eTransferDstOptimal,
+			{ (u32)buffImgCopies.Size(), buffImgCopies.Data() });
+
+		vk::ImageMemoryBarrier imgBarrierB{};
+		imgBarrierB.image = newInner.img;
+		imgBarrierB.oldLayout = vk::ImageLayout::eTransferDstOptimal;
+		imgBarrierB.newLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+		imgBarrierB.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+		imgBarrierB.dstAccessMask = vk::AccessFlagBits::eShaderRead;
+		imgBarrierB.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eColor;
+		imgBarrierB.subresourceRange.layerCount = imgInfo.arrayLayers;
+		imgBarrierB.subresourceRange.levelCount = imgInfo.mipLevels;
+		device.cmdPipelineBarrier(
+			cmdBuffer,
+			vk::PipelineStageFlagBits::eTransfer,
+			vk::PipelineStageFlagBits::eFragmentShader,
+			vk::DependencyFlagBits::eByRegion,
+			{},
+			{},
+			imgBarrierB);
+
+		vk::ImageViewCreateInfo imgViewInfo{};
+		imgViewInfo.format = uploadInfo.format;
+		imgViewInfo.image = newInner.img;
+		imgViewInfo.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eColor;
+		imgViewInfo.subresourceRange.layerCount = uploadInfo.layerCount;
+		imgViewInfo.subresourceRange.levelCount = uploadInfo.mipCount;
+		imgViewInfo.viewType = uploadInfo.viewType;
+		newInner.imgView = device.createImageView(imgViewInfo);
+		if (debugUtils) {
+			std::string name = "TextureManager - ";
+			name.append(uploadInfo.debugName.Data(), uploadInfo.debugName.Size());
+			name += " - ImgView";
+			debugUtils->Helper_SetObjectName(
+				device.handle,
+				newInner.imgView,
+				name.c_str());
+		}
+
+		// Make the descriptor-set and update it
+		vk::DescriptorSetAllocateInfo descrSetAllocInfo{};
+		descrSetAllocInfo.descriptorPool = manager.descrPool;
+		descrSetAllocInfo.descriptorSetCount = 1;
+		descrSetAllocInfo.pSetLayouts = &manager.descrSetLayout;
+		vkResult = device.Alloc(descrSetAllocInfo, &newInner.descrSet);
+		if (vkResult != vk::Result::eSuccess)
+			throw std::runtime_error("DEngine - Vulkan: Could not allocate descriptor set.");
+		if (debugUtils) {
+			std::string name = "TextureManager - ";
+			name.append(uploadInfo.debugName.Data(), uploadInfo.debugName.Size());
+			name += " - DescrSet";
+			debugUtils->Helper_SetObjectName(
+				device.handle,
+				newInner.descrSet,
+				name.c_str());
+		}
+
+		vk::DescriptorImageInfo descrImgInfo{};
+		descrImgInfo.imageLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+		descrImgInfo.imageView = newInner.imgView;
+		descrImgInfo.sampler = manager.sampler;
+		vk::WriteDescriptorSet descrWrite{};
+		descrWrite.descriptorCount = 1;
+		descrWrite.descriptorType = vk::DescriptorType::eCombinedImageSampler;
+		descrWrite.dstBinding = 0;
+		descrWrite.dstSet = newInner.descrSet;
+		descrWrite.pImageInfo = &descrImgInfo;
+		device.updateDescriptorSets(descrWrite, {});
+
+		newInner.state = TextureManager::TextureState::Resident;
+		return newInner;
+	}
+
+	static void CreatePlaceholder(
+		TextureManager& manager,
+		GlobUtils const& globUtils,
+		StagingBufferAlloc& stagingBufferAlloc,
+		vk::CommandBuffer cmdBuffer,
+		Std::AllocRef const& transientAlloc)
+	{
+		// A single grey texel.
+		constexpr std::byte texel[4] = { (std::byte)128, (std::byte)128, (std::byte)128, (std::byte)255 };
+
+		vk::BufferImageCopy region = {};
+		region.imageExtent = vk::Extent3D{ 1, 1, 1 };
+		region.imageSubresource.aspectMask = vk::ImageAspectFlagBits::eColor;
+		region.imageSubresource.layerCount = 1;
+		region.imageSubresource.mipLevel = 0;
+
+		constexpr char debugName[] = "Placeholder";
+
+		TextureUploadInfo uploadInfo = {};
+		uploadInfo.debugName = { debugName, sizeof(debugName) - 1 };
+		uploadInfo.imageType = vk::ImageType::e2D;
+		uploadInfo.viewType = vk::ImageViewType::e2D;
+		uploadInfo.format = vk::Format::eR8G8B8A8Unorm;
+		uploadInfo.extent = region.imageExtent;
+		uploadInfo.mipCount = 1;
+		uploadInfo.layerCount = 1;
+		uploadInfo.data = { texel, sizeof(texel) };
+		uploadInfo.regions = { &region, 1 };
+
+		manager.placeholder = UploadTexture(
+			manager,
+			globUtils,
+			stagingBufferAlloc,
+			cmdBuffer,
+			uploadInfo,
+			transientAlloc);
+	}
+
+	static void UploadDecodedTexture(
+		TextureManager& manager,
+		GlobUtils const& globUtils,
+		StagingBufferAlloc& stagingBufferAlloc,
+		vk::CommandBuffer cmdBuffer,
+		DecodedTexture const& decoded,
+		Std::AllocRef const& transientAlloc)
+	{
+		auto const& textureInfo = decoded.textureInfo;
+
+		auto regions = Std::NewVec<vk::BufferImageCopy>(transientAlloc);
+		for (u32 i = 0; i < (u32)textureInfo.mipCount; i += 1) {
+			vk::BufferImageCopy buffImgCopy = {};
+			buffImgCopy.bufferOffset = Texas::calculateMipOffset(textureInfo, i);
+			buffImgCopy.imageExtent = Texas::toVkExtent3D(Texas::calculateMipDimensions(
+				textureInfo.baseDimensions,
+				i));
+			buffImgCopy.imageSubresource.aspectMask = vk::ImageAspectFlagBits::eColor;
+			buffImgCopy.imageSubresource.layerCount = (u32)textureInfo.layerCount;
+			buffImgCopy.imageSubresource.mipLevel = i;
+			regions.PushBack(buffImgCopy);
+		}
+
+		std::string debugName = "Texture #" + std::to_string((u64)decoded.id);
+
+		TextureUploadInfo uploadInfo = {};
+		uploadInfo.debugName = { debugName.data(), debugName.size() };
+		uploadInfo.imageType = (vk::ImageType)Texas::toVkImageType(textureInfo.textureType);
+		uploadInfo.viewType = (vk::ImageViewType)Texas::toVkImageViewType(textureInfo.textureType);
+		uploadInfo.format = (vk::Format)Texas::toVkFormat(textureInfo);
+		uploadInfo.extent = (vk::Extent3D)Texas::toVkExtent3D(textureInfo.baseDimensions);
+		uploadInfo.mipCount = (u32)textureInfo.mipCount;
+		uploadInfo.layerCount = (u32)textureInfo.layerCount;
+		uploadInfo.data = { decoded.imageData.data(), decoded.imageData.size() };
+		uploadInfo.regions = { regions.Data(), regions.Size() };
+
+		auto& inner = manager.database.at(decoded.id);
+		inner = UploadTexture(
+			manager,
+			globUtils,
+			stagingBufferAlloc,
+			cmdBuffer,
+			uploadInfo,
+			transientAlloc);
+	}
+}
+
+vk::DescriptorSet TextureManager::GetDescrSet(TextureID id) const noexcept
+{
+	auto iter = database.find(id);
+	if (iter != database.end() && iter->second.state == TextureState::Resident)
+		return iter->second.descrSet;
+	return placeholder.descrSet;
 }
 
 void TextureManager::Update(
@@ -52,209 +454,86 @@ void TextureManager::Update(
 	Gfx::TextureAssetInterface const& texAssetInterface,
 	Std::AllocRef const& transientAlloc)
 {
-	auto const* debugUtils = globUtils.DebugUtilsPtr();
-	auto const& device = globUtils.device;
+	DENGINE_IMPL_GFX_ASSERT(manager.loader);
+	auto& loader = *manager.loader;
 
-	vk::Result vkResult = {};
-
-	for (auto& item : manager.database)
-		item.second.isNeededHelper = false;
+	if (manager.placeholder.state != TextureState::Resident) {
+		impl::CreatePlaceholder(
+			manager,
+			globUtils,
+			stagingBufferAlloc,
+			cmdBuffer,
+			transientAlloc);
+	}
 
-	for (auto textureID : drawParams.textureIDs)
-	{
+	// Queue every texture we haven't seen before.
+	bool newRequests = false;
+	for (auto textureID : drawParams.textureIDs) {
 		auto iter = manager.database.find(textureID);
 		if (iter != manager.database.end())
-			iter->second.isNeededHelper = true;
-		else
-		{
-			Inner newInner{};
-			newInner.isNeededHelper = true;
+			continue;
+
+		manager.database.insert({ textureID, Inner{} });
 
-			// First we need to get path to the thing
+		TextureLoadRequest request = {};
+		request.id = textureID;
+		request.archiveData = loader.archive.Find(textureID);
+		if (!request.archiveData.HasValue()) {
 			char const* path = texAssetInterface.get(textureID);
+			if (path)
+				request.path = path;
+		}
+		{
+			std::scoped_lock lock{ loader.lock };
+			loader.requests.push_back(Std::Move(request));
+		}
+		newRequests = true;
+	}
+	if (newRequests)
+		loader.condVar.notify_all();
 
-			TextureFileStream fileStream{};
-			fileStream.stream.Open(path);
-			if (!fileStream.stream.IsOpen())
-				throw std::runtime_error("Error. Could not open file-stream.");
-
-			auto parseResult = Texas::parseStream(fileStream);
-			if (!parseResult.isSuccessful())
-				throw std::runtime_error("Error. Couldnt parse image file stream.");
-			auto& texFileInfo = parseResult.value();
-
-			// Create the buffer for us to load the image-data onto.
-			auto stagingBuffer = stagingBufferAlloc.Alloc(
-				device,
-				(int)texFileInfo.memoryRequired(),
-				4);
-			auto workingMemory = Std::NewVec<char>(transientAlloc);
-			if (texFileInfo.workingMemoryRequired() > 0)
-				workingMemory.Resize(texFileInfo.workingMemoryRequired());
-
-			Texas::ByteSpan dstImageDataSpan = {
-				(std::byte*)stagingBuffer.mappedMem.Data(),
-				(uSize)texFileInfo.memoryRequired() };
-			Texas::ByteSpan workingMemSpan = {
-				(std::byte*)workingMemory.Data(),
-				(uSize)texFileInfo.workingMemoryRequired() };
-			auto loadImageDataResult = Texas::loadImageData(
-				fileStream,
-				texFileInfo,
-				dstImageDataSpan,
-				workingMemSpan);
-			if (!loadImageDataResult.isSuccessful()) {
-				std::string errorMsg = "DEngine - Vulkan: Texas was unable to load image-data. Detailed error: ";
-				errorMsg += loadImageDataResult.errorMessage();
-				throw std::runtime_error(errorMsg);
-			}
+	// Pick up whatever the loader threads have finished.
+	{
+		std::scoped_lock lock{ loader.lock };
+		for (auto& decoded : loader.finished)
+			loader.pendingUploads.push_back(Std::Move(decoded));
+		loader.finished.clear();
+	}
 
-			vk::ImageCreateInfo imgInfo{};
-			imgInfo.arrayLayers = (u32)texFileInfo.textureInfo().layerCount;
-			imgInfo.extent = (vk::Extent3D)Texas::toVkExtent3D(texFileInfo.textureInfo().baseDimensions);
-			imgInfo.format = (vk::Format)Texas::toVkFormat(texFileInfo.textureInfo());
-			imgInfo.imageType = (vk::ImageType)Texas::toVkImageType(texFileInfo.textureInfo().textureType);
-			imgInfo.initialLayout = vk::ImageLayout::eUndefined;
-			imgInfo.mipLevels = (u32)texFileInfo.textureInfo().mipCount;
-			imgInfo.samples = vk::SampleCountFlagBits::e1;
-			imgInfo.sharingMode = vk::SharingMode::eExclusive;
-			imgInfo.tiling = vk::ImageTiling::eOptimal;
-			imgInfo.usage = vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eTransferDst;
-			VmaAllocationCreateInfo imgVmaAllocInfo{};
-			imgVmaAllocInfo.usage = VmaMemoryUsage::VMA_MEMORY_USAGE_GPU_ONLY;
-			vkResult = (vk::Result)vmaCreateImage(
-				globUtils.vma,
-				(VkImageCreateInfo const*)&imgInfo,
-				&imgVmaAllocInfo,
-				(VkImage*)&newInner.img,
-				&newInner.imgVmaAlloc,
-				nullptr);
-			if (vkResult != vk::Result::eSuccess)
-				throw std::runtime_error("DEngine - Vulkan: VMA was unable to allocate image.");
-			if (debugUtils) {
-				std::string name = "TextureManager - Texture #" + std::to_string((u64)textureID) + " - Img";
-				debugUtils->Helper_SetObjectName(
-					device.handle,
-					newInner.img,
-					name.c_str());
-			}
+	// Upload within this frame's budget. We always upload at least one
+	// texture per frame so that a texture larger than the budget still gets through.
+	uSize uploadedBytes = 0;
+	uSize uploadedCount = 0;
+	for (auto const& decoded : loader.pendingUploads) {
+		if (!decoded.errorMessage.empty())
+			throw std::runtime_error(decoded.errorMessage);
 
+		auto const size = decoded.imageData.size();
+		if (uploadedCount > 0 && uploadedBytes + size > TextureManager::uploadBudgetPerFrame)
+			break;
 
-			vk::BufferMemoryBarrier buffBarrier{};
-			buffBarrier.buffer = stagingBuffer.buffer;
-			buffBarrier.offset = stagingBuffer.BufferOffset();
-			buffBarrier.size = stagingBuffer.BufferSize();
-			buffBarrier.srcAccessMask = {};
-			buffBarrier.dstAccessMask = vk::AccessFlagBits::eTransferRead;
-			vk::ImageMemoryBarrier imgBarrierA{};
-			imgBarrierA.image = newInner.img;
-			imgBarrierA.oldLayout = vk::ImageLayout::eUndefined;
-			imgBarrierA.newLayout = vk::ImageLayout::eTransferDstOptimal;
-			imgBarrierA.srcAccessMask = {};
-			imgBarrierA.dstAccessMask = vk::AccessFlagBits::eTransferWrite;
-			imgBarrierA.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eColor;
-			imgBarrierA.subresourceRange.layerCount = imgInfo.arrayLayers;
-			imgBarrierA.subresourceRange.levelCount = imgInfo.mipLevels;
-			device.cmdPipelineBarrier(
-				cmdBuffer,
-				vk::PipelineStageFlagBits::eTopOfPipe,
-				vk::PipelineStageFlagBits::eTransfer,
-				vk::DependencyFlagBits::eByRegion,
-				{},
-				buffBarrier,
-				imgBarrierA);
-
-			auto buffImgCopies = Std::NewVec<vk::BufferImageCopy>(transientAlloc);
-			for (int i = 0; i < imgInfo.mipLevels; i++) {
-				vk::BufferImageCopy buffImgCopy = {};
-				buffImgCopy.bufferOffset += stagingBuffer.BufferOffset();
-				buffImgCopy.bufferOffset += Texas::calculateMipOffset(texFileInfo.textureInfo(), i);
-				buffImgCopy.imageExtent = Texas::toVkExtent3D(Texas::calculateMipDimensions(
-					texFileInfo.textureInfo().baseDimensions,
-					i));
-				buffImgCopy.imageSubresource.aspectMask = vk::ImageAspectFlagBits::eColor;
-				buffImgCopy.imageSubresource.layerCount = imgInfo.arrayLayers;
-				buffImgCopy.imageSubresource.mipLevel = i;
-				buffImgCopies.PushBack(buffImgCopy);
-			}
-			device.cmdCopyBufferToImage(
-				cmdBuffer,
-				stagingBuffer.buffer,
-				newInner.img,
-				vk::ImageLayout::eTransferDstOptimal,
-				{ (u32)buffImgCopies.Size(), buffImgCopies.Data() });
-
-			vk::ImageMemoryBarrier imgBarrierB{};
-			imgBarrierB.image = newInner.img;
-			imgBarrierB.oldLayout = vk::ImageLayout::eTransferDstOptimal;
-			imgBarrierB.newLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
-			imgBarrierB.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
-			imgBarrierB.dstAccessMask = vk::AccessFlagBits::eShaderRead;
-			imgBarrierB.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eColor;
-			imgBarrierB.subresourceRange.layerCount = imgInfo.arrayLayers;
-			imgBarrierB.subresourceRange.levelCount = imgInfo.mipLevels;
-			device.cmdPipelineBarrier(
-				cmdBuffer,
-				vk::PipelineStageFlagBits::eTransfer,
-				vk::PipelineStageFlagBits::eFragmentShader,
-				vk::DependencyFlagBits::eByRegion,
-				{},
-				{},
-				imgBarrierB);
-
-			vk::ImageViewCreateInfo imgViewInfo{};
-			imgViewInfo.format = (vk::Format)Texas::toVkFormat(texFileInfo.textureInfo());
-			imgViewInfo.image = newInner.img;
-			imgViewInfo.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eColor;
-			imgViewInfo.subresourceRange.layerCount = (u32)texFileInfo.textureInfo().layerCount;
-			imgViewInfo.subresourceRange.levelCount = (u32)texFileInfo.textureInfo().mipCount;
-			imgViewInfo.viewType = (vk::ImageViewType)Texas::toVkImageViewType(texFileInfo.textureInfo().textureType);
-			newInner.imgView = device.createImageView(imgViewInfo);
-			if (globUtils.UsingDebugUtils())
-			{
-				std::string name = "TextureManager - Texture #" + std::to_string((u64)textureID) + " - ImgView";
-				globUtils.debugUtils.Helper_SetObjectName(
-					globUtils.device.handle,
-					newInner.imgView,
-					name.c_str());
-			}
+		impl::UploadDecodedTexture(
+			manager,
+			globUtils,
+			stagingBufferAlloc,
+			cmdBuffer,
+			decoded,
+			transientAlloc);
+		texAssetInterface.TextureResident(decoded.id);
 
-			// Make the descriptor-set and update it
-			vk::DescriptorSetAllocateInfo descrSetAllocInfo{};
-			descrSetAllocInfo.descriptorPool = manager.descrPool;
-			descrSetAllocInfo.descriptorSetCount = 1;
-			descrSetAllocInfo.pSetLayouts = &manager.descrSetLayout;
-			vkResult = device.Alloc(descrSetAllocInfo, &newInner.descrSet);
-			if (vkResult != vk::Result::eSuccess)
-				throw std::runtime_error("DEngine - Vulkan: Could not allocate descriptor set.");
-			if (debugUtils) {
-				std::string name = "TextureManager - Texture #" + std::to_string((u64)textureID) + " - DescrSet";
-				debugUtils->Helper_SetObjectName(
-					device.handle,
-					newInner.descrSet,
-					name.c_str());
-			}
-
-			vk::DescriptorImageInfo descrImgInfo{};
-			descrImgInfo.imageLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
-			descrImgInfo.imageView = newInner.imgView;
-			descrImgInfo.sampler = manager.sampler;
-			vk::WriteDescriptorSet descrWrite{};
-			descrWrite.descriptorCount = 1;
-			descrWrite.descriptorType = vk::DescriptorType::eCombinedImageSampler;
-			descrWrite.dstBinding = 0;
-			descrWrite.dstSet = newInner.descrSet;
-			descrWrite.pImageInfo = &descrImgInfo;
-			globUtils.device.updateDescriptorSets(descrWrite, {});
-			manager.database.insert({ textureID, newInner });
-		}
+		uploadedBytes += size;
+		uploadedCount += 1;
 	}
+	loader.pendingUploads.erase(
+		loader.pendingUploads.begin(),
+		loader.pendingUploads.begin() + uploadedCount);
 }
 
 void TextureManager::Init(
 	TextureManager& manager,
 	DeviceDispatch const& device,
 	QueueData const& queues,
+	Std::Span<char const> archivePath,
 	DebugUtilsDispatch const* debugUtils)
 {
 	// Make the sampler
@@ -325,4 +604,33 @@ void TextureManager::Init(
 			manager.cmdPool,
 			"TextureManager - CmdPool");
 	}
+
+	manager.loader = new TextureLoader;
+	// The archive is optional, textures it doesn't contain are loaded from their own files.
+	if (archivePath.Size() != 0) {
+		std::string const archivePathString = { archivePath.Data(), archivePath.Size() };
+		TextureArchive::Load(manager.loader->archive, archivePathString.c_str());
+	}
+
+	// Start the loader threads
+	manager.loader->threads.reserve(TextureManager::loaderThreadCount);
+	for (uSize i = 0; i < TextureManager::loaderThreadCount; i += 1)
+		manager.loader->threads.emplace_back(&impl::TextureLoaderEntryPoint, manager.loader, i);
+}
+
+void TextureManager::Destroy(TextureManager& manager)
+{
+	if (!manager.loader)
+		return;
+
+	{
+		std::scoped_lock lock{ manager.loader->lock };
+		manager.loader->shutdown = true;
+	}
+	manager.loader->condVar.notify_all();
+	for (auto& thread : manager.loader->threads)
+		thread.join();
+
+	delete manager.loader;
+	manager.loader = nullptr;
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <DEngine/FixedWidthTypes.hpp>
 #include <DEngine/Std/BumpAllocator.hpp>
 #include <DEngine/Std/Containers/AllocRef.hpp>
+#include <DEngine/Std/Containers/Span.hpp>
 #include <DEngine/Gfx/Gfx.hpp>
 
 #include "DynamicDispatch.hpp"
@@ -16,7 +17,14 @@
 namespace DEngine::Gfx::Vk
 {
 	class GlobUtils;
+	struct TextureLoader;
 
+	// Textures are read and decoded on loader threads. The rendering
+	// thread only uploads the decoded data. Until a texture is resident,
+	// the placeholder texture is bound in its place.
+	//
+	// Textures are looked up in the texture archive first, and only
+	// loaded through the TextureAssetInterface if they are not packed in it.
 	struct TextureManager
 	{
 		vk::Sampler sampler{};
@@ -26,9 +34,21 @@ namespace DEngine::Gfx::Vk
 		static constexpr uSize descrPool_minCapacity = 64;
 		uSize descrPoolCapacity = 0;
 
+		static constexpr uSize loaderThreadCount = 2;
+		// Caps the amount of decoded texture data uploaded in a single frame,
+		// so a burst of new textures is spread out over several frames.
+		// Measured in bytes.
+		static constexpr uSize uploadBudgetPerFrame = StagingBufferAlloc::ringCapacity / 4;
+
+		enum class TextureState : u8
+		{
+			Loading,
+			Resident,
+		};
+
 		struct Inner
 		{
-			bool isNeededHelper = false;
+			TextureState state = TextureState::Loading;
 
 			VmaAllocation imgVmaAlloc{};
 			vk::Image img{};
@@ -36,13 +56,25 @@ namespace DEngine::Gfx::Vk
 			vk::DescriptorSet descrSet{};
 		};
 		std::unordered_map<TextureID, Inner> database;
+		// Created on the first update.
+		Inner placeholder = {};
+
+		TextureLoader* loader = nullptr;
+
+		// Returns the descriptor set of the placeholder if the texture is not resident yet.
+		[[nodiscard]] vk::DescriptorSet GetDescrSet(TextureID id) const noexcept;
 
 		static void Init(
 			TextureManager& manager,
 			DeviceDispatch const& device,
 			QueueData const& queues,
+			// Leave empty to load every texture from its own file.
+			Std::Span<char const> archivePath,
 			DebugUtilsDispatch const* debugUtils);
 
+		// Stops the loader threads. Textures that are still being loaded are dropped.
+		static void Destroy(TextureManager& manager);
+
 		static void Update(
 			TextureManager& manager,
 			GlobUtils const& globUtils,
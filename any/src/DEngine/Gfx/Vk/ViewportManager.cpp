@@ -10,7 +10,6 @@
 #include <DEngine/Std/Containers/Vec.hpp>
 
 #include <string>
-#include <mutex>
 
 namespace DEngine::Gfx::Vk::ViewportMgrImpl
 {
@@ -326,14 +325,9 @@ namespace DEngine::Gfx::Vk::ViewportMgrImpl
 		Std::AllocRef const& transientAlloc)
 	{
 		auto tempDeleteJobs = Std::NewVec<ViewportID>(transientAlloc);
-		{
-			std::scoped_lock lock { viewportManager.deleteQueue_Lock };
-
-			tempDeleteJobs.Resize(viewportManager.deleteQueue.size());
-			for (int i = 0; i < tempDeleteJobs.Size(); i++)
-				tempDeleteJobs[i] = viewportManager.deleteQueue[i];
-			viewportManager.deleteQueue.clear();
-		}
+		viewportManager.deleteQueue.ConsumeAll([&tempDeleteJobs](ViewportID id) {
+			tempDeleteJobs.PushBack(id);
+		});
 
 		auto& viewportNodes = viewportManager.viewportNodes;
 
@@ -361,13 +355,9 @@ namespace DEngine::Gfx::Vk::ViewportMgrImpl
 		Std::AllocRef const& transientAlloc)
 	{
 		auto tempCreateJobs = Std::NewVec<ViewportManager::CreateJob>(transientAlloc);
-		{
-			std::scoped_lock lock{ viewportManager.createQueue_Lock };
-			tempCreateJobs.Resize(viewportManager.createQueue.size());
-			for (int i = 0; i < tempCreateJobs.Size(); i += 1)
-				tempCreateJobs[i] = viewportManager.createQueue[i];
-			viewportManager.createQueue.clear();
-		}
+		viewportManager.createQueue.ConsumeAll([&tempCreateJobs](auto const& createJob) {
+			tempCreateJobs.PushBack(createJob);
+		});
 
 		for (auto const& createJob : tempCreateJobs) {
 			auto newViewport = InitializeViewport(
@@ -549,20 +539,17 @@ void Vk::ViewportManager::NewViewport(
 {
 	ViewportManager::CreateJob createJob{};
 
-	std::lock_guard lock{ viewportManager.createQueue_Lock };
-	createJob.id = (ViewportID)viewportManager.viewportIDTracker;
+	createJob.id = (ViewportID)viewportManager.viewportIDTracker.fetch_add(1, std::memory_order_relaxed);
 	viewportID = createJob.id;
 
-	viewportManager.createQueue.push_back(createJob);
-	viewportManager.viewportIDTracker += 1;
+	viewportManager.createQueue.Push(createJob);
 }
 
 void ViewportManager::DeleteViewport(
 	ViewportManager& manager,
 	ViewportID viewportId)
 {
-	std::lock_guard lock{ manager.deleteQueue_Lock };
-	manager.deleteQueue.push_back(viewportId);
+	manager.deleteQueue.Push(viewportId);
 }
 
 void ViewportManager::ProcessEvents(
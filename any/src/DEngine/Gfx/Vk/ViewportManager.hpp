@@ -12,9 +12,9 @@
 #include "VulkanIncluder.hpp"
 #include "VMAIncluder.hpp"
 #include "ForwardDeclarations.hpp"
+#include "MpscQueue.hpp"
 
 #include <vector>
-#include <mutex>
 
 namespace DEngine::Gfx::Vk
 {
@@ -44,15 +44,13 @@ namespace DEngine::Gfx::Vk
 	// This variable should basically not be accessed anywhere except from APIData.
 	struct ViewportManager {
 		// Create queue resources start
-		std::mutex createQueue_Lock;
 		struct CreateJob { ViewportID id = ViewportID::Invalid; };
-		uSize viewportIDTracker = 0;
-		std::vector<CreateJob> createQueue{};
+		std::atomic<uSize> viewportIDTracker = 0;
+		MpscQueue<CreateJob> createQueue;
 		// Create queue resources end
 
 		// Delete queue resources start
-		std::mutex deleteQueue_Lock;
-		std::vector<ViewportID> deleteQueue{};
+		MpscQueue<ViewportID> deleteQueue;
 		// Delete queue resources end
 
 		// Main mutable resources start
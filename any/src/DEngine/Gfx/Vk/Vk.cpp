@@ -3,6 +3,8 @@
 #include "Init.hpp"
 
 #include "GizmoManager.hpp"
+#include "PipelineCache.hpp"
+#include "ShaderBundle.hpp"
 
 #include <DEngine/FixedWidthTypes.hpp>
 #include <DEngine/Std/BumpAllocator.hpp>
@@ -16,6 +18,7 @@
 // For file IO
 #include <DEngine/Application.hpp>
 
+#include <chrono>
 #include <iostream>
 #include <stdexcept>
 #include <string>
@@ -31,7 +34,7 @@ namespace DEngine::Gfx::Vk
 
 	namespace Init
 	{
-		void InitTestPipeline(APIData& apiData, Std::AllocRef const& transientAlloc);
+		void InitTestPipeline(APIData& apiData, ShaderBundle const& shaderBundle);
 	}
 }
 
@@ -49,22 +52,39 @@ Vk::APIData::~APIData()
 
 	if constexpr (Gfx::enableDedicatedThread)
 	{
-		// Push the shutdown command to the render thread
+		// Push the shutdown command to the render thread.
+		// It finishes the frames that are already queued before it exits.
 		std::unique_lock lock{ apiData.threadLock };
-
-		auto& threadData = apiData.thread;
-		thread.drawParamsCondVarProducer.wait(
-			lock,
-			[&threadData]() { return !threadData.nextJobReady; });
-		threadData.nextJobReady = true;
-		threadData.shutdownThread = true;
+		apiData.thread.shutdownThread = true;
 	}
 	thread.drawParamsCondVarWorker.notify_one();
-	apiData.thread.renderingThread.join();
+	if (apiData.thread.renderingThread.joinable())
+		apiData.thread.renderingThread.join();
+
+	TextureManager::Destroy(apiData.textureManager);
 
 	globUtils.device.waitIdle();
 
 
+	if (globUtils.logger) {
+		auto const& stagingStats = apiData.mainStagingBufferAlloc.GetStats();
+		std::string msg = "DEngine - Vulkan: Staging memory high-water mark was " +
+			std::to_string(stagingStats.highWaterMark) + " bytes, " +
+			std::to_string(stagingStats.overflowFrameCount) + " frames overflowed the staging ring.";
+		globUtils.logger->Log(LogInterface::Level::Info, { msg.data(), msg.size() });
+
+		auto const queueStats = apiData.GetFrameQueueStats();
+		msg = "DEngine - Vulkan: Frame queue depth " + std::to_string(queueStats.queueDepth) + ", " +
+			std::to_string(queueStats.renderedFrameCount) + " frames rendered at " +
+			std::to_string(queueStats.renderedFramesPerSecond) + " fps, average queue latency " +
+			std::to_string(queueStats.avgQueueLatency) + " ms (max " +
+			std::to_string(queueStats.maxQueueLatency) + " ms), average submit block time " +
+			std::to_string(queueStats.avgSubmitBlockTime) + " ms.";
+		globUtils.logger->Log(LogInterface::Level::Info, { msg.data(), msg.size() });
+	}
+	StagingBufferAlloc::Destroy(apiData.mainStagingBufferAlloc);
+
+	SecondaryCmdRecorder::Destroy(apiData.secondaryCmdRecorder, globUtils.device);
 	for (auto const& cmdPool : apiData.mainCmdPools)
 		globUtils.device.Destroy(cmdPool);
 	for (auto const& fence : apiData.mainFences)
@@ -81,6 +101,19 @@ Vk::APIData::~APIData()
 
 	DelQueue::FlushAllJobs(apiData.delQueue, globUtils);
 
+	// Persist the pipeline cache so that the next launch can skip shader compilation.
+	bool const pipelineCacheSaved = PipelineCache::Save(
+		globUtils.device,
+		globUtils.physDevice,
+		globUtils.pipelineCache,
+		{ apiData.pipelineCachePath.data(), apiData.pipelineCachePath.size() },
+		apiData.frameAllocator);
+	if (!pipelineCacheSaved && globUtils.logger) {
+		std::string msg = "DEngine - Vulkan: Unable to save pipeline cache to '" + apiData.pipelineCachePath + "'.";
+		globUtils.logger->Log(LogInterface::Level::Info, { msg.data(), msg.size() });
+	}
+	globUtils.device.Destroy(globUtils.pipelineCache);
+
 	/*
 	if (globUtils.UsingDebugUtils())
 	{
@@ -114,13 +147,14 @@ void Vk::APIData::DeleteViewport(ViewportID id)
 		id);
 }
 
-void Vk::APIData::NewFontFace(FontFaceId fontFaceId)
+void Vk::APIData::NewFontFace(FontFaceId fontFaceId, FontFaceType type)
 {
 	auto& apiData = *this;
 
 	GuiResourceManager::NewFontFace(
 		apiData.guiResourceManager,
-		fontFaceId);
+		fontFaceId,
+		type);
 }
 
 void Vk::APIData::NewFontTextures(Std::Span<FontBitmapUploadJob const> const& jobs)
@@ -145,24 +179,34 @@ namespace DEngine::Gfx::Vk
 
 		APIData& apiData = *inApiData;
 
+		auto& threadData = apiData.thread;
 		while (true) {
 			std::unique_lock lock{ apiData.threadLock };
 
-			auto& threadData = apiData.thread;
 			threadData.drawParamsCondVarWorker.wait(
 				lock,
-				[&threadData](){ return threadData.nextJobReady; });
+				[&threadData](){ return threadData.queuedPacketCount != 0 || threadData.shutdownThread; });
 
-			DENGINE_IMPL_GFX_ASSERT(threadData.nextJobFn != nullptr);
-			threadData.nextJobFn(apiData);
-
-			threadData.nextJobReady = false;
-
-			if (threadData.shutdownThread)
+			// Drain the queue before shutting down.
+			if (threadData.queuedPacketCount == 0)
 				break;
 
+			auto const drawPacketIndex = threadData.queuedPackets[threadData.queuedPacketsFront];
+			auto const queuedTime = threadData.counters.packetQueuedTimes[drawPacketIndex];
+
+			// Taking the packet frees up its slot in the queue, so the producer can
+			// queue another one while we are working on this one.
+			threadData.queuedPacketsFront = (threadData.queuedPacketsFront + 1) % maxFrameQueueDepth;
+			threadData.queuedPacketCount -= 1;
 			lock.unlock();
 			threadData.drawParamsCondVarProducer.notify_one();
+
+			auto const renderStart = APIData::ClockT::now();
+			APIData::InternalDraw(apiData, apiData.drawPackets[drawPacketIndex]);
+			auto const renderEnd = APIData::ClockT::now();
+
+			lock.lock();
+			threadData.counters.RecordRenderedFrame(queuedTime, renderStart, renderEnd);
 		}
 	}
 }
@@ -312,17 +356,29 @@ APIDataBase* Vk::InitializeBackend(Context& gfxData, InitInfo const& initInfo)
 		apiData.mainCmdBuffers = result.cmdBuffers;
 	}
 
-	// Initialize our staging buffer allocators
+	// The producer thread and the rendering thread are already busy,
+	// the remaining cores help recording the viewports and windows.
 	{
-		apiData.mainStagingBufferAllocs.Resize(inFlightCount);
-		for (int i = 0; i < inFlightCount; i++) {
-			StagingBufferAlloc::BuildInPlace(
-				apiData.mainStagingBufferAllocs[i],
-				device,
-				vma);
-		}
+		auto const coreCount = (int)std::thread::hardware_concurrency();
+		auto workerCount = coreCount > 2 ? coreCount - 2 : 0;
+		if (workerCount > SecondaryCmdRecorder::maxWorkerCount)
+			workerCount = SecondaryCmdRecorder::maxWorkerCount;
+		SecondaryCmdRecorder::Init(
+			apiData.secondaryCmdRecorder,
+			device,
+			queues.graphics.FamilyIndex(),
+			inFlightCount,
+			workerCount,
+			debugUtils);
 	}
 
+	// Initialize our staging buffer allocator
+	StagingBufferAlloc::BuildInPlace(
+		apiData.mainStagingBufferAlloc,
+		device,
+		vma,
+		inFlightCount);
+
 	NativeWinMgr::Initialize({
 		 .manager = apiData.nativeWindowManager,
 		 .initialWindow = initInfo.initialWindow,
@@ -344,11 +400,12 @@ APIDataBase* Vk::InitializeBackend(Context& gfxData, InitInfo const& initInfo)
 		apiData.textureManager,
 		device,
 		queues,
+		{ initInfo.textureArchivePath.data(), initInfo.textureArchivePath.size() },
 		debugUtils);
 
 	boolResult = ObjectDataManager::Init(
 		apiData.objectDataManager,
-		physDevice.properties.limits.minUniformBufferOffsetAlignment,
+		physDevice.properties.limits.minStorageBufferOffsetAlignment,
 		device,
 		debugUtils);
 	if (!boolResult)
@@ -367,14 +424,32 @@ APIDataBase* Vk::InitializeBackend(Context& gfxData, InitInfo const& initInfo)
 		true,
 		globUtils.DebugUtilsPtr());
 
+	// All pipelines below share this cache. If it was loaded from a previous run,
+	// the driver can skip compiling the shaders, so we log how long this took.
+	apiData.pipelineCachePath = initInfo.pipelineCachePath;
+	auto const pipelineCacheResult = PipelineCache::Create(
+		device,
+		physDevice,
+		{ apiData.pipelineCachePath.data(), apiData.pipelineCachePath.size() },
+		transientAlloc,
+		debugUtils);
+	globUtils.pipelineCache = pipelineCacheResult.handle;
+	auto const pipelineCreationStart = std::chrono::steady_clock::now();
+
+	// Every shader module below is created from this bundle, it's only needed during init.
+	ShaderBundle shaderBundle;
+	ShaderBundle::Load(shaderBundle, ShaderBundle::defaultPath);
+
 	Init::InitTestPipeline(
 		apiData,
-		transientAlloc);
+		shaderBundle);
 
 	GuiResourceManager::Init(apiData.guiResourceManager, {
 		.device = device,
 		.vma = vma,
 		.guiRenderPass = guiRenderPass,
+		.pipelineCache = globUtils.pipelineCache,
+		.shaderBundle = shaderBundle,
 		.viewportImgDescrLayout = viewportManager.imgDescrSetLayout,
 		.inFlightCount = inFlightCount,
 		.transientAlloc = transientAlloc,
@@ -391,11 +466,27 @@ APIDataBase* Vk::InitializeBackend(Context& gfxData, InitInfo const& initInfo)
 	gizmoManagerInfo.inFlightCount = inFlightCount;
 	gizmoManagerInfo.frameAlloc = &transientAlloc;
 	gizmoManagerInfo.queues = &queues;
+	gizmoManagerInfo.shaderBundle = &shaderBundle;
 	gizmoManagerInfo.vma = &vma;
 	GizmoManager::Initialize(apiData.gizmoManager, gizmoManagerInfo);
 
+	if (globUtils.logger) {
+		auto const pipelineCreationTime = std::chrono::duration<double, std::milli>(
+			std::chrono::steady_clock::now() - pipelineCreationStart);
+		std::string msg = "DEngine - Vulkan: Created pipelines in " +
+			std::to_string(pipelineCreationTime.count()) + " ms (" +
+			(pipelineCacheResult.loadedFromDisk ? "warm" : "cold") + " pipeline cache).";
+		globUtils.logger->Log(LogInterface::Level::Info, { msg.data(), msg.size() });
+	}
+
 
+	// Without the dedicated thread every frame is drawn inside SubmitDraw, so nothing is ever queued.
 	if constexpr (Gfx::enableDedicatedThread) {
+		apiData.frameQueueDepth = initInfo.frameQueueDepth;
+		if (apiData.frameQueueDepth < 1)
+			apiData.frameQueueDepth = 1;
+		if (apiData.frameQueueDepth > maxFrameQueueDepth)
+			apiData.frameQueueDepth = maxFrameQueueDepth;
 		apiData.thread.renderingThread = std::thread(&RenderingThreadEntryPoint, &apiData);
 	}
 
@@ -403,7 +494,7 @@ APIDataBase* Vk::InitializeBackend(Context& gfxData, InitInfo const& initInfo)
 	return returnVal;
 }
 
-void Vk::Init::InitTestPipeline(APIData& apiData, Std::AllocRef const& transientAlloc)
+void Vk::Init::InitTestPipeline(APIData& apiData, ShaderBundle const& shaderBundle)
 {
 	auto const& globUtils = apiData.globUtils;
 	auto const& device = globUtils.device;
@@ -428,38 +519,20 @@ void Vk::Init::InitTestPipeline(APIData& apiData, Std::AllocRef const& transient
 			"Test Pipelinelayout");
 	}
 
-	App::FileInputStream vertFile { "data/vert.spv" };
-	if (!vertFile.IsOpen())
-		throw std::runtime_error("Could not open vertex shader file");
-	vertFile.Seek(0, App::FileInputStream::SeekOrigin::End);
-	u64 vertFileLength = vertFile.Tell().Value();
-	vertFile.Seek(0, App::FileInputStream::SeekOrigin::Start);
-	auto vertCode = Std::NewVec<char>(transientAlloc);
-	vertCode.Resize((uSize)vertFileLength);
-	vertFile.Read(vertCode.Data(), vertFileLength);
-
+	auto const vertCode = shaderBundle.Get("vert.spv");
 	vk::ShaderModuleCreateInfo vertModCreateInfo = {};
-	vertModCreateInfo.codeSize = vertCode.Size();
-	vertModCreateInfo.pCode = reinterpret_cast<u32 const*>(vertCode.Data());
+	vertModCreateInfo.codeSize = vertCode.Size() * sizeof(u32);
+	vertModCreateInfo.pCode = vertCode.Data();
 	vk::ShaderModule vertModule = device.createShaderModule(vertModCreateInfo);
 	vk::PipelineShaderStageCreateInfo vertStageInfo = {};
 	vertStageInfo.stage = vk::ShaderStageFlagBits::eVertex;
 	vertStageInfo.module = vertModule;
 	vertStageInfo.pName = "main";
 
-	App::FileInputStream fragFile{ "data/frag.spv" };
-	if (!fragFile.IsOpen())
-		throw std::runtime_error("Could not open fragment shader file");
-	fragFile.Seek(0, App::FileInputStream::SeekOrigin::End);
-	u64 fragFileLength = fragFile.Tell().Value();
-	fragFile.Seek(0, App::FileInputStream::SeekOrigin::Start);
-	auto fragCode = Std::NewVec<char>(transientAlloc);
-	fragCode.Resize((uSize)fragFileLength);
-	fragFile.Read(fragCode.Data(), fragFileLength);
-
+	auto const fragCode = shaderBundle.Get("frag.spv");
 	vk::ShaderModuleCreateInfo fragModInfo{};
-	fragModInfo.codeSize = fragCode.Size();
-	fragModInfo.pCode = reinterpret_cast<const u32*>(fragCode.Data());
+	fragModInfo.codeSize = fragCode.Size() * sizeof(u32);
+	fragModInfo.pCode = fragCode.Data();
 	vk::ShaderModule fragModule = device.createShaderModule(fragModInfo);
 	vk::PipelineShaderStageCreateInfo fragStageInfo{};
 	fragStageInfo.stage = vk::ShaderStageFlagBits::eFragment;
@@ -544,7 +617,7 @@ void Vk::Init::InitTestPipeline(APIData& apiData, Std::AllocRef const& transient
 	pipelineInfo.stageCount = (u32)shaderStages.Size();
 	pipelineInfo.pStages = shaderStages.Data();
 
-	vkResult = device.Create(pipelineInfo, &apiData.testPipeline);
+	vkResult = device.Create(globUtils.pipelineCache, pipelineInfo, &apiData.testPipeline);
 	if (vkResult != vk::Result::eSuccess)
 		throw std::runtime_error("Unable to make graphics pipeline.");
 	if (debugUtils)
@@ -11,6 +11,7 @@
 #include "NativeWindowManager.hpp"
 #include "ObjectDataManager.hpp"
 #include "QueueData.hpp"
+#include "SecondaryCmdRecorder.hpp"
 #include "StagingBufferAlloc.hpp"
 #include "TextureManager.hpp"
 #include "ViewportManager.hpp"
@@ -25,8 +26,10 @@
 #include <DEngine/Std/Containers/Array.hpp>
 #include <DEngine/Std/Containers/Pair.hpp>
 
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -59,7 +62,10 @@ namespace DEngine::Gfx::Vk
 	public:
 		APIData();
 		virtual ~APIData() override;
-		virtual void Draw(DrawParams const& drawParams) override;
+		virtual DrawParams& AcquireDrawParams() override;
+		virtual void SubmitDrawParams() override;
+		// Thread safe
+		virtual FrameQueueStats GetFrameQueueStats() const override;
 		static void InternalDraw(APIData& apiData, DrawParams const& drawParams);
 
 		// Thread safe
@@ -73,7 +79,7 @@ namespace DEngine::Gfx::Vk
 		virtual void DeleteViewport(ViewportID id) override;
 
 		// Thread safe
-		virtual void NewFontFace(FontFaceId fontFaceId) override;
+		virtual void NewFontFace(FontFaceId fontFaceId, FontFaceType type) override;
 
 		// Thread safe
 		virtual void NewFontTextures(Std::Span<FontBitmapUploadJob const> const&) override;
@@ -99,7 +105,9 @@ namespace DEngine::Gfx::Vk
 		Std::StackVec<vk::Fence, Const::maxInFlightCount> mainFences;
 		Std::StackVec<vk::CommandPool, Const::maxInFlightCount> mainCmdPools;
 		Std::StackVec<vk::CommandBuffer, Const::maxInFlightCount> mainCmdBuffers;
-		Std::StackVec<StagingBufferAlloc, Const::maxInFlightCount> mainStagingBufferAllocs;
+		StagingBufferAlloc mainStagingBufferAlloc;
+		// Viewports and windows are recorded into secondary cmd buffers from here.
+		SecondaryCmdRecorder secondaryCmdRecorder;
 
 		GlobUtils globUtils = {};
 
@@ -116,14 +124,60 @@ namespace DEngine::Gfx::Vk
 		vk::PipelineLayout testPipelineLayout{};
 		vk::Pipeline testPipeline{};
 
-		std::mutex threadLock;
+		// Where globUtils.pipelineCache gets saved on shutdown.
+		std::string pipelineCachePath;
+
+		// Ring of frame packets. At any time the producer writes into one,
+		// up to frameQueueDepth can be queued and the rendering thread can be drawing one.
+		// The packets are never freed, so their vectors keep their memory between frames.
+		static constexpr uSize maxDrawPacketCount = maxFrameQueueDepth + 2;
+		Std::Array<DrawParams, maxDrawPacketCount> drawPackets;
+		// Set once during init, in the range [1, maxFrameQueueDepth].
+		uSize frameQueueDepth = 1;
+		[[nodiscard]] uSize DrawPacketCount() const noexcept { return frameQueueDepth + 2; }
+		// Only touched by the producer thread.
+		uSize drawPacketWriteIndex = 0;
+
+		using ClockT = std::chrono::steady_clock;
+		// Everything in here is guarded by threadLock.
+		struct FrameQueueCounters {
+			u64 submittedFrameCount = 0;
+			u64 renderedFrameCount = 0;
+			ClockT::duration totalQueueLatency = {};
+			ClockT::duration maxQueueLatency = {};
+			ClockT::duration totalSubmitBlockTime = {};
+			ClockT::duration totalRenderTime = {};
+			ClockT::time_point firstRenderStart = {};
+			ClockT::time_point lastRenderEnd = {};
+			// When each packet entered the queue, indexed by packet.
+			Std::Array<ClockT::time_point, maxDrawPacketCount> packetQueuedTimes = {};
+
+			void RecordRenderedFrame(
+				ClockT::time_point queuedTime,
+				ClockT::time_point renderStart,
+				ClockT::time_point renderEnd) noexcept
+			{
+				if (renderedFrameCount == 0)
+					firstRenderStart = renderStart;
+				renderedFrameCount += 1;
+				auto const queueLatency = renderStart - queuedTime;
+				totalQueueLatency += queueLatency;
+				if (queueLatency > maxQueueLatency)
+					maxQueueLatency = queueLatency;
+				totalRenderTime += renderEnd - renderStart;
+				lastRenderEnd = renderEnd;
+			}
+		};
+
+		mutable std::mutex threadLock;
 		struct Thread {
 			std::thread renderingThread;
 			bool shutdownThread = false;
-			bool nextJobReady = false;
-			using JobFnT = void(*)(APIData& apiData);
-			JobFnT nextJobFn = nullptr;
-			DrawParams drawParams;
+			// FIFO of submitted packet indices the rendering thread has not started on yet.
+			Std::Array<uSize, maxFrameQueueDepth> queuedPackets = {};
+			uSize queuedPacketsFront = 0;
+			uSize queuedPacketCount = 0;
+			FrameQueueCounters counters = {};
 			std::condition_variable drawParamsCondVarWorker;
 			std::condition_variable drawParamsCondVarProducer;
 		};
@@ -35,6 +35,7 @@ namespace DEngine::Gui::impl
 
 	struct PointerMove_Params
 	{
+		Context& ctx;
 		Button& btn;
 		Rect const& widgetRect;
 		Rect const& visibleRect;
@@ -128,8 +129,13 @@ bool Gui::Button::Impl::PointerMove(impl::PointerMove_Params const& params)
 		widgetRect.PointIsInside(pointer.pos) &&
 		visibleRect.PointIsInside(pointer.pos);
 
-	if (params.pointer.id == impl::cursorPointerId)
-		widget.hoveredByCursor = pointerInside && !params.pointer.occluded;
+	if (params.pointer.id == impl::cursorPointerId) {
+		auto const newHovered = pointerInside && !params.pointer.occluded;
+		if (widget.hoveredByCursor != newHovered) {
+			widget.hoveredByCursor = newHovered;
+			params.ctx.InvalidateRendering(widget);
+		}
+	}
 
 	return pointerInside;
 }
@@ -176,6 +182,7 @@ bool Button::CursorMove(
 	pointer.occluded = occluded;
 
 	impl::PointerMove_Params temp = {
+		params.ctx,
 		*this,
 		widgetRect,
 		visibleRect,
@@ -219,6 +226,7 @@ bool Button::TouchMove2(
 	pointer.occluded = occluded;
 
 	impl::PointerMove_Params temp = {
+		params.ctx,
 		*this,
 		widgetRect,
 		visibleRect,
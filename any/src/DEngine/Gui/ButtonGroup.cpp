@@ -166,6 +166,7 @@ struct Gui::ButtonGroup::Impl
 
 	struct PointerMove_Params
 	{
+		Context& ctx;
 		ButtonGroup& widget;
 		Rect const& widgetRect;
 		Rect const& visibleRect;
@@ -190,6 +191,7 @@ struct Gui::ButtonGroup::Impl
 		auto const pointerInside = widgetRect.GetIntersect(visibleRect).PointIsInside(pointer.pos);
 
 		if (pointer.id == cursorPointerId) {
+			auto const oldHoverIndex = widget.cursorHoverIndex;
 			if (!pointerInside || pointer.occluded) {
 				widget.cursorHoverIndex = Std::nullOpt;
 			}
@@ -211,6 +213,12 @@ struct Gui::ButtonGroup::Impl
 					widget.cursorHoverIndex = hoveredIndexOpt.Value();
 				}
 			}
+
+			if (oldHoverIndex.HasValue() != widget.cursorHoverIndex.HasValue() ||
+				(oldHoverIndex.HasValue() && oldHoverIndex.Value() != widget.cursorHoverIndex.Value()))
+			{
+				params.ctx.InvalidateRendering(widget);
+			}
 		}
 
 		return pointerInside;
@@ -497,6 +505,7 @@ bool ButtonGroup::CursorMove(
 	pointer.occluded = occluded;
 
 	Impl::PointerMove_Params tempParams {
+		.ctx = params.ctx,
 		.widget = *this,
 		.widgetRect = widgetRect,
 		.visibleRect = visibleRect,
@@ -546,6 +555,7 @@ bool ButtonGroup::TouchMove2(
 	pointer.occluded = occluded;
 
 	Impl::PointerMove_Params tempParams {
+		.ctx = params.ctx,
 		.widget = *this,
 		.widgetRect = widgetRect,
 		.visibleRect = visibleRect,
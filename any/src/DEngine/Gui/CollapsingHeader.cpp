@@ -220,7 +220,11 @@ public:
 			headerRect.PointIsInside(pointer.pos);
 
 		if (pointer.id == cursorPointerId) {
-			widget.hoveredByCursor = insideHeader && !pointer.occluded;
+			auto const newHovered = insideHeader && !pointer.occluded;
+			if (widget.hoveredByCursor != newHovered) {
+				widget.hoveredByCursor = newHovered;
+				ctx.InvalidateRendering(widget);
+			}
 		}
 
 		if (widget.child && !widget.collapsed) {
@@ -84,6 +84,10 @@ namespace DEngine::Gui::impl
 			implData.postEventAlloc.Free(job.ptr, job.allocSize);
 		}
 
+		// Post-event jobs are free to restructure the widget hierarchy.
+		if (!implData.postEventJobs.empty())
+			ctx.InvalidateLayout();
+
 		implData.postEventJobs.clear();
 		implData.postEventAlloc.Reset();
 	}
@@ -193,6 +197,235 @@ namespace DEngine::Gui::impl
 			transientAlloc.Reset();
 		}
 	}
+
+	// Rebuilds the cached rect collection if it has been invalidated,
+	// or if any of the context settings that feed into the layout have changed.
+	void UpdateCachedRectCollection(
+		Context const& ctx,
+		Context::Impl& implData,
+		TextManager& textManager,
+		Std::ConstAnyRef appData)
+	{
+		bool const settingsChanged =
+			implData.rectCollectionFontScale != ctx.fontScale ||
+			implData.rectCollectionMinimumHeightCm != ctx.minimumHeightCm ||
+			implData.rectCollectionDefaultMarginFactor != ctx.defaultMarginFactor;
+		if (implData.rectCollectionIsValid && !settingsChanged)
+			return;
+
+		BuildRectCollection(
+			ctx,
+			implData,
+			textManager,
+			appData,
+			implData.rectCollection,
+			false,
+			implData.transientAlloc);
+
+		implData.rectCollectionIsValid = true;
+		implData.rectCollectionFontScale = ctx.fontScale;
+		implData.rectCollectionMinimumHeightCm = ctx.minimumHeightCm;
+		implData.rectCollectionDefaultMarginFactor = ctx.defaultMarginFactor;
+	}
+
+	[[nodiscard]] bool DrawCache_LayoutChanged(
+		Context const& ctx,
+		DrawCache const& cache,
+		RectCollection const& rectCollection)
+	{
+		if (cache.fontScale != ctx.fontScale ||
+			cache.minimumHeightCm != ctx.minimumHeightCm ||
+			cache.defaultMarginFactor != ctx.defaultMarginFactor)
+		{
+			return true;
+		}
+
+		auto const count = rectCollection.widgets.size();
+		if (count != cache.layoutWidgets.size())
+			return true;
+		for (uSize i = 0; i < count; i += 1) {
+			auto const& rects = rectCollection.rects[i];
+			auto const& cachedRects = cache.layoutRects[i];
+			if (rectCollection.widgets[i].voidPtr != cache.layoutWidgets[i] ||
+				rects.widgetRect != cachedRects.widgetRect ||
+				rects.visibleRect != cachedRects.visibleRect)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Throws out the retained draw data if it can't be trusted,
+	// and finds the invalidated widgets in the new layout.
+	void DrawCache_BeginRender(
+		Context const& ctx,
+		DrawCache& cache,
+		RectCollection const& rectCollection)
+	{
+		// The app is free to change the widget hierarchy outside of events,
+		// so a widget at the same address might not be the same widget anymore.
+		auto const layoutChanged = DrawCache_LayoutChanged(ctx, cache, rectCollection);
+		if (cache.invalidated || layoutChanged)
+			cache.entries.clear();
+		cache.invalidated = false;
+
+		if (layoutChanged) {
+			cache.fontScale = ctx.fontScale;
+			cache.minimumHeightCm = ctx.minimumHeightCm;
+			cache.defaultMarginFactor = ctx.defaultMarginFactor;
+			auto const count = rectCollection.widgets.size();
+			cache.layoutWidgets.resize(count);
+			cache.layoutRects.resize(count);
+			for (uSize i = 0; i < count; i += 1) {
+				cache.layoutWidgets[i] = rectCollection.widgets[i].voidPtr;
+				cache.layoutRects[i] = rectCollection.rects[i];
+			}
+		}
+
+		cache.invalidatedEntries.clear();
+		for (auto const* widget : cache.invalidatedWidgets) {
+			// Widgets that are not part of the layout have nothing to invalidate.
+			auto const entryOpt = rectCollection.GetEntry(*widget);
+			if (entryOpt.HasValue())
+				cache.invalidatedEntries.push_back(entryOpt.Value());
+		}
+		cache.invalidatedWidgets.clear();
+	}
+
+	// Retains the output of this render for the next one, and drops
+	// the entries that were not rendered.
+	void DrawCache_EndRender(
+		DrawCache& cache,
+		Context::Render2_Params const& params)
+	{
+		auto& entries = cache.entries;
+		for (auto it = entries.begin(); it != entries.end();) {
+			auto& entry = it->second;
+			if (entry.rendered) {
+				entry.retained = entry.current;
+				entry.hasRetained = true;
+				entry.rendered = false;
+				it++;
+			} else {
+				it = entries.erase(it);
+			}
+		}
+		cache.invalidatedEntries.clear();
+
+		// Nothing will be replayed from this render, so there is no need to retain it.
+		if (entries.empty())
+			return;
+		cache.vertices.assign(params.vertices.begin(), params.vertices.end());
+		cache.indices.assign(params.indices.begin(), params.indices.end());
+		cache.drawCmds.assign(params.drawCmds.begin(), params.drawCmds.end());
+		cache.utfValues.assign(params.utfValues.begin(), params.utfValues.end());
+		cache.textGlyphRects.assign(params.textGlyphRects.begin(), params.textGlyphRects.end());
+	}
+
+	[[nodiscard]] constexpr bool DrawRanges_RangeContains(u32 outerOffset, u32 outerCount, u32 offset, u32 count) noexcept
+	{
+		return offset >= outerOffset && offset + count <= outerOffset + outerCount;
+	}
+
+	[[nodiscard]] constexpr bool DrawRanges_Contains(DrawRanges const& outer, DrawRanges const& inner) noexcept
+	{
+		return
+			DrawRanges_RangeContains(outer.vertexOffset, outer.vertexCount, inner.vertexOffset, inner.vertexCount) &&
+			DrawRanges_RangeContains(outer.indexOffset, outer.indexCount, inner.indexOffset, inner.indexCount) &&
+			DrawRanges_RangeContains(outer.drawCmdOffset, outer.drawCmdCount, inner.drawCmdOffset, inner.drawCmdCount) &&
+			DrawRanges_RangeContains(outer.glyphOffset, outer.glyphCount, inner.glyphOffset, inner.glyphCount);
+	}
+
+	// Moves a range nested within the source range along with it.
+	[[nodiscard]] constexpr DrawRanges DrawRanges_Rebase(
+		DrawRanges const& in,
+		DrawRanges const& src,
+		DrawRanges const& dst) noexcept
+	{
+		DrawRanges returnVal = in;
+		returnVal.vertexOffset = in.vertexOffset - src.vertexOffset + dst.vertexOffset;
+		returnVal.indexOffset = in.indexOffset - src.indexOffset + dst.indexOffset;
+		returnVal.drawCmdOffset = in.drawCmdOffset - src.drawCmdOffset + dst.drawCmdOffset;
+		returnVal.glyphOffset = in.glyphOffset - src.glyphOffset + dst.glyphOffset;
+		returnVal.quadVertexOffset = dst.quadVertexOffset;
+		returnVal.quadIndexOffset = dst.quadIndexOffset;
+		return returnVal;
+	}
+
+	void DrawCache_RebaseDrawCmd(
+		Gfx::GuiDrawCmd& cmd,
+		DrawRanges const& src,
+		DrawRanges const& dst)
+	{
+		switch (cmd.type) {
+			case Gfx::GuiDrawCmd::Type::Text: {
+				cmd.text.startIndex = cmd.text.startIndex - src.glyphOffset + dst.glyphOffset;
+				break;
+			}
+			case Gfx::GuiDrawCmd::Type::FilledMesh: {
+				// Meshes either live within the subtree's own range, or are the window's quad.
+				auto& mesh = cmd.filledMesh.mesh;
+				if (DrawRanges_RangeContains(src.vertexOffset, src.vertexCount, mesh.vertexOffset, 1)) {
+					mesh.vertexOffset = mesh.vertexOffset - src.vertexOffset + dst.vertexOffset;
+				} else {
+					DENGINE_IMPL_GUI_ASSERT(mesh.vertexOffset == src.quadVertexOffset);
+					mesh.vertexOffset = dst.quadVertexOffset;
+				}
+				if (DrawRanges_RangeContains(src.indexOffset, src.indexCount, mesh.indexOffset, mesh.indexCount)) {
+					mesh.indexOffset = mesh.indexOffset - src.indexOffset + dst.indexOffset;
+				} else {
+					DENGINE_IMPL_GUI_ASSERT(mesh.indexOffset == src.quadIndexOffset);
+					mesh.indexOffset = dst.quadIndexOffset;
+				}
+				break;
+			}
+			default:
+				break;
+		}
+	}
+
+	void DrawCache_Replay(
+		DrawCache& cache,
+		DrawCacheEntry& entry,
+		DrawInfo& drawInfo)
+	{
+		auto const& src = entry.retained;
+
+		DrawRanges dst = src;
+		dst.vertexOffset = (u32)drawInfo.vertices->size();
+		dst.indexOffset = (u32)drawInfo.indices->size();
+		dst.drawCmdOffset = (u32)drawInfo.drawCmds->size();
+		dst.glyphOffset = (u32)drawInfo.utfValues->size();
+		dst.quadVertexOffset = drawInfo.quadVertexOffset;
+		dst.quadIndexOffset = drawInfo.quadIndexOffset;
+		DENGINE_IMPL_GUI_ASSERT(drawInfo.utfValues->size() == drawInfo.textGlyphRects->size());
+
+		auto const append = [](auto& out, auto const& in, u32 offset, u32 count) {
+			out.insert(out.end(), in.begin() + offset, in.begin() + offset + count);
+		};
+		append(*drawInfo.vertices, cache.vertices, src.vertexOffset, src.vertexCount);
+		append(*drawInfo.indices, cache.indices, src.indexOffset, src.indexCount);
+		append(*drawInfo.utfValues, cache.utfValues, src.glyphOffset, src.glyphCount);
+		append(*drawInfo.textGlyphRects, cache.textGlyphRects, src.glyphOffset, src.glyphCount);
+		append(*drawInfo.drawCmds, cache.drawCmds, src.drawCmdOffset, src.drawCmdCount);
+		for (u32 i = 0; i < dst.drawCmdCount; i += 1)
+			DrawCache_RebaseDrawCmd((*drawInfo.drawCmds)[dst.drawCmdOffset + i], src, dst);
+
+		entry.current = dst;
+		entry.rendered = true;
+
+		// The replayed data includes the data of every cache nested in this subtree,
+		// so those need to follow along to stay valid for the next render.
+		for (auto& [widget, nested] : cache.entries) {
+			if (&nested == &entry || !nested.hasRetained)
+				continue;
+			if (DrawRanges_Contains(src, nested.retained)) {
+				nested.current = DrawRanges_Rebase(nested.retained, src, dst);
+				nested.rendered = true;
+			}
+		}
+	}
 }
 
 Context Context::Create(
@@ -282,6 +515,110 @@ void Context::SetFrontmostLayer(
 	auto& windowNode = *windowNodePtr;
 
 	windowNode.frontmostLayer = static_cast<Std::Box<Layer>&&>(layer);
+	InvalidateLayout();
+}
+
+void Context::InvalidateLayout() const
+{
+	auto& implData = Internal_ImplData();
+	implData.rectCollectionIsValid = false;
+	InvalidateRendering();
+}
+
+void Context::InvalidateRendering() const
+{
+	auto& implData = Internal_ImplData();
+	implData.drawCache.invalidated = true;
+}
+
+void Context::InvalidateRendering(Widget const& widget) const
+{
+	auto& implData = Internal_ImplData();
+	auto& invalidatedWidgets = implData.drawCache.invalidatedWidgets;
+	auto const it = Std::FindIf(
+		invalidatedWidgets.begin(),
+		invalidatedWidgets.end(),
+		[&widget](auto const* item) { return item == &widget; });
+	if (it == invalidatedWidgets.end())
+		invalidatedWidgets.push_back(&widget);
+}
+
+ScopedDrawCache::ScopedDrawCache(
+	Widget::Render_Params const& params,
+	Widget const& widget,
+	Rect const& widgetRect,
+	Rect const& visibleRect) :
+	drawInfo{ &params.drawInfo }
+{
+	auto& implData = params.ctx.Internal_ImplData();
+	auto& cache = implData.drawCache;
+	auto& rectCollection = params.rectCollection;
+
+	auto const selfEntryOpt = rectCollection.GetEntry(widget);
+	DENGINE_IMPL_GUI_ASSERT(selfEntryOpt.HasValue());
+	auto const& selfEntry = selfEntryOpt.Value();
+
+	auto const scissor = drawInfo->GetCurrentScissor();
+	auto const framebufferExtent = drawInfo->GetFramebufferExtent();
+
+	auto& entry = cache.entries[&widget];
+
+	bool canReplay =
+		entry.hasRetained &&
+		entry.widgetRect == widgetRect &&
+		entry.visibleRect == visibleRect &&
+		entry.framebufferExtent == framebufferExtent &&
+		entry.scissor.HasValue() == scissor.HasValue() &&
+		(!scissor.HasValue() || entry.scissor.Value() == scissor.Value());
+	if (canReplay) {
+		auto const invalidatedIt = Std::FindIf(
+			cache.invalidatedEntries.begin(),
+			cache.invalidatedEntries.end(),
+			[&](auto const& item) {
+				// Both the ancestors of an invalidated widget, and the caches nested within it, are outdated.
+				return
+					rectCollection.SubtreeContains(selfEntry, item) ||
+					rectCollection.SubtreeContains(item, selfEntry);
+			});
+		canReplay = invalidatedIt == cache.invalidatedEntries.end();
+	}
+
+	if (canReplay) {
+		impl::DrawCache_Replay(cache, entry, *drawInfo);
+		replayed = true;
+		return;
+	}
+
+	entry.widgetRect = widgetRect;
+	entry.visibleRect = visibleRect;
+	entry.scissor = scissor;
+	entry.framebufferExtent = framebufferExtent;
+	// The retained data no longer matches how this subtree is rendered.
+	entry.hasRetained = false;
+
+	auto& current = entry.current;
+	current = {};
+	current.vertexOffset = (u32)drawInfo->vertices->size();
+	current.indexOffset = (u32)drawInfo->indices->size();
+	current.drawCmdOffset = (u32)drawInfo->drawCmds->size();
+	current.glyphOffset = (u32)drawInfo->utfValues->size();
+	current.quadVertexOffset = drawInfo->quadVertexOffset;
+	current.quadIndexOffset = drawInfo->quadIndexOffset;
+	this->entry = &entry;
+}
+
+ScopedDrawCache::~ScopedDrawCache()
+{
+	if (!entry)
+		return;
+
+	DENGINE_IMPL_GUI_ASSERT(drawInfo->utfValues->size() == drawInfo->textGlyphRects->size());
+	auto& current = entry->current;
+	current.vertexCount = (u32)drawInfo->vertices->size() - current.vertexOffset;
+	current.indexCount = (u32)drawInfo->indices->size() - current.indexOffset;
+	current.drawCmdCount = (u32)drawInfo->drawCmds->size() - current.drawCmdOffset;
+	current.glyphCount = (u32)drawInfo->utfValues->size() - current.glyphOffset;
+	entry->rendered = true;
 }
 
 void Context::Event_Accessibility(
@@ -336,6 +673,7 @@ void Context::PushEvent(TextInputEvent const& event)
 	DENGINE_IMPL_GUI_ASSERT(windowNodePtr);
 	auto& windowNode = *windowNodePtr;
 	if (windowNode.data.topLayout) {
+		InvalidateLayout();
 		windowNode.data.topLayout->TextInput(
 			*this,
 			transientAlloc,
@@ -353,6 +691,7 @@ void Context::PushEvent(TextSelectionEvent const& event) {
 	DENGINE_IMPL_GUI_ASSERT(windowNodePtr);
 	auto& windowNode = *windowNodePtr;
 	if (windowNode.data.topLayout) {
+		InvalidateLayout();
 		windowNode.data.topLayout->TextSelection(
 			*this,
 			transientAlloc,
@@ -370,6 +709,7 @@ void Context::PushEvent(TextDeleteEvent const& event) {
 	DENGINE_IMPL_GUI_ASSERT(windowNodePtr);
 	auto& windowNode = *windowNodePtr;
 	if (windowNode.data.topLayout) {
+		InvalidateLayout();
 		windowNode.data.topLayout->TextDelete(
 			*this,
 			transientAlloc,
@@ -388,6 +728,7 @@ void Context::PushEvent(EndTextInputSessionEvent const& event)
 	DENGINE_IMPL_GUI_ASSERT(windowNodePtr);
 	auto& windowNode = *windowNodePtr;
 	if (windowNode.data.topLayout) {
+		InvalidateLayout();
 		windowNode.data.topLayout->EndTextInputSession(
 			*this,
 			transientAlloc,
@@ -408,14 +749,11 @@ void Context::PushEvent(CursorPressEvent const& event, Std::AnyRef appData)
 	implData.cursorWindowId = event.windowId;
 
 	impl::ImplData_PreDispatchStuff(implData);
-	impl::BuildRectCollection(
+	impl::UpdateCachedRectCollection(
 		*this,
 		implData,
 		textManager,
-		appData.ToConst(),
-		rectCollection,
-		false,
-		transientAlloc);
+		appData.ToConst());
 
 	if (windowNode.data.topLayout)
 	{
@@ -477,6 +815,10 @@ void Context::PushEvent(CursorPressEvent const& event, Std::AnyRef appData)
 			eventConsumed);
 	}
 
+	// Presses toggle, expand and collapse widgets,
+	// so we can't assume the layout survived.
+	InvalidateLayout();
+
 	impl::ImplData_FlushPostEventJobs(*this, appData);
 }
 
@@ -492,14 +834,11 @@ void Context::PushEvent(TouchMoveEvent const& event, Std::AnyRef appData)
 	auto& windowNode = *windowNodePtr;
 
 	impl::ImplData_PreDispatchStuff(implData);
-	impl::BuildRectCollection(
+	impl::UpdateCachedRectCollection(
 		*this,
 		implData,
 		textManager,
-		appData.ToConst(),
-		rectCollection,
-		false,
-		transientAlloc);
+		appData.ToConst());
 
 	if (windowNode.data.topLayout)
 	{
@@ -571,14 +910,11 @@ void Context::PushEvent(TouchPressEvent const& event, Std::AnyRef appData)
 	auto& windowNode = *windowNodePtr;
 
 	impl::ImplData_PreDispatchStuff(implData);
-	impl::BuildRectCollection(
+	impl::UpdateCachedRectCollection(
 		*this,
 		implData,
 		textManager,
-		appData.ToConst(),
-		rectCollection,
-		false,
-		transientAlloc);
+		appData.ToConst());
 
 	if (windowNode.data.topLayout)
 	{
@@ -633,6 +969,10 @@ void Context::PushEvent(TouchPressEvent const& event, Std::AnyRef appData)
 			eventConsumed);
 	}
 
+	// Presses toggle, expand and collapse widgets,
+	// so we can't assume the layout survived.
+	InvalidateLayout();
+
 	impl::ImplData_FlushPostEventJobs(*this, appData);
 }
 
@@ -648,14 +988,11 @@ void Context::PushEvent(CursorMoveEvent const& event, Std::AnyRef appData)
 	auto& windowNode = *windowNodePtr;
 
 	impl::ImplData_PreDispatchStuff(implData);
-	impl::BuildRectCollection(
+	impl::UpdateCachedRectCollection(
 		*this,
 		implData,
 		textManager,
-		appData.ToConst(),
-		rectCollection,
-		false,
-		transientAlloc);
+		appData.ToConst());
 
 	// Update the globally stored cursor position
 	implData.cursorPosition = event.position + windowNode.data.rect.position;
@@ -728,6 +1065,7 @@ void Context::PushEvent(WindowContentScaleEvent const& event)
 	auto& windowNode = *windowNodePtr;
 
 	windowNode.data.contentScale = event.scale;
+	InvalidateLayout();
 }
 
 void Context::PushEvent(WindowCursorExitEvent const& event)
@@ -750,6 +1088,7 @@ void Context::PushEvent(WindowCursorExitEvent const& event)
 			{
 				auto& widget = *windowNode.data.topLayout;
 				widget.CursorExit(*this);
+				InvalidateRendering();
 			}
 		}
 	}
@@ -769,6 +1108,7 @@ void Context::PushEvent(WindowFocusEvent const& event)
 		auto tempWindowNode = Std::Move(*windowNodeIt);
 		windowNodes.erase(windowNodeIt);
 		windowNodes.emplace(windowNodes.begin(), Std::Move(tempWindowNode));
+		InvalidateLayout();
 
 		// Call window focus gained event on widget?
 	}
@@ -784,6 +1124,7 @@ void Context::PushEvent(WindowMinimizeEvent const& event)
 	auto& windowNode = *windowNodePtr;
 
 	windowNode.data.isMinimized = event.wasMinimized;
+	InvalidateLayout();
 }
 
 void Context::PushEvent(WindowMoveEvent const& event)
@@ -810,6 +1151,7 @@ void Context::PushEvent(WindowResizeEvent const& event)
 	windowNode.data.rect.extent = event.extent;
 	windowNode.data.visibleOffset = event.safeAreaOffset;
 	windowNode.data.visibleExtent = event.safeAreaExtent;
+	InvalidateLayout();
 }
 
 void Context::Render2(Render2_Params const& params, Std::ConstAnyRef customData) const
@@ -828,6 +1170,13 @@ void Context::Render2(Render2_Params const& params, Std::ConstAnyRef customData)
 		true,
 		transientAlloc);
 
+	// The app may have changed the widget hierarchy since the last event,
+	// in which case the layout we dispatch pointer events with is outdated.
+	if (implData.rectCollectionIsValid && !implData.rectCollection.HasSameLayout(rectCollection))
+		implData.rectCollectionIsValid = false;
+
+	impl::DrawCache_BeginRender(*this, implData.drawCache, rectCollection);
+
 	for (auto const& windowNode : implData.windows)
 	{
 		if (!windowNode.data.topLayout || windowNode.data.isMinimized)
@@ -897,6 +1246,8 @@ void Context::Render2(Render2_Params const& params, Std::ConstAnyRef customData)
 
 		params.windowUpdates.push_back(newUpdate);
 	}
+
+	impl::DrawCache_EndRender(implData.drawCache, params);
 }
 
 void Context::AdoptWindow(AdoptWindowInfo&& windowInfo)
@@ -916,6 +1267,7 @@ void Context::AdoptWindow(AdoptWindowInfo&& windowInfo)
 	newNode.data.topLayout = Std::Move(windowInfo.widget);
 
 	implData.windows.emplace(implData.windows.begin(), Std::Move(newNode));
+	InvalidateLayout();
 }
 
 void Context::DestroyWindow(WindowID id)
@@ -926,6 +1278,7 @@ void Context::DestroyWindow(WindowID id)
 	DENGINE_IMPL_GUI_ASSERT(windowNodeIt != windows.end());
 
 	windows.erase(windowNodeIt);
+	InvalidateLayout();
 }
 
 void Context::PushPostEventJob_Inner(
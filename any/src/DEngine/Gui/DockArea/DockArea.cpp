@@ -86,10 +86,14 @@ bool DockArea::CursorMove(
 		.visibleRect = visibleRect,
 		.pointer = pointer, };
 
-	return DA_PointerMove(
+	auto const returnVal = DA_PointerMove(
 		temp,
 		occluded,
 		childDispatchFn);
+	// Moving layers, resizing splits and untabbing all change the layout.
+	if (!DA_GetStateData(*this).IsA<DA_State_Normal>())
+		params.ctx.InvalidateLayout();
+	return returnVal;
 }
 
 bool DockArea::CursorPress2(
@@ -168,10 +172,14 @@ bool DockArea::TouchMove2(
 		.visibleRect = visibleRect,
 		.pointer = pointer, };
 
-	return DA_PointerMove(
+	auto const returnVal = DA_PointerMove(
 		temp,
 		occluded,
 		childDispatchFn);
+	// Moving layers, resizing splits and untabbing all change the layout.
+	if (!DA_GetStateData(*this).IsA<DA_State_Normal>())
+		params.ctx.InvalidateLayout();
+	return returnVal;
 }
 
 bool DockArea::TouchPress2(
@@ -222,6 +230,7 @@ SizeHint DockArea::GetSizeHint2(Widget::GetSizeHint2_Params const& params) const
 	auto& textMgr = params.textManager;
 	auto& pusher = params.pusher;
 
+	auto const subtreeBegin = pusher.SubtreeBegin();
 	for (auto const& layerIt : DA_BuildLayerItPair(dockArea)) {
 		for (auto const& itResult : DA_BuildNodeItPair(
 			layerIt.node,
@@ -245,6 +254,7 @@ SizeHint DockArea::GetSizeHint2(Widget::GetSizeHint2_Params const& params) const
 	sizeHint.minimum = { 400, 400 };
 
 	auto entry = pusher.AddEntry(*this);
+	pusher.SetSubtreeBegin(entry, subtreeBegin);
 	auto& customData = pusher.AttachCustomData(entry, impl::DA_CustomData{});
 
 	auto normalTextScale = ctx.fontScale * window.contentScale;
@@ -478,6 +488,11 @@ void DockArea::Render2(
 	auto resizeHandleThickness = customData.resizeHandleThickness;
 	auto resizeHandleLength = customData.resizeHandleLength;
 
+	// Has to outlive the scissor, so that the scissor's pop is retained too.
+	ScopedDrawCache const drawCache { params, *this, widgetRect, visibleRect };
+	if (drawCache.Replayed())
+		return;
+
 	auto scopedScissor = DrawInfo::ScopedScissor(drawInfo,widgetRect, visibleRect);
 
 	for (auto const layerIt : DA_BuildLayerItPair(dockArea).Reverse()) {
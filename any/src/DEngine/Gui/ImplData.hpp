@@ -5,12 +5,16 @@
 #include <DEngine/Gui/WindowHandler.hpp>
 #include <DEngine/Gui/RectCollection.hpp>
 
+#include <DEngine/Gfx/Gfx.hpp>
+
 #include <DEngine/Std/BumpAllocator.hpp>
 #include <DEngine/Std/Containers/Box.hpp>
+#include <DEngine/Std/Containers/Opt.hpp>
 #include <DEngine/FixedWidthTypes.hpp>
 #include <DEngine/Math/Vector.hpp>
 
 #include <functional>
+#include <unordered_map>
 #include <vector>
 
 namespace DEngine::Gui
@@ -52,6 +56,69 @@ namespace DEngine::Gui::impl
 
 		Std::Box<Layer> frontmostLayer = {};
 	};
+
+	// Where a subtree's draw data lives in each of the draw data buffers.
+	// UTF values and glyph rects are pushed in pairs, so they share a range.
+	struct DrawRanges
+	{
+		u32 vertexOffset = 0;
+		u32 vertexCount = 0;
+		u32 indexOffset = 0;
+		u32 indexCount = 0;
+		u32 drawCmdOffset = 0;
+		u32 drawCmdCount = 0;
+		u32 glyphOffset = 0;
+		u32 glyphCount = 0;
+		// The quad mesh of the window the data was rendered into.
+		u32 quadVertexOffset = 0;
+		u32 quadIndexOffset = 0;
+	};
+
+	struct DrawCacheEntry
+	{
+		// What the draw data was rendered with, other than the state of the subtree itself.
+		Rect widgetRect = {};
+		Rect visibleRect = {};
+		Std::Opt<Rect> scissor;
+		Extent framebufferExtent = {};
+
+		// Location in the buffers retained from the previous render.
+		DrawRanges retained = {};
+		bool hasRetained = false;
+		// Location in the buffers of the render in progress.
+		DrawRanges current = {};
+		bool rendered = false;
+	};
+
+	// Draw data retained between renders, so that containers can replay
+	// the draw data of subtrees that have not changed.
+	// See ScopedDrawCache.
+	struct DrawCache
+	{
+		// Set when all retained draw data needs to be thrown out.
+		bool invalidated = true;
+		std::vector<Widget const*> invalidatedWidgets;
+
+		std::unordered_map<Widget const*, DrawCacheEntry> entries;
+
+		// Copy of everything emitted by the previous render.
+		std::vector<Gfx::GuiVertex> vertices;
+		std::vector<u32> indices;
+		std::vector<Gfx::GuiDrawCmd> drawCmds;
+		std::vector<u32> utfValues;
+		std::vector<Gfx::GlyphRect> textGlyphRects;
+
+		// The layout and context settings of the previous render.
+		std::vector<void const*> layoutWidgets;
+		std::vector<RectPair> layoutRects;
+		f32 fontScale = 0.f;
+		f32 minimumHeightCm = 0.f;
+		f32 defaultMarginFactor = 0.f;
+
+		// Entries of the invalidated widgets in the rect collection
+		// of the render in progress.
+		std::vector<RectCollection::It> invalidatedEntries;
+	};
 }
 
 struct DEngine::Gui::Context::Impl
@@ -75,7 +142,17 @@ struct DEngine::Gui::Context::Impl
 
 
 
+	// Layout used for dispatching pointer events. It is only rebuilt
+	// when something has invalidated it, so that a stream of cursor or touch
+	// movement does not redo the size hint and rect passes for every event.
 	RectCollection rectCollection;
+	// Mutable because the const Render2 can detect that the
+	// layout has changed since it was last built.
+	mutable bool rectCollectionIsValid = false;
+	// The context settings the rect collection was built with.
+	f32 rectCollectionFontScale = 0.f;
+	f32 rectCollectionMinimumHeightCm = 0.f;
+	f32 rectCollectionDefaultMarginFactor = 0.f;
 	Std::FrameAlloc transientAlloc = Std::FrameAlloc::PreAllocate(1024 * 1024).Value();
 
 	Std::FrameAlloc postEventAlloc = Std::FrameAlloc::PreAllocate(1024).Value();
@@ -87,5 +164,8 @@ struct DEngine::Gui::Context::Impl
 	};
 	std::vector<PostEventJob> postEventJobs;
 
+	// Mutable because it is updated by the const Render2.
+	mutable impl::DrawCache drawCache;
+
 	TextManager* textManager = nullptr;
 };
\ No newline at end of file
@@ -151,6 +151,7 @@ struct LineList::Impl
 		Math::Vec2 pos;
 	};
 	struct PointerMove_Params {
+		Context& ctx;
 		LineList& widget;
 		RectCollection const& rectCollection;
 		TextManager& textManager;
@@ -512,6 +513,7 @@ bool LineList::Impl::PointerMove(
 	auto const totalLineHeight = customData.totalLineHeight;
 
 	if (pointer.id == cursorPointerId) {
+		auto const oldCursorHover = widget.lineCursorHover;
 		if (!pointerInside || params.pointerOccluded) {
 			widget.lineCursorHover = Std::nullOpt;
 		}
@@ -525,6 +527,12 @@ bool LineList::Impl::PointerMove(
 			else
 				widget.lineCursorHover = Std::nullOpt;
 		}
+
+		if (oldCursorHover.HasValue() != widget.lineCursorHover.HasValue() ||
+			(oldCursorHover.HasValue() && oldCursorHover.Value() != widget.lineCursorHover.Value()))
+		{
+			params.ctx.InvalidateRendering(widget);
+		}
 	}
 
 	newOccluded = newOccluded || pointerInside;
@@ -567,6 +575,7 @@ bool LineList::CursorMove(
 	pointer.pos = { (f32)params.event.position.x, (f32)params.event.position.y };
 
 	Impl::PointerMove_Params temp = {
+		.ctx = params.ctx,
 		.widget = *this,
 		.rectCollection = params.rectCollection,
 		.textManager = params.textManager,
@@ -588,6 +597,7 @@ bool LineList::TouchMove2(
 	pointer.pos = params.event.position;
 
 	Impl::PointerMove_Params temp = {
+		.ctx = params.ctx,
 		.widget = *this,
 		.rectCollection = params.rectCollection,
 		.textManager = params.textManager,
@@ -94,6 +94,7 @@ namespace DEngine::Gui::impl {
 
 		struct MenuBtn_PointerMove_Params {
 			MenuButton& widget;
+			Context& ctx;
 			Rect widgetRect;
 			Rect visibleRect;
 			PointerMove_Pointer const& pointer;
@@ -1013,7 +1014,11 @@ bool Gui::impl::MenuBtnImpl::MenuBtn_PointerMove(
 		visibleRect.PointIsInside(pointer.pos);
 
 	if (pointer.id == cursorPointerId) {
-		widget.hoveredByCursor = pointerInside && !pointer.occluded;
+		auto const newHovered = pointerInside && !pointer.occluded;
+		if (widget.hoveredByCursor != newHovered) {
+			widget.hoveredByCursor = newHovered;
+			params.ctx.InvalidateRendering(widget);
+		}
 	}
 
 	bool newPointerOccluded = params.pointer.occluded;
@@ -1208,6 +1213,7 @@ bool MenuButton::CursorMove(
 
 	impl::MenuBtnImpl::MenuBtn_PointerMove_Params tempParams {
 		.widget = *this,
+		.ctx = params.ctx,
 		.widgetRect = widgetRect,
 		.visibleRect = visibleRect,
 		.pointer = pointer };
@@ -1252,6 +1258,7 @@ bool MenuButton::TouchMove2(
 
 	impl::MenuBtnImpl::MenuBtn_PointerMove_Params tempParams {
 		.widget = *this,
+		.ctx = params.ctx,
 		.widgetRect = widgetRect,
 		.visibleRect = visibleRect,
 		.pointer = pointer };
@@ -365,6 +365,7 @@ SizeHint ScrollArea::GetSizeHint2(Widget::GetSizeHint2_Params const& params) con
 {
 	auto& pusher = params.pusher;
 
+	auto const subtreeBegin = pusher.SubtreeBegin();
 	SizeHint childSizeHint = {};
 	if (child) {
 		childSizeHint = child->GetSizeHint2(params);
@@ -380,6 +381,7 @@ SizeHint ScrollArea::GetSizeHint2(Widget::GetSizeHint2_Params const& params) con
 	returnVal.expandY = true;
 
 	auto entry = pusher.AddEntry(*this);
+	pusher.SetSubtreeBegin(entry, subtreeBegin);
 	pusher.SetSizeHint(entry, returnVal);
 	return returnVal;
 }
@@ -427,6 +429,9 @@ void ScrollArea::Render2(
 	auto& drawInfo = params.drawInfo;
 	auto scrollbarThickness = CmToPixels(params.ctx.minimumHeightCm, params.window.dpiX);
 
+	ScopedDrawCache const drawCache { params, *this, widgetRect, visibleRect };
+	if (drawCache.Replayed())
+		return;
 
 	if (Rect::Intersection(widgetRect, visibleRect).IsNothing())
 		return;
@@ -524,7 +529,15 @@ bool ScrollArea::CursorMove(
 		.pointer = pointerMove,
 		.dispatchFn = dispatchFn, };
 
-	return impl::SA_Impl::PointerMove(temp);
+	auto const prevScrollbarPos = currScrollbarPos;
+	auto const prevScrollbarHovered = scrollbarHoveredByCursor;
+	auto const returnVal = impl::SA_Impl::PointerMove(temp);
+	// Scrolling moves the rect of our child.
+	if (currScrollbarPos != prevScrollbarPos)
+		params.ctx.InvalidateLayout();
+	else if (scrollbarHoveredByCursor != prevScrollbarHovered)
+		params.ctx.InvalidateRendering(*this);
+	return returnVal;
 }
 
 bool ScrollArea::CursorPress2(
@@ -597,7 +610,15 @@ bool ScrollArea::TouchMove2(
 		.pointer = pointerMove,
 		.dispatchFn = dispatchFn, };
 
-	return impl::SA_Impl::PointerMove(temp);
+	auto const prevScrollbarPos = currScrollbarPos;
+	auto const prevScrollbarHovered = scrollbarHoveredByCursor;
+	auto const returnVal = impl::SA_Impl::PointerMove(temp);
+	// Scrolling moves the rect of our child.
+	if (currScrollbarPos != prevScrollbarPos)
+		params.ctx.InvalidateLayout();
+	else if (scrollbarHoveredByCursor != prevScrollbarHovered)
+		params.ctx.InvalidateRendering(*this);
+	return returnVal;
 }
 
 bool ScrollArea::TouchPress2(
@@ -1,5 +1,6 @@
 #include <DEngine/Gui/StackLayout.hpp>
 
+#include <DEngine/Gui/Context.hpp>
 #include <DEngine/Gui/DrawInfo.hpp>
 
 #include <DEngine/Std/Containers/Defer.hpp>
@@ -428,6 +429,7 @@ SizeHint StackLayout::GetSizeHint2(GetSizeHint2_Params const& params) const
 
 	SizeHint returnVal = {};
 
+	auto const subtreeBegin = pusher.SubtreeBegin();
 	auto childSizeHints = Std::NewVec<SizeHint>(params.transientAlloc);
 	childSizeHints.Resize(childCount);
 	for (int i = 0; i < childCount; i += 1)
@@ -448,6 +450,7 @@ SizeHint StackLayout::GetSizeHint2(GetSizeHint2_Params const& params) const
 	returnValRefs.nonDir += padding * 2;
 
 	auto entry = pusher.AddEntry(*this);
+	pusher.SetSubtreeBegin(entry, subtreeBegin);
 	pusher.SetSizeHint(entry, returnVal);
 	return returnVal;
 }
@@ -613,6 +616,10 @@ void StackLayout::Render2(
 {
 	auto& rectColl = params.rectCollection;
 
+	ScopedDrawCache const drawCache { params, *this, widgetRect, visibleRect };
+	if (drawCache.Replayed())
+		return;
+
 	auto const innerRect = impl::BuildInnerRect(widgetRect, padding);
 	if (Rect::Intersection(innerRect, visibleRect).IsNothing())
 		return;
@@ -22,7 +22,17 @@
 // and move it into it's own header+source file
 // Or make an actually good public interface to use it.
 #include <unordered_map>
+#include <unordered_set>
 #include <functional>
+#include <cstring>
+#include <iterator>
+#include <list>
+#include <algorithm>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
 
 #include <ft2build.h>
 #include FT_FREETYPE_H
@@ -93,6 +103,10 @@ namespace DEngine::Gui::impl
 		FT_Glyph_Metrics internal_ftGlyphMetrics = {};
 		[[nodiscard]] auto const& FtGlyphMetrics() const { return internal_ftGlyphMetrics; }
 
+		// Which font in the fallback chain this glyph was taken from. 0 is the primary font.
+		u32 fontIndex = 0;
+		u32 ftGlyphIndex = 0;
+
 		[[nodiscard]] bool HasBitmap() const {
 			return internal_ftGlyphMetrics.width != 0;
 		}
@@ -121,13 +135,360 @@ namespace DEngine::Gui::impl
 		return (FontFaceSizeId)metrics.height;
 	}
 
+	// Picks the first font in the chain that has the glyph.
+	// If none of them do, we use the missing-glyph of the primary font.
+	// The pre-warm thread resolves glyphs with this too, so both agree on which font is used.
+	struct ResolvedGlyph {
+		u32 fontIndex = 0;
+		u32 ftGlyphIndex = 0;
+	};
+	template<class GetFaceFnT>
+	[[nodiscard]] ResolvedGlyph ResolveGlyph(u32 fontCount, GetFaceFnT const& getFace, u32 utfValue)
+	{
+		for (u32 i = 0; i < fontCount; i += 1) {
+			FT_Face face = getFace(i);
+			if (face == nullptr)
+				continue;
+			auto const ftGlyphIndex = FT_Get_Char_Index(face, utfValue);
+			if (ftGlyphIndex != 0)
+				return { i, ftGlyphIndex };
+		}
+		return {};
+	}
+
+	// Signed distance field glyphs are rendered once at this size, and then scaled to every text size.
+	constexpr u32 sdfGlyphPixelSize = 48;
+	// How far from the outline distances are stored, in texels of the distance field.
+	constexpr u32 sdfSpread = 6;
+	// The outline is rasterized this many times larger than the distance field,
+	// so the distances are accurate to a fraction of a texel.
+	constexpr u32 sdfSupersample = 4;
+	// The key all signed distance field glyphs are uploaded with. Can't collide with
+	// the key of a real size, since those are line heights.
+	constexpr auto sdfFontFaceSizeId = (FontFaceSizeId)(u64(-2));
+
+	void RequestSdfSize(FT_Face ftFace) {
+		auto ftError = FT_Set_Pixel_Sizes(ftFace, 0, sdfGlyphPixelSize * sdfSupersample);
+		if (ftError != FT_Err_Ok)
+			throw std::runtime_error("DEngine - TextManager: Unable to set pixel sizes");
+	}
+
+	// One dimensional squared Euclidean distance transform.
+	// From "Distance Transforms of Sampled Functions" by Felzenszwalb and Huttenlocher.
+	// v and z are scratch space, of length n and n + 1.
+	void DistanceTransform1D(f32 const* f, f32* d, int n, int* v, f32* z)
+	{
+		constexpr f32 inf = 1e20f;
+		int k = 0;
+		v[0] = 0;
+		z[0] = -inf;
+		z[1] = inf;
+		auto const intersection = [f, v](int q, int k) {
+			auto const p = v[k];
+			return ((f[q] + (f32)(q * q)) - (f[p] + (f32)(p * p))) / (f32)(2 * q - 2 * p);
+		};
+		for (int q = 1; q < n; q += 1) {
+			auto s = intersection(q, k);
+			// z[0] is -inf, so this never goes past the first parabola.
+			while (s <= z[k]) {
+				k -= 1;
+				s = intersection(q, k);
+			}
+			k += 1;
+			v[k] = q;
+			z[k] = s;
+			z[k + 1] = inf;
+		}
+		k = 0;
+		for (int q = 0; q < n; q += 1) {
+			while (z[k + 1] < (f32)q)
+				k += 1;
+			auto const p = v[k];
+			d[q] = (f32)((q - p) * (q - p)) + f[p];
+		}
+	}
+
+	// Two dimensional squared Euclidean distance transform, in place.
+	void DistanceTransform2D(std::vector<f32>& grid, int width, int height)
+	{
+		auto const maxLength = Math::Max(width, height);
+		std::vector<f32> f((uSize)maxLength);
+		std::vector<f32> d((uSize)maxLength);
+		std::vector<int> v((uSize)maxLength);
+		std::vector<f32> z((uSize)maxLength + 1);
+		for (int x = 0; x < width; x += 1) {
+			for (int y = 0; y < height; y += 1)
+				f[y] = grid[y * width + x];
+			DistanceTransform1D(f.data(), d.data(), height, v.data(), z.data());
+			for (int y = 0; y < height; y += 1)
+				grid[y * width + x] = d[y];
+		}
+		for (int y = 0; y < height; y += 1) {
+			DistanceTransform1D(&grid[y * width], d.data(), width, v.data(), z.data());
+			std::memcpy(&grid[y * width], d.data(), sizeof(f32) * width);
+		}
+	}
+
+	struct RenderedGlyph {
+		u32 width = 0;
+		u32 height = 0;
+		u32 pitch = 0;
+		f32 sdfPaddingX = 0.f;
+		f32 sdfPaddingY = 0.f;
+	};
+
+	// Turns a coverage bitmap, rasterized sdfSupersample times too large, into a signed distance field.
+	// The glyph is centered with at least sdfSpread texels around it.
+	// 128 is on the outline, larger values are inside.
+	[[nodiscard]] RenderedGlyph GenerateSdf(FT_Bitmap const& srcBitmap, std::vector<std::byte>& outData)
+	{
+		constexpr int supersample = (int)sdfSupersample;
+		auto const srcWidth = (int)srcBitmap.width;
+		auto const srcHeight = (int)srcBitmap.rows;
+
+		RenderedGlyph returnVal = {};
+		returnVal.width = (u32)((srcWidth + supersample - 1) / supersample + 2 * (int)sdfSpread);
+		returnVal.height = (u32)((srcHeight + supersample - 1) / supersample + 2 * (int)sdfSpread);
+		returnVal.pitch = returnVal.width;
+
+		auto const gridWidth = (int)returnVal.width * supersample;
+		auto const gridHeight = (int)returnVal.height * supersample;
+		auto const offsetX = (gridWidth - srcWidth) / 2;
+		auto const offsetY = (gridHeight - srcHeight) / 2;
+		returnVal.sdfPaddingX = (f32)offsetX / (f32)supersample;
+		returnVal.sdfPaddingY = (f32)offsetY / (f32)supersample;
+
+		auto const isInside = [&](int x, int y) {
+			x -= offsetX;
+			y -= offsetY;
+			if (x < 0 || y < 0 || x >= srcWidth || y >= srcHeight)
+				return false;
+			return srcBitmap.buffer[y * srcBitmap.pitch + x] >= 128;
+		};
+
+		// Squared distance to the nearest pixel inside, and to the nearest pixel outside.
+		constexpr f32 inf = 1e20f;
+		auto const gridSize = (uSize)gridWidth * (uSize)gridHeight;
+		std::vector<f32> toInside(gridSize);
+		std::vector<f32> toOutside(gridSize);
+		for (int y = 0; y < gridHeight; y += 1) {
+			for (int x = 0; x < gridWidth; x += 1) {
+				auto const inside = isInside(x, y);
+				toInside[y * gridWidth + x] = inside ? 0.f : inf;
+				toOutside[y * gridWidth + x] = inside ? inf : 0.f;
+			}
+		}
+		DistanceTransform2D(toInside, gridWidth, gridHeight);
+		DistanceTransform2D(toOutside, gridWidth, gridHeight);
+
+		auto const oldSize = outData.size();
+		outData.resize(oldSize + (uSize)returnVal.width * returnVal.height);
+		auto* dst = outData.data() + oldSize;
+		for (int y = 0; y < (int)returnVal.height; y += 1) {
+			for (int x = 0; x < (int)returnVal.width; x += 1) {
+				auto const gridX = x * supersample + supersample / 2;
+				auto const gridY = y * supersample + supersample / 2;
+				auto const gridIndex = gridY * gridWidth + gridX;
+				// The outline runs along the pixel borders, half a pixel from the pixel centers.
+				f32 dist = isInside(gridX, gridY) ?
+					Math::Sqrt(toOutside[gridIndex]) - 0.5f :
+					-(Math::Sqrt(toInside[gridIndex]) - 0.5f);
+				dist /= (f32)supersample;
+				auto const normalized = Math::Clamp(0.5f + dist / (2.f * (f32)sdfSpread), 0.f, 1.f);
+				dst[y * returnVal.width + x] = (std::byte)(u8)Math::Round(normalized * 255.f);
+			}
+		}
+
+		return returnVal;
+	}
+
+	// Renders the glyph currently loaded into the glyph slot of the face,
+	// and appends the bitmap to outData. Returns nullOpt if FreeType fails.
+	[[nodiscard]] Std::Opt<RenderedGlyph> RenderLoadedGlyph(
+		FT_Face face,
+		bool sdf,
+		std::vector<std::byte>& outData)
+	{
+		if (FT_Render_Glyph(face->glyph, FT_RENDER_MODE_NORMAL) != FT_Err_Ok)
+			return Std::nullOpt;
+		auto const& ftBitmap = face->glyph->bitmap;
+		if (sdf)
+			return GenerateSdf(ftBitmap, outData);
+
+		RenderedGlyph returnVal = {};
+		returnVal.width = ftBitmap.width;
+		returnVal.height = ftBitmap.rows;
+		returnVal.pitch = ftBitmap.pitch;
+		auto const* src = (std::byte const*)ftBitmap.buffer;
+		outData.insert(outData.end(), src, src + (uSize)ftBitmap.pitch * ftBitmap.rows);
+		return returnVal;
+	}
+
+	// Characters that are rasterized up front for every new font size.
+	[[nodiscard]] auto DefaultPrewarmCharacters() {
+		std::vector<u32> returnVal;
+		// Printable ASCII and Latin-1
+		for (u32 i = 32; i < 127; i += 1)
+			returnVal.push_back(i);
+		for (u32 i = 160; i < 256; i += 1)
+			returnVal.push_back(i);
+		return returnVal;
+	}
+
+	// System fonts with wide character coverage, added to the fallback chain if they exist.
+	// Android can only open files inside the APK, so there are none there.
+	[[nodiscard]] Std::Span<char const* const> DefaultFallbackFontPaths() {
+		if constexpr (App::activeOS == App::OS::Windows) {
+			static constexpr char const* paths[] = {
+				"C:/Windows/Fonts/segoeui.ttf",
+				"C:/Windows/Fonts/seguisym.ttf",
+				"C:/Windows/Fonts/msgothic.ttc" };
+			return { paths, sizeof(paths) / sizeof(paths[0]) };
+		} else if constexpr (App::activeOS == App::OS::Linux) {
+			static constexpr char const* paths[] = {
+				"/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf",
+				"/usr/share/fonts/TTF/DejaVuSans.ttf",
+				"/usr/share/fonts/truetype/noto/NotoSans-Regular.ttf",
+				"/usr/share/fonts/noto/NotoSans-Regular.ttf" };
+			return { paths, sizeof(paths) / sizeof(paths[0]) };
+		} else {
+			return {};
+		}
+	}
+
+	struct PrewarmJob {
+		FontFaceSizeId sizeId = FontFaceSizeId::Invalid;
+		std::function<void(FT_Face)> requestSizeFn;
+		// Sorted
+		std::shared_ptr<std::vector<u32> const> utfValues;
+		// The contents of every font in the fallback chain when this job was queued.
+		// The mappings live as long as the text manager.
+		std::vector<Std::Span<std::byte const>> fontDatas;
+		// Renders signed distance fields instead of bitmaps.
+		bool sdf = false;
+	};
+	struct PrewarmedGlyph {
+		u32 utfValue = 0;
+		u32 fontIndex = 0;
+		u32 ftGlyphIndex = 0;
+		FT_Glyph_Metrics ftGlyphMetrics = {};
+		RenderedGlyph bitmap = {};
+		// Offset into PrewarmResult::bitmapData
+		uSize bitmapOffset = 0;
+		uSize bitmapSize = 0;
+	};
+	struct PrewarmResult {
+		FontFaceSizeId sizeId = FontFaceSizeId::Invalid;
+		std::vector<PrewarmedGlyph> glyphs;
+		std::vector<std::byte> bitmapData;
+	};
+
+	// Rasterizes the pre-warm characters of new font sizes in the background,
+	// so that the first frame drawn at a new size doesn't stall on FreeType.
+	// FreeType objects can't be shared between threads, so the worker
+	// has its own library and opens its own faces on the same font memory.
+	struct PrewarmWorker {
+		std::thread thread;
+		std::mutex lock;
+		std::condition_variable condVar;
+		// Guarded by the lock
+		std::vector<PrewarmJob> jobs;
+		// Guarded by the lock
+		std::vector<PrewarmResult> results;
+	};
+
+	// The text manager is never destroyed, so neither is this thread.
+	void PrewarmThreadEntryPoint(PrewarmWorker* workerPtr)
+	{
+		Std::NameThisThread(Std::CStrToSpan("TextPrewarm"));
+
+		auto& worker = *workerPtr;
+
+		FT_Library ftLib = {};
+		if (FT_Init_FreeType(&ftLib) != FT_Err_Ok)
+			return;
+		// Indexed the same as the fallback chain. Null if the font failed to load.
+		std::vector<FT_Face> faces;
+
+		std::vector<PrewarmJob> jobs;
+		while (true) {
+			{
+				std::unique_lock lock{ worker.lock };
+				worker.condVar.wait(lock, [&worker]() { return !worker.jobs.empty(); });
+				std::swap(jobs, worker.jobs);
+			}
+
+			for (auto const& job : jobs) {
+				while (faces.size() < job.fontDatas.size()) {
+					auto const fontData = job.fontDatas[faces.size()];
+					FT_Face face = {};
+					auto ftError = FT_New_Memory_Face(
+						ftLib,
+						(FT_Byte const*)fontData.Data(),
+						(FT_Long)fontData.Size(),
+						0,
+						&face);
+					faces.push_back(ftError == FT_Err_Ok ? face : nullptr);
+				}
+				auto const fontCount = (u32)job.fontDatas.size();
+				auto const getFace = [&faces](u32 i) { return faces[i]; };
+
+				PrewarmResult result = {};
+				result.sizeId = job.sizeId;
+				bool sizeSet = true;
+				try {
+					for (u32 i = 0; i < fontCount; i += 1) {
+						if (faces[i] != nullptr)
+							job.requestSizeFn(faces[i]);
+					}
+				}
+				catch (std::runtime_error const&) {
+					sizeSet = false;
+				}
+
+				// Any glyph missing from the result is left to the main thread.
+				for (auto const utfValue : *job.utfValues) {
+					if (!sizeSet)
+						break;
+					auto const resolved = ResolveGlyph(fontCount, getFace, utfValue);
+					FT_Face face = faces[resolved.fontIndex];
+					if (face == nullptr)
+						continue;
+					auto const loadFlags = job.sdf ? FT_LOAD_NO_HINTING : FT_LOAD_DEFAULT;
+					if (FT_Load_Glyph(face, resolved.ftGlyphIndex, loadFlags) != FT_Err_Ok)
+						continue;
+
+					PrewarmedGlyph glyph = {};
+					glyph.utfValue = utfValue;
+					glyph.fontIndex = resolved.fontIndex;
+					glyph.ftGlyphIndex = resolved.ftGlyphIndex;
+					glyph.ftGlyphMetrics = face->glyph->metrics;
+					if (glyph.ftGlyphMetrics.width != 0) {
+						glyph.bitmapOffset = result.bitmapData.size();
+						auto const bitmapOpt = RenderLoadedGlyph(face, job.sdf, result.bitmapData);
+						if (!bitmapOpt.Has())
+							continue;
+						glyph.bitmap = bitmapOpt.Get();
+						glyph.bitmapSize = result.bitmapData.size() - glyph.bitmapOffset;
+					}
+					result.glyphs.push_back(glyph);
+				}
+
+				std::scoped_lock lock{ worker.lock };
+				worker.results.push_back(Std::Move(result));
+			}
+			jobs.clear();
+		}
+	}
+
 	struct TextManagerImpl
 	{
-		std::vector<u8> fontFileData;
+		// FreeType reads the font straight from this mapping, so it must outlive ftFace.
+		App::MappedFile fontFile;
 		FT_Library ftLib = {};
 
 		struct FontFaceSizeData {
-			void EnsureInit(FT_Face ftFace);
+			void EnsureInit(TextManagerImpl& implData);
 
 			std::function<void(FT_Face)> internal_requestSizeFn = {};
 			void RequestFtSize(FT_Face ftFace) const {
@@ -157,6 +518,14 @@ namespace DEngine::Gui::impl
 
 			std::vector<u32> glyphBitmapUploadJobs;
 
+			// The characters the pre-warm thread rasterizes for this size, sorted.
+			// Their bitmaps are uploaded from the pre-warm results, so they never get
+			// upload jobs of their own.
+			std::shared_ptr<std::vector<u32> const> prewarmSet;
+			[[nodiscard]] bool IsPrewarmed(u32 utfValue) const {
+				return prewarmSet && std::binary_search(prewarmSet->begin(), prewarmSet->end(), utfValue);
+			}
+
 			FontFaceSizeData() = default;
 			FontFaceSizeData(FontFaceSizeData const&) = delete;
 			FontFaceSizeData(FontFaceSizeData&&) = default;
@@ -170,18 +539,133 @@ namespace DEngine::Gui::impl
 		};
 		FT_Face ftFace = {};
 
+		// Searched in order for glyphs the primary font doesn't have.
+		struct FallbackFont {
+			App::MappedFile file;
+			FT_Face ftFace = {};
+		};
+		std::vector<FallbackFont> fallbackFonts;
+		[[nodiscard]] u32 FontCount() const { return 1 + (u32)fallbackFonts.size(); }
+		// Index 0 is the primary font.
+		[[nodiscard]] FT_Face GetFtFace(u32 fontIndex) const {
+			return fontIndex == 0 ? ftFace : fallbackFonts[fontIndex - 1].ftFace;
+		}
+		[[nodiscard]] Std::Span<std::byte const> GetFontData(u32 fontIndex) const {
+			return fontIndex == 0 ? fontFile.Data() : fallbackFonts[fontIndex - 1].file.Data();
+		}
+
+		PrewarmWorker prewarmWorker;
+		std::shared_ptr<std::vector<u32> const> prewarmCharacters;
+		void PushPrewarmJob(FontFaceSizeId sizeId, std::function<void(FT_Face)> const& requestSizeFn, bool sdf) {
+			PrewarmJob job = {};
+			job.sizeId = sizeId;
+			job.requestSizeFn = requestSizeFn;
+			job.utfValues = prewarmCharacters;
+			job.sdf = sdf;
+			for (u32 i = 0; i < FontCount(); i += 1)
+				job.fontDatas.push_back(GetFontData(i));
+			{
+				std::scoped_lock lock{ prewarmWorker.lock };
+				prewarmWorker.jobs.push_back(Std::Move(job));
+			}
+			prewarmWorker.condVar.notify_one();
+		}
+		void QueuePrewarm(FontFaceSizeId sizeId, FontFaceSizeData& sizeData) {
+			// Distance field glyphs are shared by all sizes, they are pre-warmed once instead.
+			if (glyphRenderMode == GlyphRenderMode::Sdf)
+				return;
+			if (!prewarmCharacters || prewarmCharacters->empty())
+				return;
+			sizeData.prewarmSet = prewarmCharacters;
+			PushPrewarmJob(sizeId, sizeData.internal_requestSizeFn, false);
+		}
+
+		GlyphRenderMode glyphRenderMode = GlyphRenderMode::Bitmap;
+		bool sdfFontFaceCreated = false;
+		// Every character a distance field has been queued for, either here or on the pre-warm thread.
+		std::unordered_set<u32> sdfGlyphsRequested;
+		std::vector<u32> sdfGlyphUploadJobs;
+		// The characters of the distance field pre-warm job, sorted.
+		std::shared_ptr<std::vector<u32> const> sdfPrewarmSet;
+		void RequestSdfGlyph(u32 utfValue) {
+			if (sdfGlyphsRequested.insert(utfValue).second)
+				sdfGlyphUploadJobs.push_back(utfValue);
+		}
+		void QueueSdfPrewarm() {
+			if (!prewarmCharacters || prewarmCharacters->empty())
+				return;
+			sdfGlyphsRequested.insert(prewarmCharacters->begin(), prewarmCharacters->end());
+			sdfPrewarmSet = prewarmCharacters;
+			PushPrewarmJob(sdfFontFaceSizeId, &RequestSdfSize, true);
+		}
+
 		FontFaceSizeData referenceSize = {};
 		std::vector<FontFaceNode> faceNodes;
+		// Maps the key of every node to its index in faceNodes.
+		std::unordered_map<FontFaceSizeId, uSize> faceNodeIndices;
 		[[nodiscard]] FontFaceNode* SearchFontSizeNode(FontFaceSizeId sizeId) {
-			auto nodeIt = Std::FindIf(
-				faceNodes.begin(),
-				faceNodes.end(),
-				[&](auto const& item) { return item.Key() == sizeId; });
-			if (nodeIt != faceNodes.end())
-				return &*nodeIt;
+			auto indexIt = faceNodeIndices.find(sizeId);
+			if (indexIt != faceNodeIndices.end())
+				return &faceNodes[indexIt->second];
 			else
 				return nullptr;
 		}
+		// Assumes there is no node with this key yet.
+		FontFaceNode& InsertFontSizeNode(FontFaceNode&& node) {
+			auto const key = node.Key();
+			DENGINE_IMPL_GUI_ASSERT(SearchFontSizeNode(key) == nullptr);
+			faceNodeIndices.insert({ key, faceNodes.size() });
+			faceNodes.emplace_back(Std::Move(node));
+			PushFontSizeIdUploadJob(key);
+			auto& newNode = faceNodes.back();
+			QueuePrewarm(key, newNode.sizeData);
+			return newNode;
+		}
+
+		// Every size request we have resolved before. Widgets ask for their size every
+		// layout and render pass, this lets them skip setting the size in FreeType
+		// just to find out which node it maps to.
+		// The floats are keyed on their exact bits.
+		struct SizeRequestKey {
+			u32 scale;
+			u32 dpiX;
+			u32 dpiY;
+			[[nodiscard]] bool operator==(SizeRequestKey const& other) const noexcept {
+				return scale == other.scale && dpiX == other.dpiX && dpiY == other.dpiY;
+			}
+		};
+		struct SizeRequestKeyHash {
+			[[nodiscard]] uSize operator()(SizeRequestKey const& in) const noexcept {
+				u64 hash = in.scale;
+				hash = hash * 0x9E3779B97F4A7C15ULL ^ in.dpiX;
+				hash = hash * 0x9E3779B97F4A7C15ULL ^ in.dpiY;
+				return (uSize)(hash ^ (hash >> 32));
+			}
+		};
+		std::unordered_map<SizeRequestKey, FontFaceSizeId, SizeRequestKeyHash> sizeRequestMemo;
+		// Same as above, for FontFaceSizeIdForLinePixelHeight.
+		// Keyed on the pixel height in the low bits and the TextHeightType in the high bits.
+		std::unordered_map<u64, FontFaceSizeId> linePixelHeightMemo;
+
+		// Most labels are measured with the same string and size every frame,
+		// so we keep the results of the most recent measurements around.
+		struct MeasureCacheEntry {
+			u64 hash = 0;
+			FontFaceSizeId sizeId = FontFaceSizeId::Invalid;
+			TextHeightType textHeightType = TextHeightType::Normal;
+			std::vector<u32> str;
+			Extent extent = {};
+			// One per glyph, relative to (0, 0).
+			std::vector<Rect> rects;
+		};
+		static constexpr uSize measureCacheCapacity = 1024;
+		using MeasureCacheListT = std::list<MeasureCacheEntry>;
+		// Most recently used entry first.
+		MeasureCacheListT measureCacheLru;
+		// Keyed on MeasureCacheEntry::hash. Different entries can share a hash.
+		std::unordered_multimap<u64, MeasureCacheListT::iterator> measureCacheIndex;
+		u64 measureCacheHitCount = 0;
+		u64 measureCacheMissCount = 0;
 
 		std::vector<FontFaceSizeId> fontFaceSizeUploadJobs;
 		void PushFontSizeIdUploadJob(FontFaceSizeId id) {
@@ -267,6 +751,14 @@ namespace DEngine::Gui::impl
 		f32 dpiX,
 		f32 dpiY)
 	{
+		TextManagerImpl::SizeRequestKey memoKey = {};
+		std::memcpy(&memoKey.scale, &scale, sizeof(scale));
+		std::memcpy(&memoKey.dpiX, &dpiX, sizeof(dpiX));
+		std::memcpy(&memoKey.dpiY, &dpiY, sizeof(dpiY));
+		auto const memoIt = implData.sizeRequestMemo.find(memoKey);
+		if (memoIt != implData.sizeRequestMemo.end())
+			return memoIt->second;
+
 		auto ftFace = implData.ftFace;
 
 		float sizeInPt = baseFontSize * scale;
@@ -296,28 +788,32 @@ namespace DEngine::Gui::impl
 			newNode.sizeData = LoadFontFaceSizeData(
 				ftFace,
 				requestFn);
-			implData.faceNodes.emplace_back(Std::Move(newNode));
-			implData.PushFontSizeIdUploadJob((FontFaceSizeId)key);
+			implData.InsertFontSizeNode(Std::Move(newNode));
 		}
 		// Otherwise just return the id.
+		implData.sizeRequestMemo.insert({ memoKey, (FontFaceSizeId)key });
 		return (FontFaceSizeId)key;
 	}
 
-	Std::Opt<GlyphData> LoadNewGlyph(
+	// Assumes the size has already been set on the primary font.
+	GlyphData LoadNewGlyph(
+		TextManagerImpl& implData,
 		TextManagerImpl::FontFaceSizeData& sizeData,
-		FT_Face face,
 		u32 utfValue)
 	{
 		DENGINE_IMPL_GUI_ASSERT(utfValue != 0);
 
-		// Load glyph data
-		FT_UInt glyphIndex = FT_Get_Char_Index(face, utfValue);
-		if (glyphIndex == 0) // 0 is an error index
-			return Std::nullOpt;
+		auto const resolved = ResolveGlyph(
+			implData.FontCount(),
+			[&implData](u32 i) { return implData.GetFtFace(i); },
+			utfValue);
+		FT_Face face = implData.GetFtFace(resolved.fontIndex);
+		if (resolved.fontIndex != 0)
+			sizeData.RequestFtSize(face);
 
 		FT_Error ftError = FT_Load_Glyph(
 			face,
-			glyphIndex,
+			resolved.ftGlyphIndex,
 			FT_LOAD_DEFAULT);
 		if (ftError == FT_Err_Invalid_Size_Handle)
 			throw std::runtime_error("FreeType: Invalid size handle when loading glyph.");
@@ -331,11 +827,16 @@ namespace DEngine::Gui::impl
 		 */
 
 		if (face->glyph->metrics.width != 0) {
-			sizeData.glyphBitmapUploadJobs.push_back(utfValue);
+			if (implData.glyphRenderMode == GlyphRenderMode::Sdf)
+				implData.RequestSdfGlyph(utfValue);
+			else if (!sizeData.IsPrewarmed(utfValue))
+				sizeData.glyphBitmapUploadJobs.push_back(utfValue);
 		}
 
 		GlyphData newData{};
 		newData.internal_ftGlyphMetrics = face->glyph->metrics;
+		newData.fontIndex = resolved.fontIndex;
+		newData.ftGlyphIndex = resolved.ftGlyphIndex;
 		return newData;
 	}
 
@@ -343,15 +844,9 @@ namespace DEngine::Gui::impl
 		TextManagerImpl& implData,
 		FontFaceSizeId sizeId)
 	{
-		auto nodeIt = Std::FindIf(
-		implData.faceNodes.begin(),
-		implData.faceNodes.end(),
-		[&](auto const& item) {
-			return item.Key() == sizeId;
-		});
-		DENGINE_IMPL_GUI_ASSERT(nodeIt != implData.faceNodes.end());
-		auto& node = *nodeIt;
-		return node.sizeData;
+		auto nodePtr = implData.SearchFontSizeNode(sizeId);
+		DENGINE_IMPL_GUI_ASSERT(nodePtr != nullptr);
+		return nodePtr->sizeData;
 	}
 
 	TextManagerImpl::FontFaceSizeData& GetFontFace(
@@ -364,46 +859,16 @@ namespace DEngine::Gui::impl
 		DENGINE_IMPL_GUI_ASSERT(inDpiX > 0.f);
 		DENGINE_IMPL_GUI_ASSERT(inDpiY > 0.f);
 
-		auto ftFace = implData.ftFace;
-
-		auto requestFn = [=](FT_Face ftFace) {
-			auto ftError = FT_Set_Char_Size(
-				ftFace,
-				0,
-				(int)Math::Round((f64)baseFontSize * (f64)inScale * (f64)(1 << 6)),
-				(u32)Math::Round(inDpiX),
-				(u32)Math::Round(inDpiY));
-			if (ftError != FT_Err_Ok) {
-				throw std::runtime_error("Unable to request size");
-			}
-		};
-		requestFn(ftFace);
-		auto targetKey = GenFontSizeKeyFrom(ftFace->size->metrics);
-
-		// Then search for it
-		auto nodePtr = implData.SearchFontSizeNode(targetKey);
-		if (nodePtr != nullptr) {
-			return nodePtr->sizeData;
-		} else {
-			// Load the new size
-			TextManagerImpl::FontFaceNode newNode = {};
-
-			newNode.sizeData = LoadFontFaceSizeData(
-				ftFace,
-				requestFn);
-			implData.faceNodes.emplace_back(Std::Move(newNode));
-			implData.PushFontSizeIdUploadJob(targetKey);
-
-			return implData.faceNodes.back().sizeData;
-		}
+		auto const sizeId = GetFontFaceSizeId(implData, inScale, inDpiX, inDpiY);
+		return GetFontSizeData(implData, sizeId);
 	}
 
 	auto const& GetGlyphData(
+		TextManagerImpl& implData,
 		TextManagerImpl::FontFaceSizeData& sizeData,
-		FT_Face ftFace,
 		u32 utfValue)
 	{
-		sizeData.EnsureInit(ftFace);
+		sizeData.EnsureInit(implData);
 
 		if (utfValue < sizeData.lowGlyphDatas.Size()) {
 			// ASCII values are already loaded, so we don't need to check if it is.
@@ -413,11 +878,11 @@ namespace DEngine::Gui::impl
 		{
 			auto glyphDataIt = sizeData.glyphDatas.find(utfValue);
 			if (glyphDataIt == sizeData.glyphDatas.end()) {
-				auto glyphOpt = LoadNewGlyph(sizeData, ftFace, utfValue);
-				if (!glyphOpt.Has())
-					throw std::runtime_error("Unable to load glyph");
+				// Size lookups are memoized and no longer leave the face at
+				// whatever size was asked for last, so set ours before loading.
+				sizeData.RequestFtSize(implData.ftFace);
 				glyphDataIt = sizeData.glyphDatas
-					.insert(std::pair{ utfValue, Std::Move(glyphOpt.Get()) })
+					.insert(std::pair{ utfValue, LoadNewGlyph(implData, sizeData, utfValue) })
 					.first;
 			}
 
@@ -442,27 +907,28 @@ void Gui::impl::InitializeTextManager(
 	if (ftError != FT_Err_Ok)
 		throw std::runtime_error("DEngine - Editor: Unable to initialize FreeType");
 
-	App::FileInputStream fontFile("data/gui/Roboto-Light.ttf");
-	if (!fontFile.IsOpen())
+	if (!implData.fontFile.Open("data/gui/Roboto-Light.ttf"))
 		throw std::runtime_error("DEngine - Editor: Unable to open font file.");
-	fontFile.Seek(0, App::FileInputStream::SeekOrigin::End);
-	u64 fileSize = fontFile.Tell().Value();
-	implData.fontFileData.resize((uSize)fileSize);
-	fontFile.Seek(0, App::FileInputStream::SeekOrigin::Start);
-	fontFile.Read((char*)implData.fontFileData.data(), fileSize);
-	fontFile.Close();
+	auto const fontFileData = implData.fontFile.Data();
 
 	FT_Face ftFace;
 	ftError = FT_New_Memory_Face(
 		implData.ftLib,
-		(FT_Byte const*)implData.fontFileData.data(),
-		(FT_Long)implData.fontFileData.size(),
+		(FT_Byte const*)fontFileData.Data(),
+		(FT_Long)fontFileData.Size(),
 		0,
 		&ftFace);
 	if (ftError != FT_Err_Ok)
 		throw std::runtime_error("DEngine - Text Manager: Unable to load font");
 	implData.ftFace = ftFace;
 
+	for (auto const* path : DefaultFallbackFontPaths())
+		manager.AddFallbackFont({ path, std::strlen(path) });
+
+	implData.prewarmCharacters = std::make_shared<std::vector<u32> const>(DefaultPrewarmCharacters());
+	implData.prewarmWorker.thread = std::thread(&PrewarmThreadEntryPoint, &implData.prewarmWorker);
+	implData.prewarmWorker.thread.detach();
+
 
 
 	{
@@ -542,22 +1008,19 @@ void Gui::impl::InitializeTextManager(
 }
 
 void Gui::impl::TextManagerImpl::FontFaceSizeData::EnsureInit(
-	FT_Face inFtFace)
+	TextManagerImpl& implData)
 {
 	if (initialized)
 		return;
 
-	this->RequestFtSize(inFtFace);
+	this->RequestFtSize(implData.ftFace);
 
 	// Loop over ASCII glyphs and load thmem
 	// Load all ASCII characters.
 
 
 	for (int i = 32; i < lowGlyphDatas.Size(); i += 1) {
-		auto glyphOpt = LoadNewGlyph(*this, inFtFace, (u32)i);
-		if (glyphOpt.Has()) {
-			this->lowGlyphDatas[i] = Std::Move(glyphOpt.Get());
-		}
+		this->lowGlyphDatas[i] = LoadNewGlyph(implData, *this, (u32)i);
 
 	}
 
@@ -567,7 +1030,7 @@ void Gui::impl::TextManagerImpl::FontFaceSizeData::EnsureInit(
 
 namespace DEngine::Gui::impl
 {
-	static Extent TextMan_GetOuterExtent2(
+	static Extent TextMan_MeasureUncached(
 		TextManager& textManager,
 		Std::RangeFnRef<u32> str,
 		FontFaceSizeId fontFaceSizedId,
@@ -591,8 +1054,8 @@ namespace DEngine::Gui::impl
 			DENGINE_IMPL_GUI_ASSERT(glyphChar != 0);
 
 			auto const& glyphData = impl::GetGlyphData(
+				implData,
 				sizeData,
-				implData.ftFace,
 				glyphChar);
 
 			if (i == 0)
@@ -623,6 +1086,104 @@ namespace DEngine::Gui::impl
 		return returnValue;
 	}
 
+	[[nodiscard]] static u64 HashMeasureKey(
+		Std::RangeFnRef<u32> str,
+		FontFaceSizeId sizeId,
+		TextHeightType textHeightType) noexcept
+	{
+		// FNV-1a
+		u64 hash = 0xcbf29ce484222325ULL;
+		auto const hashU64 = [&hash](u64 value) {
+			for (int i = 0; i < 8; i += 1) {
+				hash ^= (value >> (i * 8)) & 0xFF;
+				hash *= 0x100000001b3ULL;
+			}
+		};
+		hashU64((u64)sizeId);
+		hashU64((u64)textHeightType);
+		for (int i = 0; i < str.Size(); i += 1)
+			hashU64(str.Invoke(i));
+		return hash;
+	}
+
+	static Extent TextMan_GetOuterExtent2(
+		TextManager& textManager,
+		Std::RangeFnRef<u32> str,
+		FontFaceSizeId fontFaceSizedId,
+		TextHeightType textHeightType,
+		Std::Opt<Std::FnRef<void(int i, Rect const& outRect)>> const& outputRectFn)
+	{
+		auto& implData = GetImplData(textManager);
+		int const strLength = (int)str.Size();
+		auto const hash = HashMeasureKey(str, fontFaceSizedId, textHeightType);
+
+		auto const entryMatches = [&](TextManagerImpl::MeasureCacheEntry const& entry) {
+			if (entry.sizeId != fontFaceSizedId || entry.textHeightType != textHeightType)
+				return false;
+			if ((int)entry.str.size() != strLength)
+				return false;
+			for (int i = 0; i < strLength; i += 1) {
+				if (entry.str[i] != str.Invoke(i))
+					return false;
+			}
+			return true;
+		};
+
+		auto const [rangeBegin, rangeEnd] = implData.measureCacheIndex.equal_range(hash);
+		for (auto indexIt = rangeBegin; indexIt != rangeEnd; indexIt++) {
+			auto const entryIt = indexIt->second;
+			if (!entryMatches(*entryIt))
+				continue;
+
+			implData.measureCacheHitCount += 1;
+			// Move it to the front of the LRU list, this does not invalidate any iterators.
+			implData.measureCacheLru.splice(implData.measureCacheLru.begin(), implData.measureCacheLru, entryIt);
+			if (outputRectFn.Has()) {
+				for (int i = 0; i < strLength; i += 1)
+					outputRectFn.Get()(i, entryIt->rects[i]);
+			}
+			return entryIt->extent;
+		}
+
+		implData.measureCacheMissCount += 1;
+		TextManagerImpl::MeasureCacheEntry newEntry = {};
+		newEntry.hash = hash;
+		newEntry.sizeId = fontFaceSizedId;
+		newEntry.textHeightType = textHeightType;
+		newEntry.str.resize(strLength);
+		for (int i = 0; i < strLength; i += 1)
+			newEntry.str[i] = str.Invoke(i);
+		newEntry.rects.resize(strLength);
+		auto const storeRect = [&](int i, Rect const& rect) {
+			newEntry.rects[i] = rect;
+			if (outputRectFn.Has())
+				outputRectFn.Get()(i, rect);
+		};
+		newEntry.extent = TextMan_MeasureUncached(
+			textManager,
+			str,
+			fontFaceSizedId,
+			textHeightType,
+			{ storeRect });
+		auto const extent = newEntry.extent;
+
+		if (implData.measureCacheLru.size() >= TextManagerImpl::measureCacheCapacity) {
+			auto const oldestIt = std::prev(implData.measureCacheLru.end());
+			auto [oldBegin, oldEnd] = implData.measureCacheIndex.equal_range(oldestIt->hash);
+			for (auto indexIt = oldBegin; indexIt != oldEnd; indexIt++) {
+				if (indexIt->second == oldestIt) {
+					implData.measureCacheIndex.erase(indexIt);
+					break;
+				}
+			}
+			implData.measureCacheLru.erase(oldestIt);
+		}
+		implData.measureCacheLru.push_front(Std::Move(newEntry));
+		implData.measureCacheIndex.insert({ hash, implData.measureCacheLru.begin() });
+
+		return extent;
+	}
+
 	[[nodiscard]] static Extent TextMan_GetOuterExtent(
 		TextManager& textManager,
 		Std::RangeFnRef<u32> str,
@@ -663,6 +1224,72 @@ Extent Gui::TextManager::GetOuterExtent(
 		outRectFn);
 }
 
+TextManager::MeasureCacheStats TextManager::GetMeasureCacheStats() const
+{
+	auto const& implData = impl::GetImplData(*this);
+	MeasureCacheStats returnVal = {};
+	returnVal.hitCount = implData.measureCacheHitCount;
+	returnVal.missCount = implData.measureCacheMissCount;
+	returnVal.entryCount = implData.measureCacheLru.size();
+	return returnVal;
+}
+
+bool TextManager::AddFallbackFont(Std::Span<char const> path)
+{
+	using namespace impl;
+	auto& implData = GetImplData(*this);
+
+	TextManagerImpl::FallbackFont newFont = {};
+	std::string const pathString = { path.Data(), path.Size() };
+	if (!newFont.file.Open(pathString.c_str()))
+		return false;
+	auto const fontFileData = newFont.file.Data();
+	auto ftError = FT_New_Memory_Face(
+		implData.ftLib,
+		(FT_Byte const*)fontFileData.Data(),
+		(FT_Long)fontFileData.Size(),
+		0,
+		&newFont.ftFace);
+	if (ftError != FT_Err_Ok)
+		return false;
+	implData.fallbackFonts.push_back(Std::Move(newFont));
+	return true;
+}
+
+void TextManager::SetPrewarmCharacters(Std::Span<u32 const> utfValues)
+{
+	using namespace impl;
+	auto& implData = GetImplData(*this);
+
+	std::vector<u32> newCharacters;
+	for (auto const utfValue : utfValues) {
+		// 0 is never a valid character.
+		if (utfValue != 0)
+			newCharacters.push_back(utfValue);
+	}
+	std::sort(newCharacters.begin(), newCharacters.end());
+	newCharacters.erase(std::unique(newCharacters.begin(), newCharacters.end()), newCharacters.end());
+	implData.prewarmCharacters = std::make_shared<std::vector<u32> const>(Std::Move(newCharacters));
+}
+
+void TextManager::SetGlyphRenderMode(GlyphRenderMode mode)
+{
+	using namespace impl;
+	auto& implData = GetImplData(*this);
+
+	// Sizes that already exist have their glyphs in the old mode.
+	DENGINE_IMPL_GUI_ASSERT(implData.faceNodes.empty());
+	implData.glyphRenderMode = mode;
+	if (mode == GlyphRenderMode::Sdf && implData.sdfPrewarmSet == nullptr)
+		implData.QueueSdfPrewarm();
+}
+
+GlyphRenderMode TextManager::GetGlyphRenderMode() const
+{
+	auto const& implData = impl::GetImplData(*this);
+	return implData.glyphRenderMode;
+}
+
 u32 TextManager::GetLineheight(FontFaceSizeId sizeId, TextHeightType textHeightType) {
 	using namespace impl;
 	auto& implData = GetImplData(*this);
@@ -684,6 +1311,12 @@ FontFaceSizeId TextManager::FontFaceSizeIdForLinePixelHeight(
 	using namespace impl;
 
 	auto& implData = GetImplData(*this);
+
+	auto const memoKey = (u64)height | ((u64)textHeightType << 32);
+	auto const memoIt = implData.linePixelHeightMemo.find(memoKey);
+	if (memoIt != implData.linePixelHeightMemo.end())
+		return memoIt->second;
+
 	auto const& referenceSize = implData.referenceSize;
 
 	auto ftFace = implData.ftFace;
@@ -719,10 +1352,10 @@ FontFaceSizeId TextManager::FontFaceSizeIdForLinePixelHeight(
 		// Load the new size
 		TextManagerImpl::FontFaceNode newNode = {};
 		newNode.sizeData = LoadFontFaceSizeData(ftFace, requestFn);
-		implData.faceNodes.emplace_back(Std::Move(newNode));
-		implData.PushFontSizeIdUploadJob(targetKey);
+		implData.InsertFontSizeNode(Std::Move(newNode));
 	}
 
+	implData.linePixelHeightMemo.insert({ memoKey, (FontFaceSizeId)targetKey });
 	return (FontFaceSizeId)targetKey;
 }
 
@@ -796,11 +1429,105 @@ void TextManager::FlushQueuedJobs(Gfx::Context& gfxCtx)
 	auto& implData = GetImplData(*this);
 	auto ftFace = implData.ftFace;
 
+	// In signed distance field mode, every size is drawn with the same shared glyphs.
+	auto const sdfMode = implData.glyphRenderMode == GlyphRenderMode::Sdf;
+	auto const fontFaceType = sdfMode ? Gfx::FontFaceType::Sdf : Gfx::FontFaceType::Bitmap;
+	if (sdfMode && !implData.sdfFontFaceCreated) {
+		gfxCtx.NewFontFace((Gfx::FontFaceId)sdfFontFaceSizeId, fontFaceType);
+		implData.sdfFontFaceCreated = true;
+	}
 	for (auto const& item : implData.fontFaceSizeUploadJobs) {
-		gfxCtx.NewFontFace((Gfx::FontFaceId)item);
+		gfxCtx.NewFontFace((Gfx::FontFaceId)item, fontFaceType);
 	}
 	implData.fontFaceSizeUploadJobs.clear();
 
+	// Upload the bitmaps the pre-warm thread has finished.
+	std::vector<PrewarmResult> prewarmResults;
+	{
+		std::scoped_lock lock{ implData.prewarmWorker.lock };
+		std::swap(prewarmResults, implData.prewarmWorker.results);
+	}
+	std::vector<Gfx::FontBitmapUploadJob> prewarmUploadJobs;
+	for (auto const& result : prewarmResults) {
+		if (result.sizeId == sdfFontFaceSizeId) {
+			prewarmUploadJobs.clear();
+			for (auto const& glyph : result.glyphs) {
+				if (glyph.bitmapSize == 0)
+					continue;
+				Gfx::FontBitmapUploadJob job = {};
+				job.fontFaceId = (Gfx::FontFaceId)sdfFontFaceSizeId;
+				job.utfValue = glyph.utfValue;
+				job.width = glyph.bitmap.width;
+				job.height = glyph.bitmap.height;
+				job.pitch = glyph.bitmap.pitch;
+				job.data = { result.bitmapData.data() + glyph.bitmapOffset, glyph.bitmapSize };
+				job.sdfPaddingX = glyph.bitmap.sdfPaddingX;
+				job.sdfPaddingY = glyph.bitmap.sdfPaddingY;
+				prewarmUploadJobs.push_back(job);
+			}
+			if (!prewarmUploadJobs.empty())
+				gfxCtx.NewFontTextures({ prewarmUploadJobs.data(), prewarmUploadJobs.size() });
+			// Anything the thread could not render is left to us.
+			for (auto const utfValue : *implData.sdfPrewarmSet) {
+				auto const rendered = Std::FindIf(
+					result.glyphs.begin(),
+					result.glyphs.end(),
+					[utfValue](auto const& item) { return item.utfValue == utfValue; });
+				if (rendered == result.glyphs.end())
+					implData.sdfGlyphUploadJobs.push_back(utfValue);
+			}
+			continue;
+		}
+
+		auto& sizeData = impl::GetFontSizeData(implData, result.sizeId);
+
+		std::vector<u32> prewarmedUtfValues;
+		prewarmedUtfValues.reserve(result.glyphs.size());
+		prewarmUploadJobs.clear();
+		for (auto const& glyph : result.glyphs) {
+			prewarmedUtfValues.push_back(glyph.utfValue);
+			// Save the main thread from loading these again.
+			if (glyph.utfValue >= sizeData.lowGlyphDatas.Size() && !sizeData.glyphDatas.contains(glyph.utfValue)) {
+				GlyphData newData = {};
+				newData.internal_ftGlyphMetrics = glyph.ftGlyphMetrics;
+				newData.fontIndex = glyph.fontIndex;
+				newData.ftGlyphIndex = glyph.ftGlyphIndex;
+				sizeData.glyphDatas.insert({ glyph.utfValue, newData });
+			}
+			if (glyph.bitmapSize == 0)
+				continue;
+			Gfx::FontBitmapUploadJob job = {};
+			job.fontFaceId = (Gfx::FontFaceId)result.sizeId;
+			job.utfValue = glyph.utfValue;
+			job.width = glyph.bitmap.width;
+			job.height = glyph.bitmap.height;
+			job.pitch = glyph.bitmap.pitch;
+			job.data = { result.bitmapData.data() + glyph.bitmapOffset, glyph.bitmapSize };
+			prewarmUploadJobs.push_back(job);
+		}
+		if (!prewarmUploadJobs.empty())
+			gfxCtx.NewFontTextures({ prewarmUploadJobs.data(), prewarmUploadJobs.size() });
+
+		// Anything the thread could not rasterize is left to us, including
+		// glyphs that were loaded while it was working.
+		for (auto const utfValue : *sizeData.prewarmSet) {
+			if (std::binary_search(prewarmedUtfValues.begin(), prewarmedUtfValues.end(), utfValue))
+				continue;
+			GlyphData const* glyphData = nullptr;
+			if (utfValue < sizeData.lowGlyphDatas.Size()) {
+				if (sizeData.initialized)
+					glyphData = &sizeData.lowGlyphDatas[utfValue];
+			} else {
+				auto glyphDataIt = sizeData.glyphDatas.find(utfValue);
+				if (glyphDataIt != sizeData.glyphDatas.end())
+					glyphData = &glyphDataIt->second;
+			}
+			if (glyphData != nullptr && glyphData->HasBitmap())
+				sizeData.glyphBitmapUploadJobs.push_back(utfValue);
+		}
+		sizeData.prewarmSet = std::make_shared<std::vector<u32> const>(Std::Move(prewarmedUtfValues));
+	}
+
 	int ftError = {};
 	// Loop over all fonts and check if they have any upload jobs
 	for (auto& sizedFont : implData.faceNodes) {
@@ -814,25 +1541,29 @@ void TextManager::FlushQueuedJobs(Gfx::Context& gfxCtx)
 					int i = 0;
 				}
 
+				auto const& glyphData = utfValue < sizedFont.sizeData.lowGlyphDatas.Size() ?
+					sizedFont.sizeData.lowGlyphDatas[utfValue] :
+					sizedFont.sizeData.glyphDatas.at(utfValue);
+
 				// Render the glyph
-				auto ftGlyphIndex = FT_Get_Char_Index(ftFace, utfValue);
-				if (ftGlyphIndex == 0)
-					throw std::runtime_error("FreeType: tried to grab and render an invalid char index.");
+				auto glyphFace = implData.GetFtFace(glyphData.fontIndex);
+				if (glyphData.fontIndex != 0)
+					sizedFont.sizeData.RequestFtSize(glyphFace);
 
 				ftError = FT_Load_Glyph(
-					ftFace,
-					ftGlyphIndex,
+					glyphFace,
+					glyphData.ftGlyphIndex,
 					FT_LOAD_DEFAULT);
 				if (ftError == FT_Err_Invalid_Size_Handle)
 					throw std::runtime_error("FreeType: Invalid size handle when loading glyph.");
 				if (ftError != FT_Err_Ok)
 					throw std::runtime_error("Unable to load glyph");
 
-				ftError = FT_Render_Glyph(ftFace->glyph, FT_RENDER_MODE_NORMAL);
+				ftError = FT_Render_Glyph(glyphFace->glyph, FT_RENDER_MODE_NORMAL);
 				if (ftError != FT_Err_Ok)
 					throw std::runtime_error("Unable to render glyph");
 
-				auto const& ftBitmap = ftFace->glyph->bitmap;
+				auto const& ftBitmap = glyphFace->glyph->bitmap;
 				Gfx::FontBitmapUploadJob job = {};
 				job.fontFaceId = (Gfx::FontFaceId)sizedFont.Key();
 				job.utfValue = utfValue;
@@ -846,5 +1577,47 @@ void TextManager::FlushQueuedJobs(Gfx::Context& gfxCtx)
 		sizedFont.sizeData.glyphBitmapUploadJobs.clear();
 	}
 
+	// Distance fields for characters outside the pre-warm set.
+	if (!implData.sdfGlyphUploadJobs.empty()) {
+		std::vector<std::byte> sdfBitmapData;
+		std::vector<Gfx::FontBitmapUploadJob> sdfUploadJobs;
+		std::vector<uSize> sdfBitmapOffsets;
+		for (auto const utfValue : implData.sdfGlyphUploadJobs) {
+			auto const resolved = ResolveGlyph(
+				implData.FontCount(),
+				[&implData](u32 i) { return implData.GetFtFace(i); },
+				utfValue);
+			auto glyphFace = implData.GetFtFace(resolved.fontIndex);
+			RequestSdfSize(glyphFace);
+			ftError = FT_Load_Glyph(glyphFace, resolved.ftGlyphIndex, FT_LOAD_NO_HINTING);
+			if (ftError != FT_Err_Ok)
+				throw std::runtime_error("Unable to load glyph");
+			if (glyphFace->glyph->metrics.width == 0)
+				continue;
 
+			auto const bitmapOffset = sdfBitmapData.size();
+			auto const bitmapOpt = RenderLoadedGlyph(glyphFace, true, sdfBitmapData);
+			if (!bitmapOpt.Has())
+				throw std::runtime_error("Unable to render glyph");
+			auto const& bitmap = bitmapOpt.Get();
+			Gfx::FontBitmapUploadJob job = {};
+			job.fontFaceId = (Gfx::FontFaceId)sdfFontFaceSizeId;
+			job.utfValue = utfValue;
+			job.width = bitmap.width;
+			job.height = bitmap.height;
+			job.pitch = bitmap.pitch;
+			job.sdfPaddingX = bitmap.sdfPaddingX;
+			job.sdfPaddingY = bitmap.sdfPaddingY;
+			sdfUploadJobs.push_back(job);
+			sdfBitmapOffsets.push_back(bitmapOffset);
+		}
+		// The data can only be pointed to once it is done growing.
+		for (uSize i = 0; i < sdfUploadJobs.size(); i += 1) {
+			auto& job = sdfUploadJobs[i];
+			job.data = { sdfBitmapData.data() + sdfBitmapOffsets[i], (uSize)job.pitch * job.height };
+		}
+		if (!sdfUploadJobs.empty())
+			gfxCtx.NewFontTextures({ sdfUploadJobs.data(), sdfUploadJobs.size() });
+		implData.sdfGlyphUploadJobs.clear();
+	}
 }
\ No newline at end of file
@@ -0,0 +1,249 @@
+#include <DEngine/Jobs.hpp>
+
+#include <DEngine/impl/Assert.hpp>
+#include <DEngine/Std/Utility.hpp>
+#include <DEngine/Std/Containers/Box.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace DEngine;
+using namespace DEngine::Jobs;
+
+namespace DEngine::Jobs
+{
+	struct Job
+	{
+		JobFn fn = nullptr;
+		void* userData = nullptr;
+		uSize begin = 0;
+		uSize end = 0;
+		Counter* counter = nullptr;
+	};
+
+	struct WorkerQueue
+	{
+		std::mutex lock;
+		std::deque<Job> jobs;
+	};
+
+	class SchedulerImpl
+	{
+	public:
+		std::vector<std::thread> threads;
+		// One queue per worker thread.
+		std::vector<Std::Box<WorkerQueue>> queues;
+
+		// Threads that are not workers push round-robin onto the worker queues.
+		std::atomic<uSize> externalPushIndex = 0;
+
+		// Amount of jobs currently sitting in queues. Used to let workers sleep.
+		std::atomic<uSize> queuedJobCount = 0;
+		std::mutex sleepLock;
+		std::condition_variable sleepCondVar;
+		bool shutdown = false;
+
+		static void RunJob(Job const& job)
+		{
+			job.fn(job.userData, job.begin, job.end);
+			job.counter->pending.fetch_sub(1, std::memory_order_acq_rel);
+		}
+	};
+}
+
+namespace DEngine::Jobs::impl
+{
+	// Identifies which scheduler the current thread is a worker of, if any.
+	static thread_local SchedulerImpl const* tl_workerOwner = nullptr;
+	static thread_local uSize tl_workerIndex = 0;
+
+	[[nodiscard]] static bool IsWorkerOf(SchedulerImpl const& implData) noexcept
+	{
+		return tl_workerOwner == &implData;
+	}
+
+	[[nodiscard]] static bool TryPopOwn(SchedulerImpl& implData, uSize queueIndex, Job& outJob)
+	{
+		auto& queue = *implData.queues[queueIndex];
+		std::scoped_lock lock{ queue.lock };
+		if (queue.jobs.empty())
+			return false;
+		outJob = queue.jobs.back();
+		queue.jobs.pop_back();
+		implData.queuedJobCount.fetch_sub(1, std::memory_order_relaxed);
+		return true;
+	}
+
+	[[nodiscard]] static bool TrySteal(SchedulerImpl& implData, uSize startIndex, Job& outJob)
+	{
+		auto const queueCount = implData.queues.size();
+		for (uSize i = 0; i < queueCount; i += 1)
+		{
+			auto& queue = *implData.queues[(startIndex + i) % queueCount];
+			std::scoped_lock lock{ queue.lock };
+			if (queue.jobs.empty())
+				continue;
+			outJob = queue.jobs.front();
+			queue.jobs.pop_front();
+			implData.queuedJobCount.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+		return false;
+	}
+
+	[[nodiscard]] static bool TryGetJob(SchedulerImpl& implData, Job& outJob)
+	{
+		if (implData.queues.empty())
+			return false;
+		if (IsWorkerOf(implData))
+		{
+			if (TryPopOwn(implData, tl_workerIndex, outJob))
+				return true;
+			return TrySteal(implData, tl_workerIndex + 1, outJob);
+		}
+		return TrySteal(implData, 0, outJob);
+	}
+
+	static void WorkerEntryPoint(SchedulerImpl* implDataPtr, uSize workerIndex)
+	{
+		auto& implData = *implDataPtr;
+		tl_workerOwner = &implData;
+		tl_workerIndex = workerIndex;
+
+		std::string name = "JobWorker #" + std::to_string(workerIndex);
+		Std::NameThisThread({ name.data(), name.size() });
+
+		while (true)
+		{
+			Job job = {};
+			if (TryGetJob(implData, job))
+			{
+				SchedulerImpl::RunJob(job);
+				continue;
+			}
+
+			std::unique_lock lock{ implData.sleepLock };
+			implData.sleepCondVar.wait(lock, [&implData]() {
+				return implData.shutdown || implData.queuedJobCount.load(std::memory_order_relaxed) > 0;
+			});
+			if (implData.shutdown)
+				break;
+		}
+	}
+}
+
+Jobs::Scheduler::Scheduler(Scheduler&& other) noexcept :
+	implData{ other.implData }
+{
+	other.implData = nullptr;
+}
+
+Jobs::Scheduler& Jobs::Scheduler::operator=(Scheduler&& other) noexcept
+{
+	if (this == &other)
+		return *this;
+	this->~Scheduler();
+	implData = other.implData;
+	other.implData = nullptr;
+	return *this;
+}
+
+Jobs::Scheduler::~Scheduler()
+{
+	if (!implData)
+		return;
+
+	{
+		std::scoped_lock lock{ implData->sleepLock };
+		implData->shutdown = true;
+	}
+	implData->sleepCondVar.notify_all();
+	for (auto& thread : implData->threads)
+		thread.join();
+
+	delete implData;
+	implData = nullptr;
+}
+
+Jobs::Scheduler Jobs::Scheduler::Create(uSize workerCount)
+{
+	if (workerCount == 0)
+	{
+		auto const hwThreads = (uSize)std::thread::hardware_concurrency();
+		workerCount = hwThreads > 1 ? hwThreads - 1 : 1;
+	}
+
+	Scheduler returnVal;
+	returnVal.implData = new SchedulerImpl;
+	auto& implData = *returnVal.implData;
+
+	implData.queues.reserve(workerCount);
+	for (uSize i = 0; i < workerCount; i += 1)
+		implData.queues.push_back(Std::Box{ new WorkerQueue });
+	implData.threads.reserve(workerCount);
+	for (uSize i = 0; i < workerCount; i += 1)
+		implData.threads.emplace_back(&impl::WorkerEntryPoint, &implData, i);
+
+	return returnVal;
+}
+
+uSize Jobs::Scheduler::GetThreadCount() const noexcept
+{
+	DENGINE_IMPL_ASSERT(implData);
+	return implData->threads.size() + 1;
+}
+
+void Jobs::Scheduler::Submit(JobFn fn, void* userData, uSize begin, uSize end, Counter& counter)
+{
+	DENGINE_IMPL_ASSERT(implData);
+	DENGINE_IMPL_ASSERT(fn);
+	auto& implData = *this->implData;
+
+	counter.pending.fetch_add(1, std::memory_order_relaxed);
+
+	Job job = {};
+	job.fn = fn;
+	job.userData = userData;
+	job.begin = begin;
+	job.end = end;
+	job.counter = &counter;
+
+	uSize queueIndex = 0;
+	if (impl::IsWorkerOf(implData))
+		queueIndex = impl::tl_workerIndex;
+	else
+		queueIndex = implData.externalPushIndex.fetch_add(1, std::memory_order_relaxed) % implData.queues.size();
+
+	{
+		auto& queue = *implData.queues[queueIndex];
+		std::scoped_lock lock{ queue.lock };
+		queue.jobs.push_back(job);
+		implData.queuedJobCount.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	{
+		// Taking the lock makes sure a worker can't miss the wakeup
+		// between checking the job count and going to sleep.
+		std::scoped_lock lock{ implData.sleepLock };
+	}
+	implData.sleepCondVar.notify_one();
+}
+
+void Jobs::Scheduler::Wait(Counter& counter)
+{
+	DENGINE_IMPL_ASSERT(implData);
+	auto& implData = *this->implData;
+
+	while (!counter.IsDone())
+	{
+		Job job = {};
+		if (impl::TryGetJob(implData, job))
+			SchedulerImpl::RunJob(job);
+		else
+			std::this_thread::yield();
+	}
+}
@@ -5,19 +5,35 @@ using namespace DEngine;
 void Scene::Copy(Scene& output) const
 {
 	output.entities = entities;
-	output.entityIdIncrementor = entityIdIncrementor;
 	output.moves = moves;
 	output.rigidBodies = rigidBodies;
 	output.textureIDs = textureIDs;
 	output.transforms = transforms;
+	output.spriteGroupSize = spriteGroupSize;
+	output.entitySlots = entitySlots;
+	output.freeEntityIndices = freeEntityIndices;
 
 	// Don't need to copy physics world, it's not initialized anyways.
 }
 
 Entity Scene::NewEntity() noexcept
 {
-	Entity returnVal = (Entity)entityIdIncrementor;
-	entityIdIncrementor += 1;
+	u32 index = 0;
+	if (!freeEntityIndices.empty())
+	{
+		index = freeEntityIndices.back();
+		freeEntityIndices.pop_back();
+	}
+	else
+	{
+		index = (u32)entitySlots.size();
+		entitySlots.push_back({});
+	}
+
+	auto& slot = entitySlots[index];
+	DENGINE_IMPL_ASSERT(slot.listIndex == impl::invalidSlot);
+	slot.listIndex = (u32)entities.size();
+	Entity returnVal = impl::MakeEntity(index, slot.generation);
 	entities.push_back(returnVal);
 	return returnVal;
 }
@@ -28,26 +44,70 @@ void Scene::DeleteEntity(Entity ent) noexcept
 	DeleteComponent_CanFail<Transform>(ent);
 	DeleteComponent_CanFail<Gfx::TextureID>(ent);
 	DeleteComponent_CanFail<Move>(ent);
+	if (auto rbPtr = GetComponent<Physics::Rigidbody2D>(ent))
+	{
+		if (physicsWorld && rbPtr->b2BodyPtr)
+			physicsWorld->DestroyBody((b2Body*)rbPtr->b2BodyPtr);
+		DeleteComponent<Physics::Rigidbody2D>(ent);
+	}
 
-	for (uSize i = 0; i < entities.size(); i += 1)
+	auto const index = impl::GetEntityIndex(ent);
+	auto& slot = entitySlots[index];
+
+	// Swap-and-pop the entity out of the entity list.
+	auto const lastListIndex = (u32)entities.size() - 1;
+	if (slot.listIndex != lastListIndex)
 	{
-		if (ent == entities[i])
-		{
-			entities.erase(entities.begin() + i);
-			break;
-		}
+		entities[slot.listIndex] = entities[lastListIndex];
+		entitySlots[impl::GetEntityIndex(entities[slot.listIndex])].listIndex = slot.listIndex;
 	}
+	entities.pop_back();
+
+	// Bumping the generation invalidates all existing handles to this entity.
+	slot.listIndex = impl::invalidSlot;
+	slot.generation += 1;
+	freeEntityIndices.push_back(index);
 }
 
 // Confirm that this entity exists.
 bool Scene::ValidateEntity(Entity entity) const noexcept
 {
-	for (auto const& item : entities)
-	{
-		if (item == entity)
-			return true;
-	}
-	return false;
+	auto const index = impl::GetEntityIndex(entity);
+	if (index >= entitySlots.size())
+		return false;
+	auto const& slot = entitySlots[index];
+	return slot.listIndex != impl::invalidSlot && slot.generation == impl::GetEntityGeneration(entity);
+}
+
+void Scene::Impl_SpriteGroup_Added(Entity entity) noexcept
+{
+	auto const transformSlot = transforms.GetSlot(entity);
+	auto const textureSlot = textureIDs.GetSlot(entity);
+	if (transformSlot == impl::invalidSlot || textureSlot == impl::invalidSlot)
+		return;
+
+	// The entity just got its second component, so it can't already be in the group.
+	DENGINE_IMPL_ASSERT(transformSlot >= spriteGroupSize || textureSlot >= spriteGroupSize);
+	transforms.SwapSlots(transformSlot, (u32)spriteGroupSize);
+	textureIDs.SwapSlots(textureSlot, (u32)spriteGroupSize);
+	spriteGroupSize += 1;
+}
+
+void Scene::Impl_SpriteGroup_Removing(Entity entity) noexcept
+{
+	auto const transformSlot = transforms.GetSlot(entity);
+	auto const textureSlot = textureIDs.GetSlot(entity);
+	if (transformSlot == impl::invalidSlot || textureSlot == impl::invalidSlot)
+		return;
+
+	// Move the entity to the end of the group and shrink the group.
+	// Both slots are then outside of the group, so the swap-and-pop
+	// that follows can't disturb the group ordering.
+	DENGINE_IMPL_ASSERT(transformSlot == textureSlot && transformSlot < spriteGroupSize);
+	auto const lastGroupSlot = (u32)spriteGroupSize - 1;
+	transforms.SwapSlots(transformSlot, lastGroupSlot);
+	textureIDs.SwapSlots(textureSlot, lastGroupSlot);
+	spriteGroupSize -= 1;
 }
 
 void Scene::Begin()
@@ -57,13 +117,11 @@ void Scene::Begin()
 	auto physWorld = new b2World({ 0.f, -10.f });
 	physicsWorld = Std::Box{ physWorld };
 
-	for (auto& [entity, rb] : GetAllComponents<Physics::Rigidbody2D>())
+	View<Physics::Rigidbody2D, Transform const>().ForEach([physWorld](
+		Entity entity,
+		Physics::Rigidbody2D& rb,
+		Transform const& transform)
 	{
-		auto transformPtr = GetComponent<Transform>(entity);
-		if (!transformPtr)
-			continue;
-		auto const& transform = *transformPtr;
-
 		b2BodyDef bodyDef = {};
 		bodyDef.angle = transform.rotation;
 		bodyDef.awake = true;
@@ -96,5 +154,5 @@ void Scene::Begin()
 		fixtureDef.shape = &shape;
 
 		newBody->CreateFixture(&fixtureDef);
-	}
-}
\ No newline at end of file
+	});
+}
@@ -0,0 +1,77 @@
+#include <DEngine/SystemSchedule.hpp>
+
+#include <DEngine/impl/Assert.hpp>
+
+#include <memory>
+
+using namespace DEngine;
+
+void SystemSchedule::Impl_AddSystem(System&& newSystem)
+{
+	auto const newIndex = (u32)systems.size();
+
+	for (auto& existing : systems)
+	{
+		bool const conflicts =
+			existing.exclusive ||
+			newSystem.exclusive ||
+			(existing.writeMask & (newSystem.readMask | newSystem.writeMask)) != 0 ||
+			(newSystem.writeMask & existing.readMask) != 0;
+		if (conflicts)
+		{
+			existing.dependents.push_back(newIndex);
+			newSystem.dependencyCount += 1;
+		}
+	}
+
+	systems.push_back(Std::Move(newSystem));
+}
+
+struct SystemSchedule::RunState
+{
+	Scene* scene = nullptr;
+	Jobs::Scheduler* scheduler = nullptr;
+	Jobs::Counter* counter = nullptr;
+	Std::Span<System const> systems;
+	std::unique_ptr<std::atomic<u32>[]> remainingDependencies;
+};
+
+void SystemSchedule::Impl_RunSystem(void* userData, uSize begin, uSize end)
+{
+	auto& run = *static_cast<RunState*>(userData);
+	auto const& system = run.systems[begin];
+
+	system.fn(*run.scene, *run.scheduler);
+
+	// Launch every system that was only waiting on this one.
+	for (auto const dependent : system.dependents)
+	{
+		if (run.remainingDependencies[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1)
+			run.scheduler->Submit(&Impl_RunSystem, &run, dependent, dependent + 1, *run.counter);
+	}
+}
+
+void SystemSchedule::Run(Scene& scene, Jobs::Scheduler& scheduler)
+{
+	if (systems.empty())
+		return;
+
+	Jobs::Counter counter;
+
+	RunState run = {};
+	run.scene = &scene;
+	run.scheduler = &scheduler;
+	run.counter = &counter;
+	run.systems = { systems.data(), systems.size() };
+	run.remainingDependencies = std::make_unique<std::atomic<u32>[]>(systems.size());
+	for (uSize i = 0; i < systems.size(); i += 1)
+		run.remainingDependencies[i].store(systems[i].dependencyCount, std::memory_order_relaxed);
+
+	for (uSize i = 0; i < systems.size(); i += 1)
+	{
+		if (systems[i].dependencyCount == 0)
+			scheduler.Submit(&Impl_RunSystem, &run, i, i + 1, counter);
+	}
+
+	scheduler.Wait(counter);
+}
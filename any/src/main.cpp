@@ -2,7 +2,9 @@
 #include "DEngine/Editor/Editor.hpp"
 #include "DEngine/Gfx/Gfx.hpp"
 
+#include <DEngine/Jobs.hpp>
 #include <DEngine/Scene.hpp>
+#include <DEngine/SystemSchedule.hpp>
 #include <DEngine/Time.hpp>
 
 #include <DEngine/Gui/Context.hpp>
@@ -19,6 +21,7 @@
 #include <string>
 #include <filesystem>
 #include <cstdlib>
+#include <chrono>
 
 #ifdef DENGINE_TRACY_LINKED
 	#include <tracy/Tracy.hpp>
@@ -123,7 +126,8 @@ namespace DEngine::impl
 		Gfx::WsiInterface& wsiConnection,
 		Gfx::TextureAssetInterface const& textureAssetConnection,
 		Gfx::LogInterface& logger,
-		Std::Span<char const*> requiredVkInstanceExtensions)
+		Std::Span<char const*> requiredVkInstanceExtensions,
+		u8 frameQueueDepth)
 	{
 		Gfx::InitInfo rendererInitInfo = {};
 		rendererInitInfo.wsiConnection = &wsiConnection;
@@ -133,6 +137,11 @@ namespace DEngine::impl
 		rendererInitInfo.gizmoArrowMesh = Editor::BuildGizmoTranslateArrowMesh2D();
 		rendererInitInfo.gizmoCircleLineMesh = Editor::BuildGizmoTorusMesh2D();
 		rendererInitInfo.gizmoArrowScaleMesh2d = Editor::BuildGizmoScaleArrowMesh2D();
+		// The working directory is not writable on Android.
+		if constexpr (App::activeOS != App::OS::Android)
+			rendererInitInfo.pipelineCachePath = "data/pipeline_cache.bin";
+		rendererInitInfo.textureArchivePath = "data/textures.pack";
+		rendererInitInfo.frameQueueDepth = frameQueueDepth;
 		Std::Opt<Gfx::Context> rendererDataOpt = Gfx::Initialize(rendererInitInfo);
 		if (!rendererDataOpt.HasValue())
 		{
@@ -146,13 +155,18 @@ namespace DEngine::impl
 		Scene& scene);
 
 	void RunPhysicsStep(
-		Scene& scene);
+		Scene& scene,
+		Jobs::Scheduler& jobScheduler);
 	
 	void SubmitRendering(
 		Gfx::Context& gfxData,
 		App::Context& appCtx,
 		Editor::Context& editorCtx,
 		Scene const& scene);
+
+	// Runs the component joins of a frame on increasingly large scenes
+	// and prints the timings. Frame cost should grow linearly with entity count.
+	void RunSceneBenchmark();
 }
 
 /*
@@ -298,6 +312,11 @@ namespace DEngine::impl
 
 int DENGINE_MAIN_ENTRYPOINT(int argc, char** argv)
 {
+	if (argc == 2 && strcmp(argv[1], "-scenebench") == 0) {
+		DEngine::impl::RunSceneBenchmark();
+		return 0;
+	}
+
 	if (argc == 3) {
 		if (strcmp(argv[1], "-ra") == 0) {
 			auto path = argv[2];
@@ -331,6 +350,7 @@ int DENGINE_MAIN_ENTRYPOINT(int argc, char** argv)
 
 	Time::Initialize();
 
+	auto jobScheduler = Jobs::Scheduler::Create();
 
 
 	auto appCtx = App::impl::Initialize();
@@ -346,11 +366,18 @@ int DENGINE_MAIN_ENTRYPOINT(int argc, char** argv)
 	impl::GfxLogger gfxLogger = {};
 	gfxLogger.appCtx = &appCtx;
 	impl::GfxTexAssetInterfacer gfxTexAssetInterfacer{};
+	// -framequeue N lets frames queue up for the rendering thread, trading latency for throughput.
+	u8 frameQueueDepth = 1;
+	for (int i = 1; i + 1 < argc; i++) {
+		if (strcmp(argv[i], "-framequeue") == 0)
+			frameQueueDepth = (u8)Math::Clamp(std::atoi(argv[i + 1]), 1, (i32)Gfx::maxFrameQueueDepth);
+	}
 	auto gfxCtx = impl::CreateGfxContext(
 		gfxWsiConnection,
 		gfxTexAssetInterfacer,
 		gfxLogger,
-		requiredInstanceExtensions);
+		requiredInstanceExtensions,
+		frameQueueDepth);
 
 	Scene myScene;
 
@@ -408,9 +435,34 @@ int DENGINE_MAIN_ENTRYPOINT(int argc, char** argv)
 	editorCreateInfo.windowContentScale = mainWindowCreateResult.contentScale;
 	editorCreateInfo.windowDpiX = mainWindowCreateResult.dpiX;
 	editorCreateInfo.windowDpiY = mainWindowCreateResult.dpiY;
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "-sdftext") == 0)
+			editorCreateInfo.sdfText = true;
+	}
 	auto editorCtx = Editor::Context::Create(editorCreateInfo);
 	editorCtx.SelectEntity((Entity)0);
 
+	// Systems that run while the editor is simulating.
+	// Everything here touches the physics world, so they currently run in order.
+	SystemSchedule simulationSystems;
+	// Editor can move stuff around, so we need to update the physics world.
+	simulationSystems.AddSystem<Physics::Rigidbody2D, Transform const, ExclusiveAccess>(
+		Std::CStrToSpan("CopyTransformToPhysicsWorld"),
+		[](Scene& scene, Jobs::Scheduler& jobScheduler) {
+			impl::CopyTransformToPhysicsWorld(scene);
+		});
+	simulationSystems.AddSystem<Move const, Physics::Rigidbody2D, ExclusiveAccess>(
+		Std::CStrToSpan("Move"),
+		[&appCtx](Scene& scene, Jobs::Scheduler& jobScheduler) {
+			for (auto const& [entity, moveComponent] : scene.GetAllComponents<Move>())
+				moveComponent.Update(appCtx, entity, scene, Time::Delta());
+		});
+	simulationSystems.AddSystem<Physics::Rigidbody2D, Transform, ExclusiveAccess>(
+		Std::CStrToSpan("PhysicsStep"),
+		[](Scene& scene, Jobs::Scheduler& jobScheduler) {
+			impl::RunPhysicsStep(scene, jobScheduler);
+		});
+
 	while (true) {
 #ifdef DENGINE_TRACY_LINKED
 		TracyCZoneNS(tracy_mainTick, "Main tick", 20, true);
@@ -437,15 +489,7 @@ int DENGINE_MAIN_ENTRYPOINT(int argc, char** argv)
 			Scene& scene = editorCtx.GetActiveScene();
 			renderedScene = &scene;
 
-			// Editor can move stuff around, so we need to update the physics world.
-			impl::CopyTransformToPhysicsWorld(scene);
-
-			//Physics::Update(myScene, Time::Delta());
-
-			for (auto const& [entity, moveComponent] : scene.GetAllComponents<Move>())
-				moveComponent.Update(appCtx, entity, scene, Time::Delta());
-
-			impl::RunPhysicsStep(scene);
+			simulationSystems.Run(scene, jobScheduler);
 		}
 
 
@@ -471,38 +515,36 @@ int DENGINE_MAIN_ENTRYPOINT(int argc, char** argv)
 void DEngine::impl::CopyTransformToPhysicsWorld(Scene& scene)
 {
 	// First copy our positions into every physics body
-	for (auto const& physicsBodyPair : scene.GetAllComponents<Physics::Rigidbody2D>())
+	scene.View<Physics::Rigidbody2D const, Transform const>().ForEach([](
+		Entity entity,
+		Physics::Rigidbody2D const& rb,
+		Transform const& transform)
 	{
-		Entity a = physicsBodyPair.a;
-
-		Transform const* transformPtr = scene.GetComponent<Transform>(a);
-		DENGINE_IMPL_ASSERT(transformPtr != nullptr);
-		Transform const& transform = *transformPtr;
-		b2Body* pBody = (b2Body*)physicsBodyPair.b.b2BodyPtr;
+		b2Body* pBody = (b2Body*)rb.b2BodyPtr;
 		pBody->SetTransform({ transform.position.x, transform.position.y }, transform.rotation);
-	}
+	});
 }
 
 void DEngine::impl::RunPhysicsStep(
-	Scene& scene)
+	Scene& scene,
+	Jobs::Scheduler& jobScheduler)
 {
 	CopyTransformToPhysicsWorld(scene);
 
 	scene.physicsWorld->Step(Time::Delta(), 8, 8);
 
-	// Then copy the stuff back
-	for (auto const& physicsBodyPair : scene.GetAllComponents<Physics::Rigidbody2D>())
+	// Then copy the stuff back. Reading the body transforms is thread-safe.
+	constexpr uSize chunkSize = 1024;
+	ParallelForEach(jobScheduler, scene.View<Physics::Rigidbody2D const, Transform>(), chunkSize, [](
+		Entity entity,
+		Physics::Rigidbody2D const& rb,
+		Transform& transform)
 	{
-		Entity a = physicsBodyPair.a;
-		Transform* transformPtr = scene.GetComponent<Transform>(a);
-		DENGINE_IMPL_ASSERT(transformPtr != nullptr);
-		Transform& transform = *transformPtr;
-
-		b2Body* pBody = (b2Body*)physicsBodyPair.b.b2BodyPtr;
+		b2Body* pBody = (b2Body*)rb.b2BodyPtr;
 		auto physicsBodyTransform = pBody->GetTransform();
 		transform.position = { physicsBodyTransform.p.x, physicsBodyTransform.p.y };
 		transform.rotation = physicsBodyTransform.q.GetAngle();
-	}
+	});
 }
 
 void DEngine::impl::SubmitRendering(
@@ -519,36 +561,27 @@ void DEngine::impl::SubmitRendering(
 	}
 
 
-	Gfx::DrawParams params = {};
+	// Everything is written straight into the packet the renderer will consume.
+	auto& params = gfxData.BeginDraw();
 
-	for (auto const& item : scene.GetAllComponents<Gfx::TextureID>())
+	// Transform and TextureID are kept grouped by the scene, so this is a linear zip.
+	auto const spriteView = scene.View<Transform, Gfx::TextureID>();
+	params.textureIDs.reserve(spriteView.DriverSize());
+	params.transforms.reserve(spriteView.DriverSize());
+	spriteView.ForEach([&params](
+		Entity entity,
+		Transform const& transform,
+		Gfx::TextureID const& textureId)
 	{
-		auto& entity = item.a;
-
-		// First check if this entity has a position
-		auto const* transformPtr = scene.GetComponent<Transform>(entity);
-		if (transformPtr == nullptr)
-			continue;
-		auto& transform = *transformPtr;
-
-		params.textureIDs.push_back(item.b);
+		params.textureIDs.push_back(textureId);
 
 		Math::Mat4 transformMat = Math::LinAlg3D::Translate(transform.position) *
 			Math::LinAlg3D::Rotate_Homo(Math::ElementaryAxis::Z, transform.rotation) *
 			Math::LinAlg3D::Scale_Homo(transform.scale.AsVec3(1.f));
 		params.transforms.push_back(transformMat);
-	}
+	});
 
-	auto editorDrawData = editorCtx.GetDrawInfo();
-	params.guiVertices = editorDrawData.vertices;
-	params.guiIndices = editorDrawData.indices;
-	params.guiDrawCmds = editorDrawData.drawCmds;
-	params.nativeWindowUpdates = editorDrawData.windowUpdates;
-	params.viewportUpdates = editorDrawData.viewportUpdates;
-	params.lineVertices = editorDrawData.lineVertices;
-	params.lineDrawCmds = editorDrawData.lineDrawCmds;
-	params.guiUtfValues = editorDrawData.utfValues;
-	params.guiTextGlyphRects = editorDrawData.textGlyphRects;
+	editorCtx.WriteDrawParams(params);
 	for (auto& windowUpdate : params.nativeWindowUpdates) {
 		auto windowEventFlags = appCtx.GetWindowEventFlags((App::WindowID)windowUpdate.id);
 		if ((u64)windowEventFlags > 0) { // Some event did happen.
@@ -563,6 +596,82 @@ void DEngine::impl::SubmitRendering(
 
 
 	if (!params.nativeWindowUpdates.empty()) {
-		gfxData.Draw(params);
+		gfxData.SubmitDraw();
 	}
-}
\ No newline at end of file
+}
+
+void DEngine::impl::RunSceneBenchmark()
+{
+	constexpr uSize entityCounts[] = { 1000, 10000, 100000 };
+	constexpr int frameCount = 100;
+
+	auto jobScheduler = Jobs::Scheduler::Create();
+
+	for (auto const entityCount : entityCounts)
+	{
+		Scene scene;
+		for (uSize i = 0; i < entityCount; i += 1)
+		{
+			auto const ent = scene.NewEntity();
+			Transform transform = {};
+			transform.position.x = (f32)i;
+			scene.AddComponent(ent, transform);
+			scene.AddComponent(ent, Gfx::TextureID{ 0 });
+			scene.AddComponent(ent, Physics::Rigidbody2D{});
+		}
+		// Punch holes into the storage so we also measure swap-and-pop deletion.
+		auto const deleteStart = std::chrono::high_resolution_clock::now();
+		for (uSize i = 0; i < entityCount; i += 4)
+			scene.DeleteEntity(scene.GetEntities()[0]);
+		auto const deleteEnd = std::chrono::high_resolution_clock::now();
+
+		auto const frameStart = std::chrono::high_resolution_clock::now();
+		f32 checksum = 0.f;
+		for (int frame = 0; frame < frameCount; frame += 1)
+		{
+			// Same access pattern as the physics copy-back.
+			scene.View<Physics::Rigidbody2D const, Transform>().ForEach([](
+				Entity entity,
+				Physics::Rigidbody2D const& rb,
+				Transform& transform)
+			{
+				transform.rotation += 0.001f;
+			});
+			// Same access pattern as SubmitRendering.
+			scene.View<Transform const, Gfx::TextureID const>().ForEach([&checksum](
+				Entity entity,
+				Transform const& transform,
+				Gfx::TextureID const& textureId)
+			{
+				checksum += transform.position.x;
+			});
+		}
+		auto const frameEnd = std::chrono::high_resolution_clock::now();
+
+		// Same as the physics copy-back above, but split across the job workers.
+		auto const parallelStart = std::chrono::high_resolution_clock::now();
+		for (int frame = 0; frame < frameCount; frame += 1)
+		{
+			ParallelForEach(jobScheduler, scene.View<Physics::Rigidbody2D const, Transform>(), 1024, [](
+				Entity entity,
+				Physics::Rigidbody2D const& rb,
+				Transform& transform)
+			{
+				transform.rotation += 0.001f;
+			});
+		}
+		auto const parallelEnd = std::chrono::high_resolution_clock::now();
+		auto const parallelTime = std::chrono::duration<f64, std::micro>(parallelEnd - parallelStart).count() / frameCount;
+
+		auto const frameTime = std::chrono::duration<f64, std::micro>(frameEnd - frameStart).count() / frameCount;
+		auto const deleteTime = std::chrono::duration<f64, std::micro>(deleteEnd - deleteStart).count();
+		std::cout << "Scene benchmark - "
+			<< entityCount << " entities: "
+			<< frameTime << " us/frame, "
+			<< frameTime * 1000.0 / (f64)scene.GetEntities().Size() << " ns/entity, "
+			<< "deletion " << deleteTime << " us total, "
+			<< "parallel copy-back " << parallelTime << " us/frame on "
+			<< jobScheduler.GetThreadCount() << " threads "
+			<< "(checksum " << checksum << ")" << std::endl;
+	}
+}
@@ -17,6 +17,8 @@
 #include <DEngine/Math/Vector.hpp>
 
 
+#include <chrono>
+#include <cstring>
 #include <iostream>
 #include <vector>
 #include <string>
@@ -349,6 +351,76 @@ namespace DEngine::GuiPlayground
 		guiCtx.AdoptWindow(Std::Move(adoptWindowInfo));
 	}
 
+	// Runs the size-hint and rect building passes over a large widget tree
+	// and prints the average time per pass. This mostly stresses the
+	// RectCollection lookups, since every widget looks up itself and its children.
+	void RunRectCollectionBenchmark(
+		Gui::Context& guiCtx,
+		App::Context::NewWindow_ReturnT const& windowInfo)
+	{
+		using namespace Gui;
+
+		constexpr int sectionCount = 1000;
+		constexpr int linesPerSection = 10;
+		constexpr int iterationCount = 20;
+
+		StackLayout topLayout { StackLayout::Dir::Vertical };
+		for (int i = 0; i < sectionCount; i++) {
+			auto* section = new StackLayout(StackLayout::Dir::Horizontal);
+
+			auto* text = new Text;
+			text->text = "Section " + std::to_string(i);
+			section->AddWidget(Std::Box{ text });
+
+			auto* lineList = new LineList;
+			for (int j = 0; j < linesPerSection; j++)
+				lineList->lines.push_back(std::to_string(j));
+			section->AddWidget(Std::Box{ lineList });
+
+			topLayout.AddWidget(Std::Box{ section });
+		}
+
+		RectCollection rectCollection;
+		Std::FrameAlloc transientAlloc;
+		auto& textManager = guiCtx.GetTextManager();
+		EventWindowInfo const eventWindowInfo {
+			.contentScale = windowInfo.contentScale,
+			.dpiX = windowInfo.dpiX,
+			.dpiY = windowInfo.dpiY, };
+		Rect const windowRect = { {}, { windowInfo.extent.width, windowInfo.extent.height } };
+
+		auto const startTime = std::chrono::steady_clock::now();
+		for (int i = 0; i < iterationCount; i++) {
+			rectCollection.Prepare(false);
+
+			RectCollection::SizeHintPusher sizeHintPusher { rectCollection };
+			Widget::GetSizeHint2_Params sizeHintParams = {
+				.ctx = guiCtx,
+				.window = eventWindowInfo,
+				.textManager = textManager,
+				.appData = {},
+				.transientAlloc = transientAlloc,
+				.pusher = sizeHintPusher, };
+			topLayout.GetSizeHint2(sizeHintParams);
+			transientAlloc.Reset();
+
+			RectCollection::RectPusher rectPusher { rectCollection };
+			Widget::BuildChildRects_Params rectParams = {
+				.ctx = guiCtx,
+				.window = eventWindowInfo,
+				.textManager = textManager,
+				.transientAlloc = transientAlloc,
+				.pusher = rectPusher, };
+			rectPusher.SetRectPair(rectPusher.GetEntry(topLayout), { windowRect, windowRect });
+			topLayout.BuildChildRects(rectParams, windowRect, windowRect);
+			transientAlloc.Reset();
+		}
+		auto const elapsed = std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - startTime);
+
+		std::cout << "RectCollection benchmark: " << rectCollection.widgets.size() << " entries, "
+			<< elapsed.count() / iterationCount << " ms per layout pass." << std::endl;
+	}
+
 	void SetupWindowB(Platform::Context& platformCtx, Gui::Context& guiCtx, Gfx::Context& gfxCtx)
 	{
 		auto windowInfo = platformCtx.NewWindow(Std::CStrToSpan("Second Window"), { 800, 600 });
@@ -414,6 +486,11 @@ int DENGINE_MAIN_ENTRYPOINT(int argc, char** argv)
 	auto guiCtx = Gui::Context::Create(tempWindowHandler, &platformCtx, &gfxCtx);
 
 	GuiPlayground::SetupWindowA(guiCtx, mainWindowInfo);
+
+	for (int i = 1; i < argc; i++) {
+		if (std::strcmp(argv[i], "-rectbench") == 0)
+			GuiPlayground::RunRectCollectionBenchmark(guiCtx, mainWindowInfo);
+	}
 	//GuiPlayground::SetupWindowB(platformCtx, guiCtx, gfxCtx);
 
 
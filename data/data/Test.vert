@@ -5,9 +5,10 @@ layout(set = 0, binding = 0) uniform CameraData
 	mat4 matrix;
 } cameraData;
 
-layout(set = 1, binding = 0) uniform ObjectData
+// One matrix per sprite, indexed by instance.
+layout(set = 1, binding = 0) readonly buffer ObjectData
 {
-	mat4 matrix;
+	mat4 matrices[];
 } objectData;
 
 layout(location = 0) out vec2 uv;
@@ -28,6 +29,6 @@ void main()
 {
 	uv = uvs[gl_VertexIndex];
 
-	gl_Position = cameraData.matrix * objectData.matrix * vec4(positions[gl_VertexIndex], 1.0);
+	gl_Position = cameraData.matrix * objectData.matrices[gl_InstanceIndex] * vec4(positions[gl_VertexIndex], 1.0);
 	gl_Position.y = -gl_Position.y;
 }
@@ -5,7 +5,7 @@
 
 layout(push_constant) uniform PushConstData {
 	layout(offset = 0) vec2 rectOffset;
-	layout(offset = 8) vec2 rectExtent;
+	layout(offset = 8) vec2 padding0;
 	layout(offset = 16) vec4 color;
 } pushConstData;
 
@@ -1,2 +1,3 @@
 glslc --target-env=vulkan1.0 -I.. -o vert.spv glsl.vert
 glslc --target-env=vulkan1.0 -I.. -o frag.spv glsl.frag
+glslc --target-env=vulkan1.0 -I.. -o sdf_frag.spv glsl_sdf.frag
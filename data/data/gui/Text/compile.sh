@@ -1,2 +1,3 @@
 glslangValidator -V glsl.vert
 glslangValidator -V glsl.frag
+glslangValidator -V glsl_sdf.frag -o sdf_frag.spv
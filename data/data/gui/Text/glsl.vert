@@ -9,6 +9,12 @@ vec2 positions[6] = {
 	{ 0, 1 },
 	{ 1, 1 } };
 
+// Per-instance glyph data.
+// xy is the offset of the glyph relative to the text, zw is the extent.
+layout(location = 0) in vec4 inGlyphRect;
+// xy is the offset of the glyph inside the atlas page, zw is the extent.
+layout(location = 1) in vec4 inGlyphUvRect;
+
 layout(location = 0) out vec2 fragUv;
 
 void main()
@@ -16,7 +22,7 @@ void main()
 	vec2 dstPos;
 	for(int i = 0; i < 2; i++) {
 		// Apply rect
-		dstPos[i] = positions[gl_VertexIndex][i] * pushConstData.rectExtent[i] + pushConstData.rectOffset[i];
+		dstPos[i] = positions[gl_VertexIndex][i] * inGlyphRect[i + 2] + (pushConstData.rectOffset[i] + inGlyphRect[i]);
 		// Convert to NDC
 		dstPos[i] = dstPos[i] * 2 - 1;
 	}
@@ -24,5 +30,5 @@ void main()
 	mat2 orientMat = WindowOrientationMat();
 		
 	gl_Position = vec4(dstPos * orientMat, 0, 1);
-	fragUv = positions[gl_VertexIndex];
+	fragUv = inGlyphUvRect.xy + positions[gl_VertexIndex] * inGlyphUvRect.zw;
 }
\ No newline at end of file
@@ -0,0 +1,22 @@
+#version 450 core
+#include "Uniforms.glsl"
+
+layout(location = 0) in vec2 fragUv;
+
+// Signed distance to the glyph outline.
+// 0.5 is on the outline, larger values are inside the glyph.
+layout(set = 1, binding = 0) uniform sampler2D fontGlyph;
+
+layout(location = 0) out vec4 outColor;
+
+void main()
+{
+	vec4 color = pushConstData.color;
+
+	float dist = texture(fontGlyph, fragUv).r;
+	// Blend across about one pixel, no matter how far the glyph is scaled.
+	float edgeWidth = 0.5 * fwidth(dist);
+	float alpha = smoothstep(0.5 - edgeWidth, 0.5 + edgeWidth, dist);
+
+	outColor = vec4(color.xyz, alpha);
+}
\ No newline at end of file
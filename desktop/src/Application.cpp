@@ -17,6 +17,11 @@
 #include <cstring>
 #include <new>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 namespace DEngine::Application::impl
 {
 	struct Backend_Data
@@ -650,3 +655,109 @@ void Application::FileInputStream::Close()
 
 	std::memset(&m_buffer[0], 0, sizeof(std::FILE*));
 }
+
+namespace DEngine::Application::impl
+{
+	struct Backend_MappedFileData
+	{
+		void* data = nullptr;
+		u64 size = 0;
+		// Empty files can't be mapped, so we track this separately.
+		bool isOpen = false;
+	};
+}
+
+Application::MappedFile::MappedFile()
+{
+	static_assert(sizeof(impl::Backend_MappedFileData) <= sizeof(MappedFile::m_buffer));
+
+	impl::Backend_MappedFileData implData{};
+	std::memcpy(&m_buffer[0], &implData, sizeof(implData));
+}
+
+Application::MappedFile::MappedFile(char const* path) : MappedFile()
+{
+	Open(path);
+}
+
+Application::MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+	std::memcpy(&m_buffer[0], &other.m_buffer[0], sizeof(impl::Backend_MappedFileData));
+	impl::Backend_MappedFileData implData{};
+	std::memcpy(&other.m_buffer[0], &implData, sizeof(implData));
+}
+
+Application::MappedFile::~MappedFile()
+{
+	Close();
+}
+
+Application::MappedFile& Application::MappedFile::operator=(MappedFile&& other) noexcept
+{
+	if (this == &other)
+		return *this;
+
+	Close();
+
+	std::memcpy(&m_buffer[0], &other.m_buffer[0], sizeof(impl::Backend_MappedFileData));
+	impl::Backend_MappedFileData implData{};
+	std::memcpy(&other.m_buffer[0], &implData, sizeof(implData));
+
+	return *this;
+}
+
+bool Application::MappedFile::Open(char const* path)
+{
+	Close();
+
+	int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+	if (fd == -1)
+		return false;
+
+	struct stat fileStat = {};
+	if (fstat(fd, &fileStat) != 0) {
+		::close(fd);
+		return false;
+	}
+
+	impl::Backend_MappedFileData implData{};
+	implData.size = (u64)fileStat.st_size;
+	if (implData.size != 0) {
+		implData.data = ::mmap(nullptr, (size_t)implData.size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (implData.data == MAP_FAILED) {
+			::close(fd);
+			return false;
+		}
+	}
+	// The mapping keeps its own reference to the file.
+	::close(fd);
+
+	implData.isOpen = true;
+	std::memcpy(&m_buffer[0], &implData, sizeof(implData));
+	return true;
+}
+
+void Application::MappedFile::Close()
+{
+	impl::Backend_MappedFileData implData{};
+	std::memcpy(&implData, &m_buffer[0], sizeof(implData));
+	if (implData.data != nullptr)
+		::munmap(implData.data, (size_t)implData.size);
+
+	implData = impl::Backend_MappedFileData{};
+	std::memcpy(&m_buffer[0], &implData, sizeof(implData));
+}
+
+bool Application::MappedFile::IsOpen() const
+{
+	impl::Backend_MappedFileData implData{};
+	std::memcpy(&implData, &m_buffer[0], sizeof(implData));
+	return implData.isOpen;
+}
+
+Std::Span<std::byte const> Application::MappedFile::Data() const
+{
+	impl::Backend_MappedFileData implData{};
+	std::memcpy(&implData, &m_buffer[0], sizeof(implData));
+	return { static_cast<std::byte const*>(implData.data), (uSize)implData.size };
+}
@@ -881,3 +881,109 @@ void Application::FileInputStream::Close() {
 
 	std::memset(&m_buffer[0], 0, sizeof(std::FILE*));
 }
+
+namespace DEngine::Application::impl {
+	struct Backend_MappedFileData {
+		void const* data = nullptr;
+		u64 size = 0;
+		// Empty files can't be mapped, so we track this separately.
+		bool isOpen = false;
+	};
+}
+
+Application::MappedFile::MappedFile() {
+	static_assert(sizeof(impl::Backend_MappedFileData) <= sizeof(MappedFile::m_buffer));
+
+	impl::Backend_MappedFileData implData{};
+	std::memcpy(&m_buffer[0], &implData, sizeof(implData));
+}
+
+Application::MappedFile::MappedFile(char const* path) : MappedFile() {
+	Open(path);
+}
+
+Application::MappedFile::MappedFile(MappedFile&& other) noexcept {
+	std::memcpy(&m_buffer[0], &other.m_buffer[0], sizeof(impl::Backend_MappedFileData));
+	impl::Backend_MappedFileData implData{};
+	std::memcpy(&other.m_buffer[0], &implData, sizeof(implData));
+}
+
+Application::MappedFile::~MappedFile() {
+	Close();
+}
+
+Application::MappedFile& Application::MappedFile::operator=(MappedFile&& other) noexcept {
+	if (this == &other)
+		return *this;
+
+	Close();
+
+	std::memcpy(&m_buffer[0], &other.m_buffer[0], sizeof(impl::Backend_MappedFileData));
+	impl::Backend_MappedFileData implData{};
+	std::memcpy(&other.m_buffer[0], &implData, sizeof(implData));
+
+	return *this;
+}
+
+bool Application::MappedFile::Open(char const* path) {
+	Close();
+
+	HANDLE file = CreateFileA(
+		path,
+		GENERIC_READ,
+		FILE_SHARE_READ,
+		nullptr,
+		OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL,
+		nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER fileSize = {};
+	if (!GetFileSizeEx(file, &fileSize)) {
+		CloseHandle(file);
+		return false;
+	}
+
+	impl::Backend_MappedFileData implData{};
+	implData.size = (u64)fileSize.QuadPart;
+	if (implData.size != 0) {
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping != nullptr) {
+			implData.data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			// The view keeps its own reference to the mapping.
+			CloseHandle(mapping);
+		}
+		if (implData.data == nullptr) {
+			CloseHandle(file);
+			return false;
+		}
+	}
+	CloseHandle(file);
+
+	implData.isOpen = true;
+	std::memcpy(&m_buffer[0], &implData, sizeof(implData));
+	return true;
+}
+
+void Application::MappedFile::Close() {
+	impl::Backend_MappedFileData implData{};
+	std::memcpy(&implData, &m_buffer[0], sizeof(implData));
+	if (implData.data != nullptr)
+		UnmapViewOfFile(implData.data);
+
+	implData = impl::Backend_MappedFileData{};
+	std::memcpy(&m_buffer[0], &implData, sizeof(implData));
+}
+
+bool Application::MappedFile::IsOpen() const {
+	impl::Backend_MappedFileData implData{};
+	std::memcpy(&implData, &m_buffer[0], sizeof(implData));
+	return implData.isOpen;
+}
+
+Std::Span<std::byte const> Application::MappedFile::Data() const {
+	impl::Backend_MappedFileData implData{};
+	std::memcpy(&implData, &m_buffer[0], sizeof(implData));
+	return { static_cast<std::byte const*>(implData.data), (uSize)implData.size };
+}
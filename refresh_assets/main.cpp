@@ -2,39 +2,418 @@
 #include <filesystem>
 #include <string>
 #include <cstdlib>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+#include <algorithm>
+#include <sstream>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <atomic>
 
 namespace fs = std::filesystem;
 
-// Check the OS and run the appropriate script
-void runScript(const fs::path& dir) {
+// Remembers the input hash of every compile script directory and every copied file
+// from the previous run, so that only the work whose inputs changed is redone.
+// Each line is "<hash in hex> <key>". Stored in the working directory.
+constexpr const char* manifestFileName = "refresh_assets.manifest";
+using Manifest = std::map<std::string, std::uint64_t>;
+
+#ifdef _WIN32
+constexpr const char* scriptFileName = "compile.cmd";
+#else
+constexpr const char* scriptFileName = "compile.sh";
+#endif
+
+std::vector<char> readFile(const fs::path& path) {
+	std::ifstream file(path, std::ios::binary);
+	return { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+}
+
+// FNV-1a
+std::uint64_t hashBytes(const char* data, std::size_t size, std::uint64_t hash = 0xcbf29ce484222325ULL) {
+	for (std::size_t i = 0; i < size; i++) {
+		hash ^= (unsigned char)data[i];
+		hash *= 0x100000001b3ULL;
+	}
+	return hash;
+}
+
+std::uint64_t hashString(const std::string& str, std::uint64_t hash) {
+	// Include the terminator so that consecutive strings can't run into each other.
+	return hashBytes(str.c_str(), str.size() + 1, hash);
+}
+
+Manifest loadManifest(const fs::path& path) {
+	Manifest manifest;
+	std::ifstream file(path);
+	std::string line;
+	while (std::getline(file, line)) {
+		auto const separator = line.find(' ');
+		if (separator == std::string::npos)
+			continue;
+		manifest[line.substr(separator + 1)] = std::stoull(line.substr(0, separator), nullptr, 16);
+	}
+	return manifest;
+}
+
+void saveManifest(const fs::path& path, const Manifest& manifest) {
+	std::ofstream file(path, std::ios::trunc);
+	for (const auto& [key, hash] : manifest) {
+		char hex[17] = {};
+		std::snprintf(hex, sizeof(hex), "%016llx", (unsigned long long)hash);
+		file << hex << ' ' << key << '\n';
+	}
+}
+
+// Files produced by this tool or by the compile scripts.
+// They are outputs, so they must not count as inputs.
+bool isGeneratedFile(const fs::path& path) {
+	return
+		path.extension() == ".spv" ||
+		path.filename() == "shaders.bundle" ||
+		path.filename() == "textures.pack";
+}
+
+std::string captureCommandOutput(const std::string& cmd) {
+#ifdef _WIN32
+	std::FILE* pipe = _popen((cmd + " 2>&1").c_str(), "r");
+#else
+	std::FILE* pipe = popen((cmd + " 2>&1").c_str(), "r");
+#endif
+	if (pipe == nullptr)
+		return {};
+	std::string output;
+	char buffer[256];
+	while (std::fgets(buffer, sizeof(buffer), pipe))
+		output += buffer;
 #ifdef _WIN32
-	std::string cmd = "compile.cmd";
+	_pclose(pipe);
 #else
-	std::string cmd = "./compile.sh";
+	pclose(pipe);
 #endif
-	auto scriptFilePath = dir;
-	scriptFilePath.append(cmd);
-
-	if (fs::exists(scriptFilePath) && fs::is_regular_file(scriptFilePath)) {
-		std::string yo = std::string("cd ") + dir.string() + std::string(" && ") + cmd;
-		// Make sure to flush std IO
-		std::cout.flush();
-		int result = system(yo.c_str());
-		std::cout.flush();
-		if (result != 0) {
-			std::cout << "Failed to execute command." << std::endl;
-			std::exit(result);
+	return output;
+}
+
+// Upgrading the shader compilers invalidates every compiled shader.
+std::uint64_t hashToolVersions() {
+	std::uint64_t hash = hashBytes(nullptr, 0);
+	hash = hashString(captureCommandOutput("glslangValidator --version"), hash);
+	hash = hashString(captureCommandOutput("glslc --version"), hash);
+	return hash;
+}
+
+// Hashes the files a compile script can read. That is every file in its directory,
+// and the files in the parent directory, since shaders include shared files from there.
+std::uint64_t hashScriptInputs(const fs::path& dir, std::uint64_t toolHash) {
+	std::vector<fs::path> inputs;
+	for (const auto& inputDir : { dir, dir.parent_path() }) {
+		for (const auto& entry : fs::directory_iterator(inputDir)) {
+			if (entry.is_regular_file() && !isGeneratedFile(entry.path()))
+				inputs.push_back(entry.path());
 		}
 	}
+	// Sorted so the hash doesn't depend on the iteration order of the file system.
+	std::sort(inputs.begin(), inputs.end());
+
+	std::uint64_t hash = toolHash;
+	for (const auto& input : inputs) {
+		hash = hashString(input.generic_string(), hash);
+		auto const contents = readFile(input);
+		hash = hashBytes(contents.data(), contents.size(), hash);
+	}
+	return hash;
+}
+
+bool hasCompiledShaders(const fs::path& dir) {
+	for (const auto& entry : fs::directory_iterator(dir)) {
+		if (entry.is_regular_file() && entry.path().extension() == ".spv")
+			return true;
+	}
+	return false;
+}
+
+bool runScript(const fs::path& dir) {
+#ifdef _WIN32
+	std::string cmd = scriptFileName;
+#else
+	std::string cmd = std::string("./") + scriptFileName;
+#endif
+	std::string yo = std::string("cd ") + dir.string() + std::string(" && ") + cmd;
+	int result = system(yo.c_str());
+	if (result != 0) {
+		std::cout << "Failed to execute command in " << dir << "." << std::endl;
+		return false;
+	}
+	return true;
+}
+
+// Runs the compile script of every directory whose inputs changed since the last run.
+// The directories don't depend on each other, so they run in parallel.
+void checkAndRun(const fs::path& path, const Manifest& oldManifest, Manifest& newManifest) {
+	auto const toolHash = hashToolVersions();
+
+	struct Job {
+		fs::path dir;
+		std::string key;
+		std::uint64_t hash;
+	};
+	std::vector<Job> jobs;
+	for (const auto& entry : fs::recursive_directory_iterator(path)) {
+		if (!entry.is_directory())
+			continue;
+		auto const& dir = entry.path();
+		if (!fs::is_regular_file(dir / scriptFileName))
+			continue;
+
+		Job job = {};
+		job.dir = dir;
+		job.key = "script:" + fs::relative(dir, path).generic_string();
+		job.hash = hashScriptInputs(dir, toolHash);
+		auto const oldEntry = oldManifest.find(job.key);
+		if (oldEntry != oldManifest.end() && oldEntry->second == job.hash && hasCompiledShaders(dir))
+			newManifest[job.key] = job.hash;
+		else
+			jobs.push_back(job);
+	}
+
+	std::cout << "Compiling shaders in " << jobs.size() << " directories." << std::endl;
+	// Make sure to flush std IO
+	std::cout.flush();
+
+	std::mutex lock;
+	std::atomic<std::size_t> nextJob = 0;
+	bool failed = false;
+	auto const threadCount = std::min<std::size_t>(jobs.size(), std::max(1u, std::thread::hardware_concurrency()));
+	std::vector<std::thread> threads;
+	for (std::size_t i = 0; i < threadCount; i++) {
+		threads.emplace_back([&]() {
+			while (true) {
+				auto const jobIndex = nextJob++;
+				if (jobIndex >= jobs.size())
+					break;
+				auto const& job = jobs[jobIndex];
+				bool const success = runScript(job.dir);
+				std::scoped_lock scopedLock{ lock };
+				if (success)
+					newManifest[job.key] = job.hash;
+				else
+					failed = true;
+			}
+		});
+	}
+	for (auto& thread : threads)
+		thread.join();
+	std::cout.flush();
+
+	if (failed) {
+		// Keep the directories that did succeed, so they aren't redone next time.
+		saveManifest(manifestFileName, newManifest);
+		std::exit(1);
+	}
+}
+
+// Leaves the file untouched if it already has this content,
+// so that it doesn't look modified to the copy step.
+bool writeIfChanged(const fs::path& path, const std::string& contents) {
+	if (fs::exists(path) && fs::file_size(path) == contents.size()) {
+		auto const existing = readFile(path);
+		if (std::equal(existing.begin(), existing.end(), contents.begin()))
+			return false;
+	}
+	std::ofstream out(path, std::ios::binary | std::ios::trunc);
+	out.write(contents.data(), contents.size());
+	if (!out) {
+		std::cout << "Failed to write " << path << "." << std::endl;
+		std::exit(1);
+	}
+	return true;
+}
+
+// Copies every file that changed since the last run into the destination,
+// and removes files that we copied earlier but that are gone from the source.
+// Files that didn't come from the source, like the pipeline cache, are left alone.
+void syncDirectory(const fs::path& srcPath, const fs::path& destPath, const Manifest& oldManifest, Manifest& newManifest) {
+	std::size_t fileCount = 0;
+	std::size_t copiedCount = 0;
+	for (const auto& entry : fs::recursive_directory_iterator(srcPath)) {
+		if (!entry.is_regular_file())
+			continue;
+		auto const relativePath = fs::relative(entry.path(), srcPath);
+		auto const key = "copy:" + relativePath.generic_string();
+		auto const contents = readFile(entry.path());
+		auto const hash = hashBytes(contents.data(), contents.size());
+		newManifest[key] = hash;
+		fileCount++;
+
+		auto const dest = destPath / relativePath;
+		auto const oldEntry = oldManifest.find(key);
+		bool const upToDate =
+			oldEntry != oldManifest.end() &&
+			oldEntry->second == hash &&
+			fs::exists(dest) &&
+			fs::file_size(dest) == contents.size();
+		if (upToDate)
+			continue;
+
+		fs::create_directories(dest.parent_path());
+		fs::copy_file(entry.path(), dest, fs::copy_options::overwrite_existing);
+		copiedCount++;
+	}
+
+	for (const auto& [key, hash] : oldManifest) {
+		if (key.rfind("copy:", 0) != 0 || newManifest.count(key) != 0)
+			continue;
+		fs::remove(destPath / fs::path(key.substr(5)));
+	}
+
+	std::cout << "Copied " << copiedCount << " of " << fileCount << " files." << std::endl;
 }
 
-// Recursively check for the script in each directory
-void checkAndRun(const fs::path& path) {
+// Pack every compiled SPIR-V shader into a single indexed file,
+// so the engine can load all of them with one read.
+// The layout must match DEngine::Gfx::Vk::ShaderBundle.
+void packShaderBundle(const fs::path& path) {
+	constexpr std::uint32_t magic = 0x56505344;
+	constexpr std::uint32_t version = 1;
+	constexpr std::uint32_t headerSize = sizeof(std::uint32_t) * 4;
+	constexpr std::uint32_t entrySize = sizeof(std::uint32_t) * 4;
+
+	// Sorted so the output is identical between runs.
+	std::vector<fs::path> shaderPaths;
 	for (const auto& entry : fs::recursive_directory_iterator(path)) {
-		if (fs::is_directory(entry)) {
-			runScript(entry.path());
+		if (entry.is_regular_file() && entry.path().extension() == ".spv")
+			shaderPaths.push_back(entry.path());
+	}
+	std::sort(shaderPaths.begin(), shaderPaths.end());
+
+	std::vector<std::string> names;
+	std::vector<std::vector<char>> codes;
+	for (const auto& shaderPath : shaderPaths) {
+		names.push_back(fs::relative(shaderPath, path).generic_string());
+		std::ifstream file(shaderPath, std::ios::binary);
+		codes.emplace_back(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+		if (codes.back().size() % 4 != 0) {
+			std::cout << "Shader " << shaderPath << " is not valid SPIR-V." << std::endl;
+			std::exit(1);
+		}
+	}
+
+	auto const entryCount = (std::uint32_t)shaderPaths.size();
+	std::vector<std::uint32_t> entries;
+	std::uint32_t offset = headerSize + entryCount * entrySize;
+	for (std::size_t i = 0; i < names.size(); i++) {
+		entries.push_back(offset);
+		entries.push_back((std::uint32_t)names[i].size());
+		entries.push_back(0);
+		entries.push_back((std::uint32_t)codes[i].size());
+		offset += (std::uint32_t)names[i].size();
+	}
+	// Align the code to 4 bytes so it can be handed directly to Vulkan.
+	auto const namesPadding = (4 - offset % 4) % 4;
+	offset += namesPadding;
+	for (std::size_t i = 0; i < codes.size(); i++) {
+		entries[i * 4 + 2] = offset;
+		offset += (std::uint32_t)codes[i].size();
+	}
+
+	std::ostringstream out;
+	std::uint32_t const header[4] = { magic, version, entryCount, 0 };
+	out.write(reinterpret_cast<const char*>(header), sizeof(header));
+	out.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(std::uint32_t));
+	for (const auto& name : names)
+		out.write(name.data(), name.size());
+	out.write("\0\0\0", namesPadding);
+	for (const auto& code : codes)
+		out.write(code.data(), code.size());
+
+	if (writeIfChanged(path / "shaders.bundle", out.str()))
+		std::cout << "Packed " << entryCount << " shaders into shaders.bundle." << std::endl;
+}
+
+// Pack the textures listed in textures.manifest into a single indexed file,
+// so the engine can resolve a TextureID with one lookup into one mapped file.
+// Each manifest line is "<texture id> <path relative to the data directory>".
+// The layout must match DEngine::Gfx::Vk::TextureArchive.
+void packTextureArchive(const fs::path& path) {
+	constexpr std::uint32_t magic = 0x41585444;
+	constexpr std::uint32_t version = 1;
+	constexpr std::uint64_t headerSize = sizeof(std::uint32_t) * 4;
+	constexpr std::uint64_t entrySize = sizeof(std::uint64_t) * 3;
+	// Keeps every texture aligned for the texture decoder.
+	constexpr std::uint64_t dataAlignment = 16;
+
+	auto manifestPath = path / "textures.manifest";
+	if (!fs::exists(manifestPath))
+		return;
+
+	struct Texture {
+		std::uint64_t id;
+		fs::path path;
+	};
+	std::vector<Texture> textures;
+	std::ifstream manifest(manifestPath);
+	std::string line;
+	while (std::getline(manifest, line)) {
+		if (!line.empty() && line.back() == '\r')
+			line.pop_back();
+		if (line.empty() || line[0] == '#')
+			continue;
+		std::istringstream lineStream(line);
+		Texture texture = {};
+		std::string relativePath;
+		if (!(lineStream >> texture.id >> relativePath)) {
+			std::cout << "Invalid line in textures.manifest: " << line << std::endl;
+			std::exit(1);
+		}
+		texture.path = path / relativePath;
+		textures.push_back(texture);
+	}
+	std::sort(textures.begin(), textures.end(), [](const Texture& a, const Texture& b) { return a.id < b.id; });
+	for (std::size_t i = 1; i < textures.size(); i++) {
+		if (textures[i - 1].id == textures[i].id) {
+			std::cout << "Texture id " << textures[i].id << " is listed twice in textures.manifest." << std::endl;
+			std::exit(1);
 		}
 	}
+
+	std::vector<std::vector<char>> datas;
+	for (const auto& texture : textures) {
+		std::ifstream file(texture.path, std::ios::binary);
+		if (!file) {
+			std::cout << "Could not open texture " << texture.path << "." << std::endl;
+			std::exit(1);
+		}
+		datas.emplace_back(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	}
+
+	std::vector<std::uint64_t> entries;
+	std::vector<std::uint64_t> paddings;
+	std::uint64_t offset = headerSize + textures.size() * entrySize;
+	for (std::size_t i = 0; i < textures.size(); i++) {
+		auto const padding = (dataAlignment - offset % dataAlignment) % dataAlignment;
+		offset += padding;
+		paddings.push_back(padding);
+		entries.push_back(textures[i].id);
+		entries.push_back(offset);
+		entries.push_back(datas[i].size());
+		offset += datas[i].size();
+	}
+
+	std::ostringstream out;
+	std::uint32_t const header[4] = { magic, version, (std::uint32_t)textures.size(), 0 };
+	out.write(reinterpret_cast<const char*>(header), sizeof(header));
+	out.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(std::uint64_t));
+	const char zeroes[dataAlignment] = {};
+	for (std::size_t i = 0; i < datas.size(); i++) {
+		out.write(zeroes, paddings[i]);
+		out.write(datas[i].data(), datas[i].size());
+	}
+
+	if (writeIfChanged(path / "textures.pack", out.str()))
+		std::cout << "Packed " << textures.size() << " textures into textures.pack." << std::endl;
 }
 
 int main(int argc, char* argv[]) {
@@ -49,15 +428,17 @@ int main(int argc, char* argv[]) {
 		return 1;
 	}
 
-	checkAndRun(srcPath);
+	auto const oldManifest = loadManifest(manifestFileName);
+	Manifest newManifest;
 
-	fs::path destPath = fs::current_path() / srcPath.filename();
+	checkAndRun(srcPath, oldManifest, newManifest);
+	packShaderBundle(srcPath);
+	packTextureArchive(srcPath);
 
-	if (fs::exists(destPath)) {
-		fs::remove_all(destPath);  // Be careful, this will remove the directory and its contents
-	}
+	fs::path destPath = fs::current_path() / srcPath.filename();
 
-	fs::copy(srcPath, destPath, fs::copy_options::recursive);
+	syncDirectory(srcPath, destPath, oldManifest, newManifest);
+	saveManifest(manifestFileName, newManifest);
 
 	std::cout << "Directory copied successfully!" << std::endl;
 